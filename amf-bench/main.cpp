@@ -0,0 +1,741 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include "amf-color-convert.hpp"
+#include "amf-encoder-h264.hpp"
+#include "amf-encoder-h265.hpp"
+#include "amf-statistics.hpp"
+#include "amf-plane-copy.hpp"
+#include "amf.hpp"
+#include "api-base.hpp"
+#include "utility.hpp"
+
+#if defined(_WIN32) || defined(_WIN64)
+extern "C" {
+#include <windows.h>
+}
+#else
+#include <sys/resource.h>
+#endif
+
+// Number of distinct synthetic frames, cycled through so the encoder does not see the same memory every time.
+#define BENCH_FRAME_VARIANTS 4
+// Row alignment OBS uses for frame memory.
+#define BENCH_FRAME_ALIGNMENT 32
+// Time allowed for the encoder to return the remaining packets after the last frame.
+#define BENCH_DRAIN_TIMEOUT std::chrono::seconds(10)
+// Row pitch of the destination planes in the plane copy benchmark, typical for hardware surfaces.
+#define BENCH_SURFACE_ALIGNMENT 256
+// Minimum time spent on each plane copy variant.
+#define BENCH_COPY_DURATION std::chrono::milliseconds(250)
+
+using namespace Plugin;
+using namespace Plugin::AMD;
+
+#pragma region Allocation Tracking
+// Every C++ allocation in this process goes through these, the plugin code linked into the benchmark as well as a
+// runtime that shares the C++ allocator (amf-stub does). Plain malloc and bmalloc are not counted.
+static std::atomic<uint64_t> g_AllocationCount;
+static std::atomic<uint64_t> g_AllocationBytes;
+
+static void* tracked_alloc(size_t size)
+{
+	g_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	g_AllocationBytes.fetch_add(size, std::memory_order_relaxed);
+	void* ptr = malloc(size ? size : 1);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new(size_t size)
+{
+	return tracked_alloc(size);
+}
+
+void* operator new[](size_t size)
+{
+	return tracked_alloc(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	try {
+		return tracked_alloc(size);
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	try {
+		return tracked_alloc(size);
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+void operator delete(void* ptr) noexcept
+{
+	free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+	free(ptr);
+}
+#pragma endregion Allocation Tracking
+
+#ifndef LITE_OBS
+// Normally provided by OBS_MODULE_USE_DEFAULT_LOCALE in plugin.cpp.
+extern "C" const char* obs_module_text(const char* text)
+{
+	return text;
+}
+#endif
+
+enum class BenchMode : uint8_t {
+	Encode,
+	PlaneCopy,
+	ColorConvert,
+};
+
+struct BenchOptions {
+	BenchMode                     mode         = BenchMode::Encode;
+	Codec                         codec        = Codec::AVC;
+	ColorFormat                   colorFormat  = ColorFormat::NV12;
+	std::pair<uint32_t, uint32_t> resolution   = {1920, 1080};
+	std::pair<uint32_t, uint32_t> frameRate    = {60, 1};
+	uint64_t                      bitrate      = 6000000;
+	size_t                        queueSize    = 8;
+	bool                          multiThread  = true;
+	uint64_t                      frames       = 600;
+	uint64_t                      warmup       = 60;
+	std::string                   api          = "";
+	size_t                        adapter      = 0;
+	WaitStrategy                  waitStrategy = WaitStrategy::Hybrid;
+	ColorConversion               conversion   = ColorConversion::AMF;
+	size_t                        helpers      = 2;
+	uint32_t                      preRoll      = 0;
+};
+
+static std::chrono::nanoseconds process_cpu_time()
+{
+#if defined(_WIN32) || defined(_WIN64)
+	FILETIME creation, exit, kernel, user;
+	GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+	uint64_t k = ((uint64_t)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime;
+	uint64_t u = ((uint64_t)user.dwHighDateTime << 32) | user.dwLowDateTime;
+	return std::chrono::nanoseconds((k + u) * 100);
+#else
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+		   + std::chrono::microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+#endif
+}
+
+static void print_usage(const char* name)
+{
+	printf("Usage: %s [options]\n"
+		   "  --mode encode|planecopy|colorconvert\n"
+		   "                             Benchmark the encoder, only the host plane copy or only the host color\n"
+		   "                             conversion (default encode).\n"
+		   "  --codec h264|h265          Codec to benchmark (default h264).\n"
+		   "  --format nv12|i420|yuy2|bgra|rgba|gray\n"
+		   "                             Color format of the submitted frames (default nv12).\n"
+		   "  --size WxH                 Resolution (default 1920x1080).\n"
+		   "  --fps N[/D]                Frame rate (default 60).\n"
+		   "  --bitrate KBPS             Target bitrate in kbit/s (default 6000).\n"
+		   "  --queue N                  Asynchronous queue size (default 8).\n"
+		   "  --threads on|off           Multi-threaded encoding (default on).\n"
+		   "  --wait sleep|hybrid        Wait strategy (default hybrid).\n"
+		   "  --converter amf|host       Color conversion for bgra and rgba (default amf).\n"
+		   "  --helpers N                Helper threads for host uploads (default 2).\n"
+		   "  --frames N                 Measured frames (default 600).\n"
+		   "  --warmup N                 Frames submitted before measuring (default 60).\n"
+		   "  --preroll N                Frames the encoder discards in Start() (default 0).\n"
+		   "  --api NAME                 Video API, default is the first available one.\n"
+		   "  --adapter N                Adapter index on the API (default 0).\n"
+		   "\n"
+		   "Frames are submitted as fast as the encoder accepts them. Throughput, CPU time and allocations cover the\n"
+		   "measured frames only, stage latencies cover all frames since Start(). Exits with 3 if the encoder did not\n"
+		   "finish in time and with 4 if it dropped frames.\n"
+		   "The plane copy benchmark needs no AMF runtime and covers NV12, I420 and BGRA at 1080p, 1440p and 4K.\n"
+		   "The color conversion benchmark needs no AMF runtime either and covers BGRA to NV12 at the same sizes,\n"
+		   "compare it to the Convert stage of '--format bgra --converter amf'.\n",
+		   name);
+}
+
+static bool parse_options(int argc, char* argv[], BenchOptions& opts)
+{
+	for (int idx = 1; idx < argc; idx++) {
+		std::string arg = argv[idx];
+		if ((arg == "--help") || (arg == "-h"))
+			return false;
+		if (idx + 1 >= argc) {
+			fprintf(stderr, "Missing value for '%s'.\n", arg.c_str());
+			return false;
+		}
+		std::string value = argv[++idx];
+
+		if (arg == "--mode") {
+			if (value == "encode") {
+				opts.mode = BenchMode::Encode;
+			} else if (value == "planecopy") {
+				opts.mode = BenchMode::PlaneCopy;
+			} else if (value == "colorconvert") {
+				opts.mode = BenchMode::ColorConvert;
+			} else {
+				fprintf(stderr, "Unknown mode '%s'.\n", value.c_str());
+				return false;
+			}
+		} else if (arg == "--codec") {
+			if (value == "h264") {
+				opts.codec = Codec::AVC;
+			} else if (value == "h265") {
+				opts.codec = Codec::HEVC;
+			} else {
+				fprintf(stderr, "Unknown codec '%s'.\n", value.c_str());
+				return false;
+			}
+		} else if (arg == "--format") {
+			if (value == "nv12") {
+				opts.colorFormat = ColorFormat::NV12;
+			} else if (value == "i420") {
+				opts.colorFormat = ColorFormat::I420;
+			} else if (value == "yuy2") {
+				opts.colorFormat = ColorFormat::YUY2;
+			} else if (value == "bgra") {
+				opts.colorFormat = ColorFormat::BGRA;
+			} else if (value == "rgba") {
+				opts.colorFormat = ColorFormat::RGBA;
+			} else if (value == "gray") {
+				opts.colorFormat = ColorFormat::GRAY;
+			} else {
+				fprintf(stderr, "Unknown color format '%s'.\n", value.c_str());
+				return false;
+			}
+		} else if (arg == "--size") {
+			if (sscanf(value.c_str(), "%" SCNu32 "x%" SCNu32, &opts.resolution.first, &opts.resolution.second) != 2) {
+				fprintf(stderr, "Invalid size '%s'.\n", value.c_str());
+				return false;
+			}
+		} else if (arg == "--fps") {
+			opts.frameRate.second = 1;
+			if (sscanf(value.c_str(), "%" SCNu32 "/%" SCNu32, &opts.frameRate.first, &opts.frameRate.second) < 1) {
+				fprintf(stderr, "Invalid frame rate '%s'.\n", value.c_str());
+				return false;
+			}
+		} else if (arg == "--bitrate") {
+			opts.bitrate = strtoull(value.c_str(), nullptr, 10) * 1000;
+		} else if (arg == "--queue") {
+			opts.queueSize = (size_t)strtoull(value.c_str(), nullptr, 10);
+		} else if (arg == "--threads") {
+			opts.multiThread = (value == "on") || (value == "1");
+		} else if (arg == "--wait") {
+			opts.waitStrategy = (value == "sleep") ? WaitStrategy::Sleep : WaitStrategy::Hybrid;
+		} else if (arg == "--helpers") {
+			opts.helpers = (size_t)strtoull(value.c_str(), nullptr, 10);
+		} else if (arg == "--converter") {
+			opts.conversion = (value == "host") ? ColorConversion::Host : ColorConversion::AMF;
+		} else if (arg == "--frames") {
+			opts.frames = strtoull(value.c_str(), nullptr, 10);
+		} else if (arg == "--warmup") {
+			opts.warmup = strtoull(value.c_str(), nullptr, 10);
+		} else if (arg == "--preroll") {
+			opts.preRoll = (uint32_t)strtoul(value.c_str(), nullptr, 10);
+		} else if (arg == "--api") {
+			opts.api = value;
+		} else if (arg == "--adapter") {
+			opts.adapter = (size_t)strtoull(value.c_str(), nullptr, 10);
+		} else {
+			fprintf(stderr, "Unknown option '%s'.\n", arg.c_str());
+			return false;
+		}
+	}
+
+	if ((opts.resolution.first == 0) || (opts.resolution.second == 0) || (opts.frameRate.first == 0)
+		|| (opts.frameRate.second == 0) || (opts.frames == 0)) {
+		fprintf(stderr, "Resolution, frame rate and frame count must not be zero.\n");
+		return false;
+	}
+	return true;
+}
+
+/// Synthetic OBS frame with the plane layout OBS uses for the given color format.
+class SyntheticFrame {
+	public:
+	SyntheticFrame(ColorFormat format, uint32_t width, uint32_t height, uint8_t seed)
+	{
+		std::memset(&m_Frame, 0, sizeof(m_Frame));
+
+		std::vector<std::pair<uint32_t, uint32_t>> planes; // Row size, Rows
+		switch (format) {
+		case ColorFormat::I420:
+			planes = {{width, height}, {(width + 1) / 2, (height + 1) / 2}, {(width + 1) / 2, (height + 1) / 2}};
+			break;
+		case ColorFormat::NV12:
+			planes = {{width, height}, {(width + 1) & ~1u, (height + 1) / 2}};
+			break;
+		case ColorFormat::YUY2:
+			planes = {{width * 2, height}};
+			break;
+		case ColorFormat::BGRA:
+		case ColorFormat::RGBA:
+			planes = {{width * 4, height}};
+			break;
+		case ColorFormat::GRAY:
+			planes = {{width, height}};
+			break;
+		}
+
+		size_t total = 0;
+		for (auto& plane : planes)
+			total += AlignRow(plane.first) * plane.second;
+		m_Memory.resize(total + BENCH_FRAME_ALIGNMENT);
+
+		uint8_t* ptr = m_Memory.data();
+		ptr += (BENCH_FRAME_ALIGNMENT - (reinterpret_cast<uintptr_t>(ptr) % BENCH_FRAME_ALIGNMENT))
+			   % BENCH_FRAME_ALIGNMENT;
+		for (size_t idx = 0; idx < planes.size(); idx++) {
+			uint32_t linesize     = AlignRow(planes[idx].first);
+			m_Frame.data[idx]     = ptr;
+			m_Frame.linesize[idx] = linesize;
+
+			// A diagonal gradient that moves with the seed.
+			for (uint32_t y = 0; y < planes[idx].second; y++)
+				for (uint32_t x = 0; x < linesize; x++)
+					ptr[(size_t)y * linesize + x] = (uint8_t)(x + y + seed * 8);
+			ptr += (size_t)linesize * planes[idx].second;
+		}
+	}
+
+	struct encoder_frame* Get(int64_t pts)
+	{
+		m_Frame.pts = pts;
+		return &m_Frame;
+	}
+
+	private:
+	static uint32_t AlignRow(uint32_t size)
+	{
+		return (size + BENCH_FRAME_ALIGNMENT - 1) & ~(uint32_t)(BENCH_FRAME_ALIGNMENT - 1);
+	}
+
+	struct encoder_frame m_Frame;
+	std::vector<uint8_t> m_Memory;
+};
+
+static void print_stage(const char* name, LatencySummary summary)
+{
+	printf("  %-9s p50 %9.1f us  p90 %9.1f us  p99 %9.1f us  max %9.1f us  (%" PRIu64 " samples)\n", name,
+		   summary.p50 / 1000.0, summary.p90 / 1000.0, summary.p99 / 1000.0, summary.max / 1000.0, summary.count);
+}
+
+static int run(const BenchOptions& opts)
+{
+	std::shared_ptr<API::IAPI> api = opts.api.empty() ? API::GetAPI(0) : API::GetAPI(opts.api);
+	if (!api)
+		throw std::runtime_error("No video API available.");
+	std::vector<API::Adapter> adapters = api->EnumerateAdapters();
+	if (opts.adapter >= adapters.size())
+		throw std::runtime_error("Adapter index out of range.");
+	API::Adapter adapter = adapters[opts.adapter];
+
+	std::unique_ptr<Encoder> encoder;
+	if (opts.codec == Codec::AVC) {
+		auto h264 = std::make_unique<EncoderH264>(api, adapter, false, false, opts.colorFormat, ColorSpace::BT709,
+												  false, opts.multiThread, opts.queueSize);
+		h264->SetIDRPeriod(opts.frameRate.first * 2 / opts.frameRate.second);
+		encoder = std::move(h264);
+	} else {
+		auto h265 = std::make_unique<EncoderH265>(api, adapter, false, false, opts.colorFormat, ColorSpace::BT709,
+												  false, opts.multiThread, opts.queueSize);
+		h265->SetGOPSize(opts.frameRate.first * 2 / opts.frameRate.second);
+		encoder = std::move(h265);
+	}
+	encoder->SetUsage(Usage::Transcoding);
+	encoder->SetQualityPreset(QualityPreset::Speed);
+	encoder->SetResolution(opts.resolution);
+	encoder->SetFrameRate(opts.frameRate);
+	encoder->SetRateControlMethod(RateControlMethod::ConstantBitrate);
+	encoder->SetTargetBitrate(opts.bitrate);
+	encoder->SetPeakBitrate(opts.bitrate);
+	encoder->SetWaitStrategy(opts.waitStrategy);
+	encoder->SetColorConversion(opts.conversion);
+	encoder->SetMaxHelperThreads(opts.helpers);
+	encoder->SetPreRollFrames(opts.preRoll);
+
+	std::vector<std::unique_ptr<SyntheticFrame>> frames;
+	for (uint8_t idx = 0; idx < BENCH_FRAME_VARIANTS; idx++)
+		frames.push_back(std::make_unique<SyntheticFrame>(opts.colorFormat, opts.resolution.first,
+														  opts.resolution.second, idx));
+
+	printf("Benchmarking %s on %s adapter '%s': %" PRIu32 "x%" PRIu32 " at %" PRIu32 "/%" PRIu32
+		   " fps, %s (%s conversion), %llu kbit/s, queue %llu, %s, %llu helpers.\n",
+		   (opts.codec == Codec::AVC) ? "H264/AVC" : "H265/HEVC", api->GetName().c_str(), adapter.Name.c_str(),
+		   opts.resolution.first, opts.resolution.second, opts.frameRate.first, opts.frameRate.second,
+		   Utility::ColorFormatToString(opts.colorFormat), Utility::ColorConversionToString(opts.conversion),
+		   (unsigned long long)(opts.bitrate / 1000),
+		   (unsigned long long)opts.queueSize, opts.multiThread ? "multi-threaded" : "single-threaded",
+		   (unsigned long long)opts.helpers);
+
+	encoder->Start();
+
+	LatencyHistogram encodeCall;
+	uint64_t         packets = 0, keyframes = 0, bytes = 0;
+	auto             count_packet = [&](struct encoder_packet* packet) {
+        // Packets of warm-up frames may still arrive after measuring started.
+        if (packet->pts < (int64_t)opts.warmup)
+            return;
+        packets++;
+        keyframes += packet->keyframe ? 1 : 0;
+        bytes += packet->size;
+	};
+
+	std::chrono::high_resolution_clock::time_point wallStart;
+	std::chrono::nanoseconds                       cpuStart;
+	uint64_t                                       allocStart = 0, allocBytesStart = 0, droppedStart = 0;
+	uint64_t                                       total      = opts.warmup + opts.frames;
+	for (uint64_t idx = 0; idx < total; idx++) {
+		if (idx == opts.warmup) {
+			packets = keyframes = bytes = 0;
+			encodeCall.Reset();
+			allocStart      = g_AllocationCount.load(std::memory_order_relaxed);
+			allocBytesStart = g_AllocationBytes.load(std::memory_order_relaxed);
+			droppedStart    = encoder->GetDroppedFrameCount();
+			cpuStart        = process_cpu_time();
+			wallStart       = std::chrono::high_resolution_clock::now();
+		}
+
+		struct encoder_packet packet;
+		std::memset(&packet, 0, sizeof(packet));
+		bool received = false;
+
+		auto callStart = std::chrono::high_resolution_clock::now();
+		if (!encoder->Encode(frames[idx % frames.size()]->Get((int64_t)idx), &packet, &received))
+			throw std::runtime_error("Encode() failed.");
+		encodeCall.Record(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - callStart)
+				.count());
+
+		if (received)
+			count_packet(&packet);
+	}
+	auto     wallTime   = std::chrono::high_resolution_clock::now() - wallStart;
+	auto     cpuTime    = process_cpu_time() - cpuStart;
+	uint64_t allocCount = g_AllocationCount.load(std::memory_order_relaxed) - allocStart;
+	uint64_t allocBytes = g_AllocationBytes.load(std::memory_order_relaxed) - allocBytesStart;
+
+	bool drained = encoder->Drain(count_packet, BENCH_DRAIN_TIMEOUT);
+	// Dropped frames never return a packet, so throughput counts what came back until the encoder was drained.
+	auto     deliverTime = std::chrono::high_resolution_clock::now() - wallStart;
+	uint64_t dropped     = encoder->GetDroppedFrameCount() - droppedStart;
+
+	double_t seconds   = std::chrono::duration_cast<std::chrono::duration<double_t>>(wallTime).count();
+	double_t delivered = std::chrono::duration_cast<std::chrono::duration<double_t>>(deliverTime).count();
+	printf("Results over %llu frames (after %llu warm-up frames):\n", (unsigned long long)opts.frames,
+		   (unsigned long long)opts.warmup);
+	printf("  Throughput  %.2f frames/s (%llu packets in %.3f s), %llu frames dropped\n", packets / delivered,
+		   (unsigned long long)packets, delivered, (unsigned long long)dropped);
+	printf("  CPU time    %.3f ms/frame (%.1f%% of one core)\n",
+		   std::chrono::duration_cast<std::chrono::duration<double_t, std::milli>>(cpuTime).count() / opts.frames,
+		   std::chrono::duration_cast<std::chrono::duration<double_t>>(cpuTime).count() / seconds * 100.0);
+	printf("  Allocations %.2f/frame, %.1f bytes/frame\n", (double_t)allocCount / opts.frames,
+		   (double_t)allocBytes / opts.frames);
+	printf("  Packets     %llu (%llu keyframes), %.1f kbit/s%s\n", (unsigned long long)packets,
+		   (unsigned long long)keyframes, bytes * 8.0 / seconds / 1000.0, drained ? "" : ", drain timed out");
+	printf("  Converter   skipped for %llu of %llu frames\n", (unsigned long long)encoder->GetConverterSkippedCount(),
+		   (unsigned long long)total);
+	printf("Latency:\n");
+	print_stage("Encode()", encodeCall.GetSummary());
+	print_stage("Allocate", encoder->GetLatencySummary(EncoderStage::Allocate));
+	print_stage("Store", encoder->GetLatencySummary(EncoderStage::Store));
+	print_stage("Convert", encoder->GetLatencySummary(EncoderStage::Convert));
+	print_stage("Main", encoder->GetLatencySummary(EncoderStage::Main));
+	print_stage("Load", encoder->GetLatencySummary(EncoderStage::Load));
+	print_stage("Wait", encoder->GetLatencySummary(EncoderStage::Wait));
+
+	encoder->Stop();
+	if (!drained)
+		return 3;
+	return (dropped > 0) ? 4 : 0;
+}
+
+#pragma region Plane Copy
+/// Host memory laid out like a set of surfaces or OBS frames with the given planes.
+class PlaneBuffers {
+	public:
+	PlaneBuffers(const std::vector<std::pair<size_t, size_t>>& planes, size_t alignment, size_t copies)
+	{
+		size_t frameSize = 0;
+		for (auto& plane : planes) {
+			size_t pitch = (plane.first + alignment - 1) / alignment * alignment;
+			m_Pitches.push_back(pitch);
+			frameSize += pitch * plane.second;
+		}
+		m_FrameSize = frameSize;
+
+		m_Memory.resize(frameSize * copies + alignment);
+		uint8_t* ptr = m_Memory.data();
+		ptr += (alignment - (reinterpret_cast<uintptr_t>(ptr) % alignment)) % alignment;
+		for (size_t copy = 0; copy < copies; copy++) {
+			std::vector<uint8_t*> frame;
+			for (size_t idx = 0; idx < planes.size(); idx++) {
+				frame.push_back(ptr);
+				ptr += m_Pitches[idx] * planes[idx].second;
+			}
+			m_Frames.push_back(frame);
+		}
+
+		// Touch everything once so page faults don't end up in the measurement.
+		for (size_t idx = 0; idx < m_Memory.size(); idx++)
+			m_Memory[idx] = (uint8_t)idx;
+	}
+
+	uint8_t* Plane(size_t copy, size_t plane)
+	{
+		return m_Frames[copy % m_Frames.size()][plane];
+	}
+
+	size_t Pitch(size_t plane)
+	{
+		return m_Pitches[plane];
+	}
+
+	private:
+	std::vector<uint8_t>               m_Memory;
+	std::vector<size_t>                m_Pitches;
+	std::vector<std::vector<uint8_t*>> m_Frames;
+	size_t                             m_FrameSize;
+};
+
+static int run_plane_copy()
+{
+	struct Format {
+		const char*                                    name;
+		std::function<std::vector<std::pair<size_t, size_t>>(size_t, size_t)> planes; // Row size, Rows
+	};
+	const Format formats[] = {
+		{"NV12", [](size_t w, size_t h) { return std::vector<std::pair<size_t, size_t>>{{w, h}, {w, h / 2}}; }},
+		{"I420",
+		 [](size_t w, size_t h) {
+			 return std::vector<std::pair<size_t, size_t>>{{w, h}, {w / 2, h / 2}, {w / 2, h / 2}};
+		 }},
+		{"BGRA", [](size_t w, size_t h) { return std::vector<std::pair<size_t, size_t>>{{w * 4, h}}; }},
+	};
+	const std::pair<size_t, size_t> resolutions[] = {{1920, 1080}, {2560, 1440}, {3840, 2160}};
+
+	printf("Plane copy, last level cache %llu KiB, best kernel %s.\n",
+		   (unsigned long long)(PlaneCopy::GetLastLevelCacheSize() / 1024),
+		   PlaneCopy::GetKernelName(PlaneCopy::GetKernel()));
+	printf("%-6s %-10s %-16s %12s %10s\n", "Format", "Size", "Variant", "us/frame", "GB/s");
+
+	for (auto& resolution : resolutions) {
+		for (auto& format : formats) {
+			auto planes = format.planes(resolution.first, resolution.second);
+
+			size_t visible = 0;
+			for (auto& plane : planes)
+				visible += plane.first * plane.second;
+
+			// Several frames on both sides, so consecutive iterations don't find everything in cache.
+			PlaneBuffers source(planes, BENCH_FRAME_ALIGNMENT, BENCH_FRAME_VARIANTS);
+			PlaneBuffers surface(planes, BENCH_SURFACE_ALIGNMENT, BENCH_FRAME_VARIANTS);
+
+			struct Variant {
+				std::string                 name;
+				std::function<void(size_t)> copy;
+			};
+			std::vector<Variant> variants;
+			variants.push_back({"Row memcpy", [&](size_t frame) {
+									// The previous EncodeStore loop, copying the full OBS line size per row.
+									for (size_t idx = 0; idx < planes.size(); idx++) {
+										size_t row = min(source.Pitch(idx), surface.Pitch(idx));
+										for (size_t y = 0; y < planes[idx].second; y++)
+											std::memcpy(surface.Plane(frame, idx) + y * surface.Pitch(idx),
+														source.Plane(frame, idx) + y * source.Pitch(idx), row);
+									}
+								}});
+			for (PlaneCopyKernel kernel : {PlaneCopyKernel::Scalar, PlaneCopyKernel::SSE2, PlaneCopyKernel::AVX2}) {
+				if (!PlaneCopy::IsKernelSupported(kernel))
+					continue;
+				bool streaming = (kernel != PlaneCopyKernel::Scalar);
+				variants.push_back({std::string(PlaneCopy::GetKernelName(kernel)) + (streaming ? " stream" : ""),
+									[&, kernel, streaming](size_t frame) {
+										for (size_t idx = 0; idx < planes.size(); idx++)
+											PlaneCopy::Copy(kernel, surface.Plane(frame, idx), surface.Pitch(idx),
+															source.Plane(frame, idx), source.Pitch(idx),
+															planes[idx].first, planes[idx].second, streaming);
+									}});
+			}
+			bool autoStreaming = PlaneCopy::IsStreamingWorthwhile(visible);
+			variants.push_back({autoStreaming ? "Auto (stream)" : "Auto (cached)", [&](size_t frame) {
+									for (size_t idx = 0; idx < planes.size(); idx++)
+										PlaneCopy::Copy(surface.Plane(frame, idx), surface.Pitch(idx),
+														source.Plane(frame, idx), source.Pitch(idx),
+														planes[idx].first, planes[idx].second, autoStreaming);
+								}});
+
+			for (auto& variant : variants) {
+				size_t iterations = 0;
+				auto   start      = std::chrono::high_resolution_clock::now();
+				auto   elapsed    = std::chrono::high_resolution_clock::duration::zero();
+				do {
+					variant.copy(iterations++);
+					elapsed = std::chrono::high_resolution_clock::now() - start;
+				} while (elapsed < BENCH_COPY_DURATION);
+
+				double_t seconds = std::chrono::duration_cast<std::chrono::duration<double_t>>(elapsed).count();
+				char     size[32];
+				snprintf(size, sizeof(size), "%zux%zu", resolution.first, resolution.second);
+				printf("%-6s %-10s %-16s %12.1f %10.2f\n", format.name, size, variant.name.c_str(),
+					   seconds / iterations * 1000000.0, visible * iterations / seconds / 1000000000.0);
+			}
+		}
+	}
+	return 0;
+}
+#pragma endregion Plane Copy
+
+#pragma region Color Conversion
+static int run_color_convert()
+{
+	const std::pair<size_t, size_t> resolutions[] = {{1920, 1080}, {2560, 1440}, {3840, 2160}};
+
+	printf("Color conversion BGRA to NV12 (BT.709, limited range), best kernel %s.\n",
+		   HostColorConverter::GetKernelName());
+	printf("%-10s %-10s %12s %10s %8s\n", "Size", "Variant", "us/frame", "MPixel/s", "Matches");
+
+	HostColorConverter converter(ColorFormat::BGRA, ColorSpace::BT709, false);
+	int                result = 0;
+	for (auto& resolution : resolutions) {
+		size_t width = resolution.first, height = resolution.second;
+
+		PlaneBuffers source({{width * 4, height}}, BENCH_FRAME_ALIGNMENT, BENCH_FRAME_VARIANTS);
+		PlaneBuffers surface({{width, height}, {width, height / 2}}, BENCH_SURFACE_ALIGNMENT, BENCH_FRAME_VARIANTS);
+		PlaneBuffers reference({{width, height}, {width, height / 2}}, BENCH_SURFACE_ALIGNMENT, 1);
+		converter.ConvertScalar(source.Plane(0, 0), source.Pitch(0), reference.Plane(0, 0), reference.Pitch(0),
+								reference.Plane(0, 1), reference.Pitch(1), width, height);
+
+		struct Variant {
+			const char*                 name;
+			std::function<void(size_t)> convert;
+		};
+		std::vector<Variant> variants;
+		variants.push_back({"Scalar", [&](size_t frame) {
+								converter.ConvertScalar(source.Plane(frame, 0), source.Pitch(0),
+														surface.Plane(frame, 0), surface.Pitch(0),
+														surface.Plane(frame, 1), surface.Pitch(1), width, height);
+							}});
+		if (HostColorConverter::IsVectorized()) {
+			variants.push_back({HostColorConverter::GetKernelName(), [&](size_t frame) {
+									converter.Convert(source.Plane(frame, 0), source.Pitch(0), surface.Plane(frame, 0),
+													  surface.Pitch(0), surface.Plane(frame, 1), surface.Pitch(1),
+													  width, height);
+								}});
+		}
+
+		for (auto& variant : variants) {
+			size_t iterations = 0;
+			auto   start      = std::chrono::high_resolution_clock::now();
+			auto   elapsed    = std::chrono::high_resolution_clock::duration::zero();
+			do {
+				variant.convert(iterations++);
+				elapsed = std::chrono::high_resolution_clock::now() - start;
+			} while (elapsed < BENCH_COPY_DURATION);
+
+			// The first frame of each variant has to be identical to the scalar reference.
+			variant.convert(0);
+			bool matches = true;
+			for (size_t y = 0; y < height; y++)
+				matches &= (std::memcmp(surface.Plane(0, 0) + y * surface.Pitch(0),
+										reference.Plane(0, 0) + y * reference.Pitch(0), width)
+							== 0);
+			for (size_t y = 0; y < height / 2; y++)
+				matches &= (std::memcmp(surface.Plane(0, 1) + y * surface.Pitch(1),
+										reference.Plane(0, 1) + y * reference.Pitch(1), width)
+							== 0);
+			if (!matches)
+				result = 3;
+
+			double_t seconds = std::chrono::duration_cast<std::chrono::duration<double_t>>(elapsed).count();
+			char     size[32];
+			snprintf(size, sizeof(size), "%zux%zu", width, height);
+			printf("%-10s %-10s %12.1f %10.1f %8s\n", size, variant.name, seconds / iterations * 1000000.0,
+				   width * height * iterations / seconds / 1000000.0, matches ? "yes" : "NO");
+		}
+	}
+	return result;
+}
+#pragma endregion Color Conversion
+
+int main(int argc, char* argv[])
+{
+	BenchOptions opts;
+	if (!parse_options(argc, argv, opts)) {
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	if (opts.mode == BenchMode::PlaneCopy)
+		return run_plane_copy();
+	if (opts.mode == BenchMode::ColorConvert)
+		return run_color_convert();
+
+	try {
+		AMF::Initialize();
+		API::InitializeAPIs();
+		int result = run(opts);
+		API::FinalizeAPIs();
+		AMF::Finalize();
+		return result;
+	} catch (std::exception& ex) {
+		printf("[AMF] %s\n", ex.what());
+		fflush(NULL);
+		return 2;
+	} catch (...) {
+		printf("[AMF] Unknown Error\n");
+		fflush(NULL);
+		return 2;
+	}
+}
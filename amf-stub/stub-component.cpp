@@ -0,0 +1,211 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "stub-component.hpp"
+#include <cwchar>
+
+using namespace AMFStub;
+
+AMFStub::Component::Component(amf::AMFContext* context) : m_Context(context) {}
+
+AMFStub::Component::~Component() {}
+
+amf_size AMF_STD_CALL AMFStub::Component::GetPropertiesInfoCount() const
+{
+	return m_Info.size();
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Component::GetPropertyInfo(amf_size index, const amf::AMFPropertyInfo** ppInfo) const
+{
+	if (ppInfo == nullptr)
+		return AMF_INVALID_POINTER;
+	if (index >= m_Info.size())
+		return AMF_OUT_OF_RANGE;
+	*ppInfo = &m_Info[index];
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Component::GetPropertyInfo(const wchar_t* name,
+															const amf::AMFPropertyInfo** ppInfo) const
+{
+	if ((name == nullptr) || (ppInfo == nullptr))
+		return AMF_INVALID_POINTER;
+	*ppInfo = FindInfo(name);
+	return (*ppInfo != nullptr) ? AMF_OK : AMF_NOT_FOUND;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Component::ValidateProperty(const wchar_t* name, amf::AMFVariantStruct value,
+															 amf::AMFVariantStruct* pOutValidated) const
+{
+	if ((name == nullptr) || (pOutValidated == nullptr))
+		return AMF_INVALID_POINTER;
+
+	amf::AMFVariant validated;
+	AMF_RESULT      res = Validate(name, value, validated);
+	if (res != AMF_OK)
+		return res;
+	return amf::AMFVariantCopy(pOutValidated, &validated);
+}
+
+amf::AMFContext* AMF_STD_CALL AMFStub::Component::GetContext()
+{
+	return m_Context;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Component::SetOutputDataAllocatorCB(amf::AMFDataAllocatorCB*)
+{
+	// Output is always allocated from host memory.
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Component::GetCaps(amf::AMFCaps**)
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Component::Optimize(amf::AMFComponentOptimizationCallback*)
+{
+	return AMF_OK;
+}
+
+void AMFStub::Component::AddInt(const wchar_t* name, int64_t def, int64_t min, int64_t max)
+{
+	AddInfo(name, amf::AMF_VARIANT_INT64, amf::AMFVariant(def));
+	amf::AMFVariantAssignInt64(&m_Info.back().minValue, min);
+	amf::AMFVariantAssignInt64(&m_Info.back().maxValue, max);
+}
+
+void AMFStub::Component::AddEnum(const wchar_t* name, int64_t def, const amf::AMFEnumDescriptionEntry* entries)
+{
+	int64_t min = INT64_MAX, max = INT64_MIN;
+	for (const amf::AMFEnumDescriptionEntry* entry = entries; entry->name != nullptr; entry++) {
+		min = (entry->value < min) ? entry->value : min;
+		max = (entry->value > max) ? entry->value : max;
+	}
+
+	AddInt(name, def, min, max);
+	m_Info.back().pEnumDescription = entries;
+}
+
+void AMFStub::Component::AddBool(const wchar_t* name, bool def)
+{
+	AddInfo(name, amf::AMF_VARIANT_BOOL, amf::AMFVariant(def));
+}
+
+void AMFStub::Component::AddSize(const wchar_t* name, AMFSize def, AMFSize min, AMFSize max)
+{
+	AddInfo(name, amf::AMF_VARIANT_SIZE, amf::AMFVariant(def));
+	amf::AMFVariantAssignSize(&m_Info.back().minValue, min);
+	amf::AMFVariantAssignSize(&m_Info.back().maxValue, max);
+}
+
+void AMFStub::Component::AddRate(const wchar_t* name, AMFRate def)
+{
+	AddInfo(name, amf::AMF_VARIANT_RATE, amf::AMFVariant(def));
+}
+
+void AMFStub::Component::AddRatio(const wchar_t* name, AMFRatio def)
+{
+	AddInfo(name, amf::AMF_VARIANT_RATIO, amf::AMFVariant(def));
+}
+
+void AMFStub::Component::AddInterface(const wchar_t* name)
+{
+	AddInfo(name, amf::AMF_VARIANT_INTERFACE, amf::AMFVariant());
+}
+
+void AMFStub::Component::ResetProperties()
+{
+	Clear();
+	for (const amf::AMFPropertyInfo& info : m_Info) {
+		if (info.type != amf::AMF_VARIANT_INTERFACE)
+			StoreProperty(info.name, amf::AMFVariant(info.defaultValue));
+	}
+}
+
+int64_t AMFStub::Component::QueryInt(const wchar_t* name, int64_t fallback) const
+{
+	amf::AMFVariant value;
+	if (GetProperty(name, &value) != AMF_OK)
+		return fallback;
+	return value.ToInt64();
+}
+
+bool AMFStub::Component::QueryBool(const wchar_t* name, bool fallback) const
+{
+	amf::AMFVariant value;
+	if (GetProperty(name, &value) != AMF_OK)
+		return fallback;
+	return value.ToBool();
+}
+
+AMF_RESULT AMFStub::Component::Validate(const wchar_t* name, const amf::AMFVariantStruct& value,
+										amf::AMFVariant& validated) const
+{
+	// Undescribed properties are passed through, the real runtime accepts plenty of those too.
+	const amf::AMFPropertyInfo* info = FindInfo(name);
+	if ((info == nullptr) || (info->type == amf::AMF_VARIANT_INTERFACE)) {
+		validated = amf::AMFVariant(value);
+		return AMF_OK;
+	}
+
+	AMF_RESULT res = amf::AMFVariantChangeType(&validated, &value, info->type);
+	if (res != AMF_OK)
+		return AMF_INVALID_DATA_TYPE;
+
+	if (info->type == amf::AMF_VARIANT_INT64) {
+		int64_t v = validated.ToInt64();
+		if (info->pEnumDescription != nullptr) {
+			for (const amf::AMFEnumDescriptionEntry* entry = info->pEnumDescription; entry->name != nullptr; entry++) {
+				if (entry->value == v)
+					return AMF_OK;
+			}
+			return AMF_OUT_OF_RANGE;
+		}
+		if ((info->minValue.int64Value < info->maxValue.int64Value)
+			&& ((v < info->minValue.int64Value) || (v > info->maxValue.int64Value)))
+			return AMF_OUT_OF_RANGE;
+	} else if ((info->type == amf::AMF_VARIANT_SIZE) && (info->minValue.sizeValue.width != 0)) {
+		AMFSize v = validated.ToSize();
+		if ((v.width < info->minValue.sizeValue.width) || (v.width > info->maxValue.sizeValue.width)
+			|| (v.height < info->minValue.sizeValue.height) || (v.height > info->maxValue.sizeValue.height))
+			return AMF_OUT_OF_RANGE;
+	}
+	return AMF_OK;
+}
+
+const amf::AMFPropertyInfo* AMFStub::Component::FindInfo(const wchar_t* name) const
+{
+	for (const amf::AMFPropertyInfo& info : m_Info) {
+		if (wcscmp(info.name, name) == 0)
+			return &info;
+	}
+	return nullptr;
+}
+
+void AMFStub::Component::AddInfo(const wchar_t* name, amf::AMF_VARIANT_TYPE type, const amf::AMFVariant& def)
+{
+	amf::AMFPropertyInfo info;
+	info.name       = name;
+	info.desc       = name;
+	info.type       = type;
+	info.accessType = amf::AMF_PROPERTY_ACCESS_FULL;
+	amf::AMFVariantCopy(&info.defaultValue, const_cast<amf::AMFVariant*>(&def));
+	m_Info.push_back(info);
+}
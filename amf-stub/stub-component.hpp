@@ -0,0 +1,76 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#include <cinttypes>
+#include <vector>
+#include "stub.hpp"
+
+#include <components/Component.h>
+#include <core/Context.h>
+
+namespace AMFStub {
+	/// Shared plumbing for all components: a static property description table, validation against it and the
+	/// parts of AMFComponent that behave the same everywhere.
+	class Component : public PropertyObject<amf::AMFComponent, amf::AMFPropertyStorageEx, amf::AMFPropertyStorage> {
+		public:
+		Component(amf::AMFContext* context);
+		virtual ~Component();
+
+		// AMFPropertyStorageEx
+		amf_size AMF_STD_CALL   GetPropertiesInfoCount() const override;
+		AMF_RESULT AMF_STD_CALL GetPropertyInfo(amf_size index, const amf::AMFPropertyInfo** ppInfo) const override;
+		AMF_RESULT AMF_STD_CALL GetPropertyInfo(const wchar_t* name, const amf::AMFPropertyInfo** ppInfo) const override;
+		AMF_RESULT AMF_STD_CALL ValidateProperty(const wchar_t* name, amf::AMFVariantStruct value,
+												 amf::AMFVariantStruct* pOutValidated) const override;
+
+		// AMFComponent
+		amf::AMFContext* AMF_STD_CALL GetContext() override;
+		AMF_RESULT AMF_STD_CALL       SetOutputDataAllocatorCB(amf::AMFDataAllocatorCB* callback) override;
+		AMF_RESULT AMF_STD_CALL       GetCaps(amf::AMFCaps** ppCaps) override;
+		AMF_RESULT AMF_STD_CALL       Optimize(amf::AMFComponentOptimizationCallback* pCallback) override;
+
+		protected:
+		void AddInt(const wchar_t* name, int64_t def, int64_t min, int64_t max);
+		void AddEnum(const wchar_t* name, int64_t def, const amf::AMFEnumDescriptionEntry* entries);
+		void AddBool(const wchar_t* name, bool def);
+		void AddSize(const wchar_t* name, AMFSize def, AMFSize min, AMFSize max);
+		void AddRate(const wchar_t* name, AMFRate def);
+		void AddRatio(const wchar_t* name, AMFRatio def);
+		void AddInterface(const wchar_t* name);
+
+		/// Stores the default of every described property.
+		void ResetProperties();
+
+		int64_t QueryInt(const wchar_t* name, int64_t fallback) const;
+		bool    QueryBool(const wchar_t* name, bool fallback) const;
+
+		AMF_RESULT Validate(const wchar_t* name, const amf::AMFVariantStruct& value,
+							amf::AMFVariant& validated) const override;
+
+		amf::AMFContextPtr m_Context;
+
+		private:
+		const amf::AMFPropertyInfo* FindInfo(const wchar_t* name) const;
+		void                        AddInfo(const wchar_t* name, amf::AMF_VARIANT_TYPE type,
+											const amf::AMFVariant& def);
+
+		std::vector<amf::AMFPropertyInfo> m_Info;
+	};
+} // namespace AMFStub
@@ -0,0 +1,317 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "stub-converter.hpp"
+#include <cstring>
+#include "stub-memory.hpp"
+
+#include <components/VideoConverter.h>
+
+using namespace AMFStub;
+
+static const amf::AMFEnumDescriptionEntry converter_color_profile[] = {
+	{AMF_VIDEO_CONVERTER_COLOR_PROFILE_UNKNOWN, L"Automatic"},
+	{AMF_VIDEO_CONVERTER_COLOR_PROFILE_601, L"BT.601"},
+	{AMF_VIDEO_CONVERTER_COLOR_PROFILE_709, L"BT.709"},
+	{AMF_VIDEO_CONVERTER_COLOR_PROFILE_2020, L"BT.2020"},
+	{AMF_VIDEO_CONVERTER_COLOR_PROFILE_JPEG, L"JPEG"},
+	{0, nullptr},
+};
+
+static inline uint8_t clamp_u8(int32_t v)
+{
+	return (uint8_t)((v < 0) ? 0 : ((v > 255) ? 255 : v));
+}
+
+AMFStub::Converter::Converter(amf::AMFContext* context) : Component(context)
+{
+	// Null Values
+	m_Initialized = false;
+	m_Draining    = false;
+	m_Format      = amf::AMF_SURFACE_UNKNOWN;
+	m_Width       = 0;
+	m_Height      = 0;
+	m_LumaOffset  = 0;
+
+	AddInt(AMF_VIDEO_CONVERTER_OUTPUT_FORMAT, amf::AMF_SURFACE_NV12, amf::AMF_SURFACE_UNKNOWN, amf::AMF_SURFACE_LAST);
+	AddInt(AMF_VIDEO_CONVERTER_MEMORY_TYPE, amf::AMF_MEMORY_UNKNOWN, amf::AMF_MEMORY_UNKNOWN, amf::AMF_MEMORY_VULKAN);
+	AddSize(AMF_VIDEO_CONVERTER_OUTPUT_SIZE, AMFConstructSize(0, 0), AMFConstructSize(0, 0), AMFConstructSize(0, 0));
+	AddEnum(AMF_VIDEO_CONVERTER_COLOR_PROFILE, AMF_VIDEO_CONVERTER_COLOR_PROFILE_UNKNOWN, converter_color_profile);
+	AddInt(AMF_VIDEO_CONVERTER_TRANSFER_CHARACTERISTIC, 0, 0, 18);
+	ResetProperties();
+}
+
+AMFStub::Converter::~Converter() {}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Converter::Init(amf::AMF_SURFACE_FORMAT format, amf_int32 width, amf_int32 height)
+{
+	if (QueryInt(AMF_VIDEO_CONVERTER_OUTPUT_FORMAT, amf::AMF_SURFACE_NV12) != amf::AMF_SURFACE_NV12)
+		return AMF_NOT_SUPPORTED;
+
+	switch (format) {
+		case amf::AMF_SURFACE_NV12:
+		case amf::AMF_SURFACE_YUV420P:
+		case amf::AMF_SURFACE_YV12:
+		case amf::AMF_SURFACE_YUY2:
+		case amf::AMF_SURFACE_BGRA:
+		case amf::AMF_SURFACE_RGBA:
+		case amf::AMF_SURFACE_ARGB:
+		case amf::AMF_SURFACE_GRAY8:
+			break;
+		default:
+			return AMF_NOT_SUPPORTED;
+	}
+	if ((width <= 0) || (height <= 0))
+		return AMF_INVALID_ARG;
+
+	std::lock_guard<std::mutex> lock(m_Lock);
+	m_Format      = format;
+	m_Width       = width;
+	m_Height      = height;
+	m_Initialized = true;
+	m_Draining    = false;
+	m_Output      = nullptr;
+	UpdateMatrix();
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Converter::ReInit(amf_int32 width, amf_int32 height)
+{
+	return Init(m_Format, width, height);
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Converter::Terminate()
+{
+	std::lock_guard<std::mutex> lock(m_Lock);
+	m_Initialized = false;
+	m_Draining    = false;
+	m_Output      = nullptr;
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Converter::Drain()
+{
+	std::lock_guard<std::mutex> lock(m_Lock);
+	m_Draining = true;
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Converter::Flush()
+{
+	std::lock_guard<std::mutex> lock(m_Lock);
+	m_Draining = false;
+	m_Output   = nullptr;
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Converter::SubmitInput(amf::AMFData* pData)
+{
+	if (pData == nullptr)
+		return AMF_INVALID_POINTER;
+
+	amf::AMFSurfacePtr input(pData);
+	if (input == nullptr)
+		return AMF_INVALID_DATA_TYPE;
+
+	std::lock_guard<std::mutex> lock(m_Lock);
+	if (!m_Initialized)
+		return AMF_NOT_INITIALIZED;
+	if (m_Output != nullptr)
+		return AMF_INPUT_FULL;
+	if ((input->GetFormat() != m_Format) || (input->GetPlaneAt(0)->GetWidth() != m_Width)
+		|| (input->GetPlaneAt(0)->GetHeight() != m_Height))
+		return AMF_INVALID_ARG;
+
+	amf::AMF_MEMORY_TYPE type = (amf::AMF_MEMORY_TYPE)QueryInt(AMF_VIDEO_CONVERTER_MEMORY_TYPE, 0);
+	if (type == amf::AMF_MEMORY_UNKNOWN)
+		type = input->GetMemoryType();
+
+	amf::AMFSurfacePtr output;
+	AMF_RESULT         res = m_Context->AllocSurface(type, amf::AMF_SURFACE_NV12, m_Width, m_Height, &output);
+	if (res != AMF_OK)
+		return res;
+	res = Convert(input, output);
+	if (res != AMF_OK)
+		return res;
+
+	input->AddTo(output, true, false);
+	output->SetPts(input->GetPts());
+	output->SetDuration(input->GetDuration());
+	m_Output = output;
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Converter::QueryOutput(amf::AMFData** ppData)
+{
+	if (ppData == nullptr)
+		return AMF_INVALID_POINTER;
+	*ppData = nullptr;
+
+	std::lock_guard<std::mutex> lock(m_Lock);
+	if (m_Output == nullptr)
+		return m_Draining ? AMF_EOF : AMF_REPEAT;
+
+	*ppData = m_Output.Detach();
+	return AMF_OK;
+}
+
+void AMFStub::Converter::UpdateMatrix()
+{
+	double  kr, kb;
+	int64_t profile = QueryInt(AMF_VIDEO_CONVERTER_COLOR_PROFILE, AMF_VIDEO_CONVERTER_COLOR_PROFILE_UNKNOWN);
+	switch (profile) {
+		case AMF_VIDEO_CONVERTER_COLOR_PROFILE_601:
+			kr = 0.299;
+			kb = 0.114;
+			break;
+		case AMF_VIDEO_CONVERTER_COLOR_PROFILE_2020:
+			kr = 0.2627;
+			kb = 0.0593;
+			break;
+		default:
+			kr = 0.2126;
+			kb = 0.0722;
+			break;
+	}
+	double kg = 1.0 - kr - kb;
+
+	// JPEG is full range BT.709, everything else uses studio swing.
+	bool   full        = (profile == AMF_VIDEO_CONVERTER_COLOR_PROFILE_JPEG);
+	double lumaScale   = full ? 1.0 : (219.0 / 255.0);
+	double chromaScale = full ? 1.0 : (224.0 / 255.0);
+	m_LumaOffset       = full ? 0 : 16;
+	const double matrix[3][3] = {
+		{kr * lumaScale, kg * lumaScale, kb * lumaScale},
+		{-kr / (2 * (1 - kb)) * chromaScale, -kg / (2 * (1 - kb)) * chromaScale, 0.5 * chromaScale},
+		{0.5 * chromaScale, -kg / (2 * (1 - kr)) * chromaScale, -kb / (2 * (1 - kr)) * chromaScale},
+	};
+	for (size_t row = 0; row < 3; row++) {
+		for (size_t col = 0; col < 3; col++)
+			m_Matrix[row][col] = (int32_t)(matrix[row][col] * 65536.0 + (matrix[row][col] < 0 ? -0.5 : 0.5));
+	}
+}
+
+AMF_RESULT AMFStub::Converter::Convert(amf::AMFSurface* input, amf::AMFSurface* output)
+{
+	amf::AMFPlane* dstY  = output->GetPlane(amf::AMF_PLANE_Y);
+	amf::AMFPlane* dstUV = output->GetPlane(amf::AMF_PLANE_UV);
+	uint8_t*       y     = static_cast<uint8_t*>(dstY->GetNative());
+	uint8_t*       uv    = static_cast<uint8_t*>(dstUV->GetNative());
+	size_t         yPitch = dstY->GetHPitch(), uvPitch = dstUV->GetHPitch();
+	amf_int32      cw = (m_Width + 1) / 2, ch = (m_Height + 1) / 2;
+
+	amf::AMFPlane* src   = input->GetPlaneAt(0);
+	uint8_t*       s     = static_cast<uint8_t*>(src->GetNative());
+	size_t         sPitch = src->GetHPitch();
+
+	switch (m_Format) {
+		case amf::AMF_SURFACE_NV12: {
+			amf::AMFPlane* srcUV = input->GetPlane(amf::AMF_PLANE_UV);
+			for (amf_int32 row = 0; row < m_Height; row++)
+				std::memcpy(y + row * yPitch, s + row * sPitch, m_Width);
+			for (amf_int32 row = 0; row < ch; row++)
+				std::memcpy(uv + row * uvPitch, static_cast<uint8_t*>(srcUV->GetNative()) + row * srcUV->GetHPitch(),
+							cw * 2);
+			break;
+		}
+		case amf::AMF_SURFACE_YUV420P:
+		case amf::AMF_SURFACE_YV12: {
+			amf::AMFPlane* srcU = input->GetPlane(amf::AMF_PLANE_U);
+			amf::AMFPlane* srcV = input->GetPlane(amf::AMF_PLANE_V);
+			for (amf_int32 row = 0; row < m_Height; row++)
+				std::memcpy(y + row * yPitch, s + row * sPitch, m_Width);
+			for (amf_int32 row = 0; row < ch; row++) {
+				uint8_t* u = static_cast<uint8_t*>(srcU->GetNative()) + row * srcU->GetHPitch();
+				uint8_t* v = static_cast<uint8_t*>(srcV->GetNative()) + row * srcV->GetHPitch();
+				uint8_t* d = uv + row * uvPitch;
+				for (amf_int32 col = 0; col < cw; col++) {
+					d[col * 2]     = u[col];
+					d[col * 2 + 1] = v[col];
+				}
+			}
+			break;
+		}
+		case amf::AMF_SURFACE_YUY2:
+			for (amf_int32 row = 0; row < m_Height; row++) {
+				uint8_t* line = s + row * sPitch;
+				for (amf_int32 col = 0; col < m_Width; col++)
+					y[row * yPitch + col] = line[col * 2];
+			}
+			for (amf_int32 row = 0; row < ch; row++) {
+				uint8_t* top    = s + (row * 2) * sPitch;
+				uint8_t* bottom = s + ((row * 2 + 1 < m_Height) ? row * 2 + 1 : row * 2) * sPitch;
+				uint8_t* d      = uv + row * uvPitch;
+				for (amf_int32 col = 0; col < cw; col++) {
+					d[col * 2]     = (uint8_t)((top[col * 4 + 1] + bottom[col * 4 + 1] + 1) / 2);
+					d[col * 2 + 1] = (uint8_t)((top[col * 4 + 3] + bottom[col * 4 + 3] + 1) / 2);
+				}
+			}
+			break;
+		case amf::AMF_SURFACE_GRAY8:
+			for (amf_int32 row = 0; row < m_Height; row++)
+				std::memcpy(y + row * yPitch, s + row * sPitch, m_Width);
+			for (amf_int32 row = 0; row < ch; row++)
+				std::memset(uv + row * uvPitch, 128, cw * 2);
+			break;
+		case amf::AMF_SURFACE_BGRA:
+		case amf::AMF_SURFACE_RGBA:
+		case amf::AMF_SURFACE_ARGB: {
+			size_t r, g, b;
+			switch (m_Format) {
+				case amf::AMF_SURFACE_BGRA:
+					r = 2, g = 1, b = 0;
+					break;
+				case amf::AMF_SURFACE_RGBA:
+					r = 0, g = 1, b = 2;
+					break;
+				default:
+					r = 1, g = 2, b = 3;
+					break;
+			}
+
+			for (amf_int32 row = 0; row < m_Height; row++) {
+				uint8_t* line = s + row * sPitch;
+				for (amf_int32 col = 0; col < m_Width; col++) {
+					uint8_t* px = line + col * 4;
+					int32_t  v  = m_Matrix[0][0] * px[r] + m_Matrix[0][1] * px[g] + m_Matrix[0][2] * px[b];
+					y[row * yPitch + col] = clamp_u8(((v + 0x8000) >> 16) + m_LumaOffset);
+				}
+			}
+			for (amf_int32 row = 0; row < ch; row++) {
+				uint8_t* top    = s + (row * 2) * sPitch;
+				uint8_t* bottom = s + ((row * 2 + 1 < m_Height) ? row * 2 + 1 : row * 2) * sPitch;
+				uint8_t* d      = uv + row * uvPitch;
+				for (amf_int32 col = 0; col < cw; col++) {
+					size_t  left = col * 2 * 4, right = ((col * 2 + 1 < m_Width) ? col * 2 + 1 : col * 2) * 4;
+					int32_t sr   = top[left + r] + top[right + r] + bottom[left + r] + bottom[right + r];
+					int32_t sg   = top[left + g] + top[right + g] + bottom[left + g] + bottom[right + g];
+					int32_t sb   = top[left + b] + top[right + b] + bottom[left + b] + bottom[right + b];
+					int32_t u    = m_Matrix[1][0] * sr + m_Matrix[1][1] * sg + m_Matrix[1][2] * sb;
+					int32_t v    = m_Matrix[2][0] * sr + m_Matrix[2][1] * sg + m_Matrix[2][2] * sb;
+					d[col * 2]     = clamp_u8(((u + 0x20000) >> 18) + 128);
+					d[col * 2 + 1] = clamp_u8(((v + 0x20000) >> 18) + 128);
+				}
+			}
+			break;
+		}
+		default:
+			return AMF_NOT_SUPPORTED;
+	}
+	return AMF_OK;
+}
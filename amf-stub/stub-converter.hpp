@@ -0,0 +1,63 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#include <array>
+#include <cinttypes>
+#include <mutex>
+#include "stub-component.hpp"
+
+#include <core/Surface.h>
+
+namespace AMFStub {
+	/// Color format converter producing NV12 host surfaces.
+	///
+	/// Accepts the formats OBS hands out (NV12, I420, YV12, YUY2, BGRA, RGBA, ARGB, GRAY8), RGB input is converted
+	/// with the matrix selected by the color profile. Scaling is not supported, the output always has the size
+	/// of the input.
+	class Converter : public Component {
+		public:
+		Converter(amf::AMFContext* context);
+		virtual ~Converter();
+
+		// AMFComponent
+		AMF_RESULT AMF_STD_CALL Init(amf::AMF_SURFACE_FORMAT format, amf_int32 width, amf_int32 height) override;
+		AMF_RESULT AMF_STD_CALL ReInit(amf_int32 width, amf_int32 height) override;
+		AMF_RESULT AMF_STD_CALL Terminate() override;
+		AMF_RESULT AMF_STD_CALL Drain() override;
+		AMF_RESULT AMF_STD_CALL Flush() override;
+		AMF_RESULT AMF_STD_CALL SubmitInput(amf::AMFData* pData) override;
+		AMF_RESULT AMF_STD_CALL QueryOutput(amf::AMFData** ppData) override;
+
+		private:
+		void       UpdateMatrix();
+		AMF_RESULT Convert(amf::AMFSurface* input, amf::AMFSurface* output);
+
+		std::mutex              m_Lock;
+		bool                    m_Initialized;
+		bool                    m_Draining;
+		amf::AMF_SURFACE_FORMAT m_Format;
+		amf_int32               m_Width, m_Height;
+		amf::AMFSurfacePtr      m_Output;
+
+		// RGB to YCbCr in 16.16 fixed point, rows are Y, Cb, Cr and columns R, G, B.
+		std::array<std::array<int32_t, 3>, 3> m_Matrix;
+		int32_t                               m_LumaOffset;
+	};
+} // namespace AMFStub
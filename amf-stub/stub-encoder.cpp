@@ -0,0 +1,830 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "stub-encoder.hpp"
+#include <cstdlib>
+#include <cstring>
+#include "stub-memory.hpp"
+
+#include <components/VideoEncoderHEVC.h>
+#include <components/VideoEncoderVCE.h>
+
+// Stand-in specific properties, defaults can be overridden through the environment.
+#define STUB_LATENCY L"StubLatency"        // amf_int64, microseconds between submitting and retrieving a frame.
+#define STUB_QUEUE_DEPTH L"StubQueueDepth" // amf_int64, frames accepted before SubmitInput returns AMF_INPUT_FULL.
+
+#define STUB_LATENCY_ENV "AMF_STUB_LATENCY_US"
+#define STUB_QUEUE_DEPTH_ENV "AMF_STUB_QUEUE_DEPTH"
+
+using namespace AMFStub;
+
+#pragma region Bitstream
+/// Writes RBSP syntax elements most significant bit first.
+class BitWriter {
+	public:
+	BitWriter() : m_Current(0), m_Count(0) {}
+
+	void Bit(uint32_t v)
+	{
+		m_Current = (uint8_t)((m_Current << 1) | (v & 1));
+		if (++m_Count == 8) {
+			m_Data.push_back(m_Current);
+			m_Current = 0;
+			m_Count   = 0;
+		}
+	}
+
+	void Bits(uint32_t v, size_t count)
+	{
+		while (count-- > 0)
+			Bit(v >> count);
+	}
+
+	void UE(uint32_t v)
+	{
+		uint64_t value = (uint64_t)v + 1;
+		size_t   size  = 0;
+		while ((value >> size) > 1)
+			size++;
+		Bits(0, size);
+		Bits((uint32_t)value, size + 1);
+	}
+
+	void SE(int32_t v)
+	{
+		UE((v <= 0) ? (uint32_t)(-2 * (int64_t)v) : (uint32_t)(2 * (int64_t)v - 1));
+	}
+
+	/// rbsp_trailing_bits() and byte_alignment() share the same layout.
+	void Trailing()
+	{
+		Bit(1);
+		while (m_Count != 0)
+			Bit(0);
+	}
+
+	const std::vector<uint8_t>& Data()
+	{
+		return m_Data;
+	}
+
+	private:
+	std::vector<uint8_t> m_Data;
+	uint8_t              m_Current;
+	size_t               m_Count;
+};
+
+/// Appends a NAL unit in Annex B format, with emulation prevention applied to the payload.
+static void emit_nal(std::vector<uint8_t>& out, std::initializer_list<uint8_t> header, const std::vector<uint8_t>& rbsp)
+{
+	out.insert(out.end(), {0x00, 0x00, 0x00, 0x01});
+	out.insert(out.end(), header);
+
+	size_t zeros = 0;
+	for (uint8_t v : rbsp) {
+		if ((zeros >= 2) && (v <= 0x03)) {
+			out.push_back(0x03);
+			zeros = 0;
+		}
+		out.push_back(v);
+		zeros = (v == 0x00) ? zeros + 1 : 0;
+	}
+}
+
+static void h265_profile_tier_level(BitWriter& bw, uint32_t tier, uint32_t level)
+{
+	bw.Bits(0, 2);          // general_profile_space
+	bw.Bit(tier);           // general_tier_flag
+	bw.Bits(1, 5);          // general_profile_idc, Main
+	bw.Bits(0x60000000, 32); // general_profile_compatibility_flag[1] and [2]
+	bw.Bit(1);              // general_progressive_source_flag
+	bw.Bit(0);              // general_interlaced_source_flag
+	bw.Bit(0);              // general_non_packed_constraint_flag
+	bw.Bit(1);              // general_frame_only_constraint_flag
+	bw.Bits(0, 32);         // general_reserved_zero_43bits and general_inbld_flag
+	bw.Bits(0, 12);
+	bw.Bits(level, 8); // general_level_idc
+}
+#pragma endregion Bitstream
+
+#pragma region Property Descriptions
+static const amf::AMFEnumDescriptionEntry h264_usage[] = {
+	{AMF_VIDEO_ENCODER_USAGE_TRANSCONDING, L"Transcoding"},
+	{AMF_VIDEO_ENCODER_USAGE_ULTRA_LOW_LATENCY, L"Ultra Low Latency"},
+	{AMF_VIDEO_ENCODER_USAGE_LOW_LATENCY, L"Low Latency"},
+	{AMF_VIDEO_ENCODER_USAGE_WEBCAM, L"Webcam"},
+	{0, nullptr},
+};
+static const amf::AMFEnumDescriptionEntry h264_quality_preset[] = {
+	{AMF_VIDEO_ENCODER_QUALITY_PRESET_BALANCED, L"Balanced"},
+	{AMF_VIDEO_ENCODER_QUALITY_PRESET_SPEED, L"Speed"},
+	{AMF_VIDEO_ENCODER_QUALITY_PRESET_QUALITY, L"Quality"},
+	{0, nullptr},
+};
+static const amf::AMFEnumDescriptionEntry h264_profile[] = {
+	{AMF_VIDEO_ENCODER_PROFILE_BASELINE, L"Baseline"},
+	{AMF_VIDEO_ENCODER_PROFILE_MAIN, L"Main"},
+	{AMF_VIDEO_ENCODER_PROFILE_HIGH, L"High"},
+	{AMF_VIDEO_ENCODER_PROFILE_CONSTRAINED_BASELINE, L"Constrained Baseline"},
+	{AMF_VIDEO_ENCODER_PROFILE_CONSTRAINED_HIGH, L"Constrained High"},
+	{0, nullptr},
+};
+static const amf::AMFEnumDescriptionEntry h264_profile_level[] = {
+	{10, L"1.0"}, {11, L"1.1"}, {12, L"1.2"}, {13, L"1.3"}, {20, L"2.0"}, {21, L"2.1"}, {22, L"2.2"},
+	{30, L"3.0"}, {31, L"3.1"}, {32, L"3.2"}, {40, L"4.0"}, {41, L"4.1"}, {42, L"4.2"}, {50, L"5.0"},
+	{51, L"5.1"}, {52, L"5.2"}, {60, L"6.0"}, {61, L"6.1"}, {62, L"6.2"}, {0, nullptr},
+};
+static const amf::AMFEnumDescriptionEntry h264_coding_type[] = {
+	{AMF_VIDEO_ENCODER_UNDEFINED, L"Automatic"},
+	{AMF_VIDEO_ENCODER_CABAC, L"CABAC"},
+	{AMF_VIDEO_ENCODER_CALV, L"CAVLC"},
+	{0, nullptr},
+};
+static const amf::AMFEnumDescriptionEntry h264_rate_control_method[] = {
+	{AMF_VIDEO_ENCODER_RATE_CONTROL_METHOD_CONSTANT_QP, L"Constant QP"},
+	{AMF_VIDEO_ENCODER_RATE_CONTROL_METHOD_CBR, L"Constant Bitrate"},
+	{AMF_VIDEO_ENCODER_RATE_CONTROL_METHOD_PEAK_CONSTRAINED_VBR, L"Peak Constrained VBR"},
+	{AMF_VIDEO_ENCODER_RATE_CONTROL_METHOD_LATENCY_CONSTRAINED_VBR, L"Latency Constrained VBR"},
+	{0, nullptr},
+};
+static const amf::AMFEnumDescriptionEntry h264_preencode_mode[] = {
+	{AMF_VIDEO_ENCODER_PREENCODE_DISABLED, L"Disabled"},
+	{AMF_VIDEO_ENCODER_PREENCODE_ENABLED, L"Enabled"},
+	{0, nullptr},
+};
+
+static const amf::AMFEnumDescriptionEntry h265_usage[] = {
+	{AMF_VIDEO_ENCODER_HEVC_USAGE_TRANSCONDING, L"Transcoding"},
+	{AMF_VIDEO_ENCODER_HEVC_USAGE_ULTRA_LOW_LATENCY, L"Ultra Low Latency"},
+	{AMF_VIDEO_ENCODER_HEVC_USAGE_LOW_LATENCY, L"Low Latency"},
+	{AMF_VIDEO_ENCODER_HEVC_USAGE_WEBCAM, L"Webcam"},
+	{0, nullptr},
+};
+static const amf::AMFEnumDescriptionEntry h265_quality_preset[] = {
+	{AMF_VIDEO_ENCODER_HEVC_QUALITY_PRESET_QUALITY, L"Quality"},
+	{AMF_VIDEO_ENCODER_HEVC_QUALITY_PRESET_BALANCED, L"Balanced"},
+	{AMF_VIDEO_ENCODER_HEVC_QUALITY_PRESET_SPEED, L"Speed"},
+	{0, nullptr},
+};
+static const amf::AMFEnumDescriptionEntry h265_profile[] = {
+	{AMF_VIDEO_ENCODER_HEVC_PROFILE_MAIN, L"Main"},
+	{0, nullptr},
+};
+static const amf::AMFEnumDescriptionEntry h265_profile_level[] = {
+	{AMF_LEVEL_1, L"1.0"},   {AMF_LEVEL_2, L"2.0"},   {AMF_LEVEL_2_1, L"2.1"}, {AMF_LEVEL_3, L"3.0"},
+	{AMF_LEVEL_3_1, L"3.1"}, {AMF_LEVEL_4, L"4.0"},   {AMF_LEVEL_4_1, L"4.1"}, {AMF_LEVEL_5, L"5.0"},
+	{AMF_LEVEL_5_1, L"5.1"}, {AMF_LEVEL_5_2, L"5.2"}, {AMF_LEVEL_6, L"6.0"},   {AMF_LEVEL_6_1, L"6.1"},
+	{AMF_LEVEL_6_2, L"6.2"}, {0, nullptr},
+};
+static const amf::AMFEnumDescriptionEntry h265_tier[] = {
+	{AMF_VIDEO_ENCODER_HEVC_TIER_MAIN, L"Main"},
+	{AMF_VIDEO_ENCODER_HEVC_TIER_HIGH, L"High"},
+	{0, nullptr},
+};
+static const amf::AMFEnumDescriptionEntry h265_rate_control_method[] = {
+	{AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_METHOD_CONSTANT_QP, L"Constant QP"},
+	{AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_METHOD_LATENCY_CONSTRAINED_VBR, L"Latency Constrained VBR"},
+	{AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_METHOD_PEAK_CONSTRAINED_VBR, L"Peak Constrained VBR"},
+	{AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_METHOD_CBR, L"Constant Bitrate"},
+	{0, nullptr},
+};
+static const amf::AMFEnumDescriptionEntry h265_gop_type[] = {
+	{0, L"Fixed"},
+	{1, L"Variable"},
+	{0, nullptr},
+};
+static const amf::AMFEnumDescriptionEntry h265_header_insertion_mode[] = {
+	{AMF_VIDEO_ENCODER_HEVC_HEADER_INSERTION_MODE_NONE, L"None"},
+	{AMF_VIDEO_ENCODER_HEVC_HEADER_INSERTION_MODE_GOP_ALIGNED, L"GOP Aligned"},
+	{AMF_VIDEO_ENCODER_HEVC_HEADER_INSERTION_MODE_IDR_ALIGNED, L"IDR Aligned"},
+	{0, nullptr},
+};
+#pragma endregion Property Descriptions
+
+static int64_t env_int(const char* name, int64_t fallback)
+{
+	const char* value = std::getenv(name);
+	if ((value == nullptr) || (*value == '\0'))
+		return fallback;
+	return std::strtoll(value, nullptr, 10);
+}
+
+AMFStub::Encoder::Encoder(amf::AMFContext* context, Codec codec) : Component(context)
+{
+	// Null Values
+	m_Codec       = codec;
+	m_Initialized = false;
+	m_Draining    = false;
+	m_Width       = 0;
+	m_Height      = 0;
+	m_SinceIDR    = UINT64_MAX;
+	m_IDRCount    = 0;
+
+	if (m_Codec == Codec::H264) {
+		DescribeH264();
+	} else {
+		DescribeH265();
+	}
+	AddInt(STUB_LATENCY, env_int(STUB_LATENCY_ENV, 0), 0, 10000000);
+	AddInt(STUB_QUEUE_DEPTH, env_int(STUB_QUEUE_DEPTH_ENV, 16), 1, 1024);
+	ResetProperties();
+}
+
+AMFStub::Encoder::~Encoder() {}
+
+void AMFStub::Encoder::DescribeH264()
+{
+	AddEnum(AMF_VIDEO_ENCODER_USAGE, AMF_VIDEO_ENCODER_USAGE_TRANSCONDING, h264_usage);
+	AddEnum(AMF_VIDEO_ENCODER_QUALITY_PRESET, AMF_VIDEO_ENCODER_QUALITY_PRESET_BALANCED, h264_quality_preset);
+	AddEnum(AMF_VIDEO_ENCODER_PROFILE, AMF_VIDEO_ENCODER_PROFILE_MAIN, h264_profile);
+	AddEnum(AMF_VIDEO_ENCODER_PROFILE_LEVEL, 42, h264_profile_level);
+	AddInt(AMF_VIDEO_ENCODER_MAX_NUM_REFRAMES, 1, 1, 16);
+	AddSize(AMF_VIDEO_ENCODER_FRAMESIZE, AMFConstructSize(1920, 1080), AMFConstructSize(32, 32),
+			AMFConstructSize(4096, 4096));
+	AddRate(AMF_VIDEO_ENCODER_FRAMERATE, AMFConstructRate(30, 1));
+	AddRatio(AMF_VIDEO_ENCODER_ASPECT_RATIO, AMFConstructRatio(1, 1));
+	AddBool(AMF_VIDEO_ENCODER_FULL_RANGE_COLOR, false);
+	AddBool(L"NominalRange", false);
+	AddEnum(AMF_VIDEO_ENCODER_CABAC_ENABLE, AMF_VIDEO_ENCODER_UNDEFINED, h264_coding_type);
+	AddInt(AMF_VIDEO_ENCODER_MAX_LTR_FRAMES, 0, 0, 2);
+	AddBool(AMF_VIDEO_ENCODER_LOWLATENCY_MODE, false);
+
+	// Rate Control
+	AddEnum(AMF_VIDEO_ENCODER_RATE_CONTROL_METHOD, AMF_VIDEO_ENCODER_RATE_CONTROL_METHOD_CBR,
+			h264_rate_control_method);
+	AddEnum(AMF_VIDEO_ENCODER_RATE_CONTROL_PREANALYSIS_ENABLE, AMF_VIDEO_ENCODER_PREENCODE_DISABLED,
+			h264_preencode_mode);
+	AddBool(AMF_VIDEO_ENCODER_RATE_CONTROL_SKIP_FRAME_ENABLE, false);
+	AddInt(AMF_VIDEO_ENCODER_MIN_QP, 18, 0, 51);
+	AddInt(AMF_VIDEO_ENCODER_MAX_QP, 51, 0, 51);
+	AddInt(AMF_VIDEO_ENCODER_QP_I, 22, 0, 51);
+	AddInt(AMF_VIDEO_ENCODER_QP_P, 22, 0, 51);
+	AddInt(AMF_VIDEO_ENCODER_QP_B, 22, 0, 51);
+	AddInt(AMF_VIDEO_ENCODER_TARGET_BITRATE, 20000000, 10000, 100000000);
+	AddInt(AMF_VIDEO_ENCODER_PEAK_BITRATE, 30000000, 10000, 100000000);
+	AddInt(AMF_VIDEO_ENCODER_VBV_BUFFER_SIZE, 20000000, 1000, 100000000);
+	AddInt(AMF_VIDEO_ENCODER_INITIAL_VBV_BUFFER_FULLNESS, 64, 0, 64);
+	AddInt(AMF_VIDEO_ENCODER_MAX_AU_SIZE, 0, 0, 100000000);
+	AddBool(AMF_VIDEO_ENCODER_ENFORCE_HRD, false);
+	AddBool(AMF_VIDEO_ENCODER_FILLER_DATA_ENABLE, false);
+	AddBool(AMF_VIDEO_ENCODER_ENABLE_VBAQ, false);
+	AddBool(AMF_VIDEO_ENCODER_HIGH_MOTION_QUALITY_BOOST_ENABLE, false);
+
+	// Picture Control
+	AddInt(AMF_VIDEO_ENCODER_B_PIC_DELTA_QP, 4, -10, 10);
+	AddInt(AMF_VIDEO_ENCODER_REF_B_PIC_DELTA_QP, 2, -10, 10);
+	AddInt(AMF_VIDEO_ENCODER_B_PIC_PATTERN, 0, 0, 3);
+	AddBool(AMF_VIDEO_ENCODER_B_REFERENCE_ENABLE, false);
+	AddBool(AMF_VIDEO_ENCODER_DE_BLOCKING_FILTER, true);
+	AddInt(AMF_VIDEO_ENCODER_IDR_PERIOD, 60, 0, 1000000);
+	AddInt(AMF_VIDEO_ENCODER_HEADER_INSERTION_SPACING, 0, 0, 1000);
+	AddInt(AMF_VIDEO_ENCODER_INTRA_REFRESH_NUM_MBS_PER_SLOT, 0, 0, 65535);
+	AddInt(L"IntraRefreshNumOfStripes", 0, 0, 65535);
+	AddInt(AMF_VIDEO_ENCODER_SLICES_PER_FRAME, 1, 1, 65535);
+	AddBool(AMF_VIDEO_ENCODER_MOTION_HALF_PIXEL, true);
+	AddBool(AMF_VIDEO_ENCODER_MOTION_QUARTERPIXEL, true);
+	AddBool(L"EnableGOPAlignment", true);
+
+	AddInterface(AMF_VIDEO_ENCODER_EXTRADATA);
+}
+
+void AMFStub::Encoder::DescribeH265()
+{
+	AddEnum(AMF_VIDEO_ENCODER_HEVC_USAGE, AMF_VIDEO_ENCODER_HEVC_USAGE_TRANSCONDING, h265_usage);
+	AddEnum(AMF_VIDEO_ENCODER_HEVC_QUALITY_PRESET, AMF_VIDEO_ENCODER_HEVC_QUALITY_PRESET_BALANCED,
+			h265_quality_preset);
+	AddEnum(AMF_VIDEO_ENCODER_HEVC_PROFILE, AMF_VIDEO_ENCODER_HEVC_PROFILE_MAIN, h265_profile);
+	AddEnum(AMF_VIDEO_ENCODER_HEVC_PROFILE_LEVEL, AMF_LEVEL_6_2, h265_profile_level);
+	AddEnum(AMF_VIDEO_ENCODER_HEVC_TIER, AMF_VIDEO_ENCODER_HEVC_TIER_MAIN, h265_tier);
+	AddInt(AMF_VIDEO_ENCODER_HEVC_MAX_NUM_REFRAMES, 1, 1, 16);
+	AddSize(AMF_VIDEO_ENCODER_HEVC_FRAMESIZE, AMFConstructSize(1920, 1080), AMFConstructSize(64, 64),
+			AMFConstructSize(4096, 2304));
+	AddRate(AMF_VIDEO_ENCODER_HEVC_FRAMERATE, AMFConstructRate(30, 1));
+	AddRatio(AMF_VIDEO_ENCODER_HEVC_ASPECT_RATIO, AMFConstructRatio(1, 1));
+	AddBool(L"NominalRange", false);
+	AddEnum(AMF_VIDEO_ENCODER_CABAC_ENABLE, AMF_VIDEO_ENCODER_UNDEFINED, h264_coding_type);
+	AddInt(AMF_VIDEO_ENCODER_HEVC_MAX_LTR_FRAMES, 0, 0, 2);
+	AddBool(AMF_VIDEO_ENCODER_HEVC_LOWLATENCY_MODE, false);
+
+	// Rate Control
+	AddEnum(AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_METHOD, AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_METHOD_CBR,
+			h265_rate_control_method);
+	AddBool(AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_PREANALYSIS_ENABLE, false);
+	AddBool(AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_SKIP_FRAME_ENABLE, false);
+	AddInt(AMF_VIDEO_ENCODER_HEVC_MIN_QP_I, 0, 0, 51);
+	AddInt(AMF_VIDEO_ENCODER_HEVC_MAX_QP_I, 51, 0, 51);
+	AddInt(AMF_VIDEO_ENCODER_HEVC_MIN_QP_P, 0, 0, 51);
+	AddInt(AMF_VIDEO_ENCODER_HEVC_MAX_QP_P, 51, 0, 51);
+	AddInt(AMF_VIDEO_ENCODER_HEVC_QP_I, 26, 0, 51);
+	AddInt(AMF_VIDEO_ENCODER_HEVC_QP_P, 26, 0, 51);
+	AddInt(AMF_VIDEO_ENCODER_HEVC_TARGET_BITRATE, 20000000, 10000, 100000000);
+	AddInt(AMF_VIDEO_ENCODER_HEVC_PEAK_BITRATE, 30000000, 10000, 100000000);
+	AddInt(AMF_VIDEO_ENCODER_HEVC_VBV_BUFFER_SIZE, 20000000, 1000, 100000000);
+	AddInt(AMF_VIDEO_ENCODER_HEVC_INITIAL_VBV_BUFFER_FULLNESS, 64, 0, 64);
+	AddInt(AMF_VIDEO_ENCODER_HEVC_MAX_AU_SIZE, 0, 0, 100000000);
+	AddBool(AMF_VIDEO_ENCODER_HEVC_ENFORCE_HRD, false);
+	AddBool(AMF_VIDEO_ENCODER_HEVC_FILLER_DATA_ENABLE, false);
+	AddBool(AMF_VIDEO_ENCODER_HEVC_ENABLE_VBAQ, false);
+	AddBool(AMF_VIDEO_ENCODER_HEVC_HIGH_MOTION_QUALITY_BOOST_ENABLE, false);
+	AddInt(L"HevcInputQueueSize", 16, 1, 32);
+
+	// Picture Control
+	AddEnum(L"GOPType", 0, h265_gop_type);
+	AddInt(L"GOPSizeMin", 0, 0, 1000);
+	AddInt(L"GOPSizeMax", 16, 0, 1000);
+	AddInt(AMF_VIDEO_ENCODER_HEVC_GOP_SIZE, 60, 0, 1000);
+	AddInt(AMF_VIDEO_ENCODER_HEVC_NUM_GOPS_PER_IDR, 1, 0, 65535);
+	AddEnum(AMF_VIDEO_ENCODER_HEVC_HEADER_INSERTION_MODE, AMF_VIDEO_ENCODER_HEVC_HEADER_INSERTION_MODE_NONE,
+			h265_header_insertion_mode);
+	AddBool(AMF_VIDEO_ENCODER_HEVC_DE_BLOCKING_FILTER_DISABLE, false);
+	AddInt(AMF_VIDEO_ENCODER_HEVC_SLICES_PER_FRAME, 1, 1, 65535);
+	AddBool(AMF_VIDEO_ENCODER_HEVC_MOTION_HALF_PIXEL, true);
+	AddBool(AMF_VIDEO_ENCODER_HEVC_MOTION_QUARTERPIXEL, true);
+	AddBool(L"EnableGOPAlignment", true);
+
+	AddInterface(AMF_VIDEO_ENCODER_HEVC_EXTRADATA);
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Encoder::Init(amf::AMF_SURFACE_FORMAT format, amf_int32 width, amf_int32 height)
+{
+	if ((format != amf::AMF_SURFACE_NV12) && (format != amf::AMF_SURFACE_YUV420P)
+		&& (format != amf::AMF_SURFACE_YUY2))
+		return AMF_NOT_SUPPORTED;
+
+	amf::AMFVariant size(AMFConstructSize(width, height));
+	const wchar_t* sizeName =
+		(m_Codec == Codec::H264) ? AMF_VIDEO_ENCODER_FRAMESIZE : AMF_VIDEO_ENCODER_HEVC_FRAMESIZE;
+	AMF_RESULT res = SetProperty(sizeName, size);
+	if (res != AMF_OK)
+		return res;
+
+	std::lock_guard<std::mutex> lock(m_Lock);
+	m_Width       = width;
+	m_Height      = height;
+	m_Initialized = true;
+	m_Draining    = false;
+	m_SinceIDR    = UINT64_MAX;
+	m_Queue.clear();
+
+	// Parameter sets never change after initialization, so the extra data can be built right away.
+	// Held by its own type, a release through AMFBuffer makes GCC speculate on the wrong object and warn.
+	std::vector<uint8_t>           headers = BuildParameterSets();
+	amf::AMFInterfacePtr_T<Buffer> buffer  = new Buffer(amf::AMF_MEMORY_HOST, headers.size(), nullptr, nullptr);
+	std::memcpy(buffer->GetNative(), headers.data(), headers.size());
+	StoreProperty((m_Codec == Codec::H264) ? AMF_VIDEO_ENCODER_EXTRADATA : AMF_VIDEO_ENCODER_HEVC_EXTRADATA,
+				  amf::AMFVariant(static_cast<amf::AMFInterface*>(buffer)));
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Encoder::ReInit(amf_int32 width, amf_int32 height)
+{
+	Terminate();
+	return Init(amf::AMF_SURFACE_NV12, width, height);
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Encoder::Terminate()
+{
+	std::lock_guard<std::mutex> lock(m_Lock);
+	m_Initialized = false;
+	m_Draining    = false;
+	m_Queue.clear();
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Encoder::Drain()
+{
+	std::lock_guard<std::mutex> lock(m_Lock);
+	if (!m_Initialized)
+		return AMF_NOT_INITIALIZED;
+	m_Draining = true;
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Encoder::Flush()
+{
+	std::lock_guard<std::mutex> lock(m_Lock);
+	m_Draining = false;
+	m_SinceIDR = UINT64_MAX;
+	m_Queue.clear();
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Encoder::SubmitInput(amf::AMFData* pData)
+{
+	if (pData == nullptr)
+		return AMF_INVALID_POINTER;
+
+	amf::AMFSurfacePtr surface(pData);
+	if (surface == nullptr)
+		return AMF_INVALID_DATA_TYPE;
+
+	int64_t force = AMF_VIDEO_ENCODER_PICTURE_TYPE_NONE;
+	if (pData->GetProperty(AMF_VIDEO_ENCODER_FORCE_PICTURE_TYPE, &force) != AMF_OK)
+		pData->GetProperty(AMF_VIDEO_ENCODER_HEVC_FORCE_PICTURE_TYPE, &force);
+
+	uint64_t idrPeriod;
+	if (m_Codec == Codec::H264) {
+		idrPeriod = (uint64_t)QueryInt(AMF_VIDEO_ENCODER_IDR_PERIOD, 0);
+	} else {
+		idrPeriod = (uint64_t)(QueryInt(AMF_VIDEO_ENCODER_HEVC_GOP_SIZE, 0)
+							   * QueryInt(AMF_VIDEO_ENCODER_HEVC_NUM_GOPS_PER_IDR, 1));
+	}
+	size_t depth   = (size_t)QueryInt(STUB_QUEUE_DEPTH, 16);
+	auto   latency = std::chrono::microseconds(QueryInt(STUB_LATENCY, 0));
+
+	std::lock_guard<std::mutex> lock(m_Lock);
+	if (!m_Initialized)
+		return AMF_NOT_INITIALIZED;
+	if (m_Draining)
+		return AMF_EOF;
+	if (m_Queue.size() >= depth)
+		return AMF_INPUT_FULL;
+
+	// Skip and B pictures are not produced, those frames are encoded as P pictures instead.
+	Frame frame;
+	if ((m_SinceIDR == UINT64_MAX) || (force == AMF_VIDEO_ENCODER_PICTURE_TYPE_IDR)
+		|| ((idrPeriod > 0) && (m_SinceIDR + 1 >= idrPeriod))) {
+		frame.type = PictureType::IDR;
+		m_SinceIDR = 0;
+		m_IDRCount++;
+	} else {
+		frame.type = (force == AMF_VIDEO_ENCODER_PICTURE_TYPE_I) ? PictureType::I : PictureType::P;
+		m_SinceIDR++;
+	}
+	frame.surface  = surface;
+	frame.sinceIDR = m_SinceIDR;
+	frame.idrId    = m_IDRCount;
+	frame.ready    = std::chrono::steady_clock::now() + latency;
+	m_Queue.push_back(frame);
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Encoder::QueryOutput(amf::AMFData** ppData)
+{
+	if (ppData == nullptr)
+		return AMF_INVALID_POINTER;
+	*ppData = nullptr;
+
+	Frame frame;
+	{
+		std::lock_guard<std::mutex> lock(m_Lock);
+		if (!m_Initialized)
+			return AMF_NOT_INITIALIZED;
+		if (m_Queue.empty())
+			return m_Draining ? AMF_EOF : AMF_REPEAT;
+		if (std::chrono::steady_clock::now() < m_Queue.front().ready)
+			return AMF_REPEAT;
+
+		frame = m_Queue.front();
+		m_Queue.pop_front();
+	}
+
+	std::vector<uint8_t> data;
+	if (frame.type == PictureType::IDR)
+		data = BuildParameterSets();
+	std::vector<uint8_t> slice = BuildSlice(frame, PayloadSize(frame.type));
+	data.insert(data.end(), slice.begin(), slice.end());
+
+	Buffer* buffer = new Buffer(amf::AMF_MEMORY_HOST, data.size(), nullptr, nullptr);
+	std::memcpy(buffer->GetNative(), data.data(), data.size());
+	frame.surface->AddTo(buffer, true, false);
+	buffer->SetPts(frame.surface->GetPts());
+	buffer->SetDuration(frame.surface->GetDuration());
+
+	// H264 and H265 share the numbering of IDR, I and P output.
+	int64_t outputType;
+	switch (frame.type) {
+		case PictureType::IDR:
+			outputType = AMF_VIDEO_ENCODER_OUTPUT_DATA_TYPE_IDR;
+			break;
+		case PictureType::I:
+			outputType = AMF_VIDEO_ENCODER_OUTPUT_DATA_TYPE_I;
+			break;
+		default:
+			outputType = AMF_VIDEO_ENCODER_OUTPUT_DATA_TYPE_P;
+			break;
+	}
+	buffer->SetProperty((m_Codec == Codec::H264) ? AMF_VIDEO_ENCODER_OUTPUT_DATA_TYPE
+												 : AMF_VIDEO_ENCODER_HEVC_OUTPUT_DATA_TYPE,
+						outputType);
+
+	*ppData = buffer;
+	buffer->Acquire();
+	return AMF_OK;
+}
+
+std::vector<uint8_t> AMFStub::Encoder::BuildParameterSets()
+{
+	std::vector<uint8_t> out;
+
+	if (m_Codec == Codec::H264) {
+		int64_t  profile = QueryInt(AMF_VIDEO_ENCODER_PROFILE, AMF_VIDEO_ENCODER_PROFILE_MAIN);
+		uint32_t level   = (uint32_t)QueryInt(AMF_VIDEO_ENCODER_PROFILE_LEVEL, 42);
+		uint32_t refs    = (uint32_t)QueryInt(AMF_VIDEO_ENCODER_MAX_NUM_REFRAMES, 1);
+		int64_t  coding  = QueryInt(AMF_VIDEO_ENCODER_CABAC_ENABLE, AMF_VIDEO_ENCODER_UNDEFINED);
+
+		uint32_t profileIdc, constraints;
+		switch (profile) {
+			case AMF_VIDEO_ENCODER_PROFILE_BASELINE:
+				profileIdc  = 66;
+				constraints = 0x40;
+				break;
+			case AMF_VIDEO_ENCODER_PROFILE_CONSTRAINED_BASELINE:
+				profileIdc  = 66;
+				constraints = 0xC0;
+				break;
+			case AMF_VIDEO_ENCODER_PROFILE_HIGH:
+				profileIdc  = 100;
+				constraints = 0x00;
+				break;
+			case AMF_VIDEO_ENCODER_PROFILE_CONSTRAINED_HIGH:
+				profileIdc  = 100;
+				constraints = 0x0C;
+				break;
+			default:
+				profileIdc  = 77;
+				constraints = 0x00;
+				break;
+		}
+		bool cabac = (profileIdc != 66) && (coding != AMF_VIDEO_ENCODER_CALV);
+
+		uint32_t mbWidth = (m_Width + 15) / 16, mbHeight = (m_Height + 15) / 16;
+
+		BitWriter sps;
+		sps.Bits(profileIdc, 8);
+		sps.Bits(constraints, 8);
+		sps.Bits(level, 8);
+		sps.UE(0); // seq_parameter_set_id
+		if (profileIdc == 100) {
+			sps.UE(1);  // chroma_format_idc, 4:2:0
+			sps.UE(0);  // bit_depth_luma_minus8
+			sps.UE(0);  // bit_depth_chroma_minus8
+			sps.Bit(0); // qpprime_y_zero_transform_bypass_flag
+			sps.Bit(0); // seq_scaling_matrix_present_flag
+		}
+		sps.UE(0);  // log2_max_frame_num_minus4
+		sps.UE(2);  // pic_order_cnt_type
+		sps.UE(refs);
+		sps.Bit(0); // gaps_in_frame_num_value_allowed_flag
+		sps.UE(mbWidth - 1);
+		sps.UE(mbHeight - 1);
+		sps.Bit(1); // frame_mbs_only_flag
+		sps.Bit(1); // direct_8x8_inference_flag
+		if ((mbWidth * 16 != (uint32_t)m_Width) || (mbHeight * 16 != (uint32_t)m_Height)) {
+			sps.Bit(1);
+			sps.UE(0);
+			sps.UE((mbWidth * 16 - m_Width) / 2);
+			sps.UE(0);
+			sps.UE((mbHeight * 16 - m_Height) / 2);
+		} else {
+			sps.Bit(0);
+		}
+		sps.Bit(0); // vui_parameters_present_flag
+		sps.Trailing();
+		emit_nal(out, {0x67}, sps.Data());
+
+		BitWriter pps;
+		pps.UE(0); // pic_parameter_set_id
+		pps.UE(0); // seq_parameter_set_id
+		pps.Bit(cabac ? 1 : 0);
+		pps.Bit(0);     // bottom_field_pic_order_in_frame_present_flag
+		pps.UE(0);      // num_slice_groups_minus1
+		pps.UE(0);      // num_ref_idx_l0_default_active_minus1
+		pps.UE(0);      // num_ref_idx_l1_default_active_minus1
+		pps.Bit(0);     // weighted_pred_flag
+		pps.Bits(0, 2); // weighted_bipred_idc
+		pps.SE(0);      // pic_init_qp_minus26
+		pps.SE(0);      // pic_init_qs_minus26
+		pps.SE(0);      // chroma_qp_index_offset
+		pps.Bit(1);     // deblocking_filter_control_present_flag
+		pps.Bit(0);     // constrained_intra_pred_flag
+		pps.Bit(0);     // redundant_pic_cnt_present_flag
+		pps.Trailing();
+		emit_nal(out, {0x68}, pps.Data());
+	} else {
+		uint32_t tier  = (uint32_t)QueryInt(AMF_VIDEO_ENCODER_HEVC_TIER, AMF_VIDEO_ENCODER_HEVC_TIER_MAIN);
+		uint32_t level = (uint32_t)QueryInt(AMF_VIDEO_ENCODER_HEVC_PROFILE_LEVEL, AMF_LEVEL_6_2);
+		uint32_t refs  = (uint32_t)QueryInt(AMF_VIDEO_ENCODER_HEVC_MAX_NUM_REFRAMES, 1);
+
+		// Coded size is a multiple of the minimum coding block size of 8.
+		uint32_t codedWidth = (m_Width + 7) & ~7, codedHeight = (m_Height + 7) & ~7;
+
+		BitWriter vps;
+		vps.Bits(0, 4);      // vps_video_parameter_set_id
+		vps.Bit(1);          // vps_base_layer_internal_flag
+		vps.Bit(1);          // vps_base_layer_available_flag
+		vps.Bits(0, 6);      // vps_max_layers_minus1
+		vps.Bits(0, 3);      // vps_max_sub_layers_minus1
+		vps.Bit(1);          // vps_temporal_id_nesting_flag
+		vps.Bits(0xFFFF, 16); // vps_reserved_0xffff_16bits
+		h265_profile_tier_level(vps, tier, level);
+		vps.Bit(1); // vps_sub_layer_ordering_info_present_flag
+		vps.UE(refs);
+		vps.UE(0);      // vps_max_num_reorder_pics
+		vps.UE(0);      // vps_max_latency_increase_plus1
+		vps.Bits(0, 6); // vps_max_layer_id
+		vps.UE(0);      // vps_num_layer_sets_minus1
+		vps.Bit(0);     // vps_timing_info_present_flag
+		vps.Bit(0);     // vps_extension_flag
+		vps.Trailing();
+		emit_nal(out, {32 << 1, 1}, vps.Data());
+
+		BitWriter sps;
+		sps.Bits(0, 4); // sps_video_parameter_set_id
+		sps.Bits(0, 3); // sps_max_sub_layers_minus1
+		sps.Bit(1);     // sps_temporal_id_nesting_flag
+		h265_profile_tier_level(sps, tier, level);
+		sps.UE(0); // sps_seq_parameter_set_id
+		sps.UE(1); // chroma_format_idc, 4:2:0
+		sps.UE(codedWidth);
+		sps.UE(codedHeight);
+		if ((codedWidth != (uint32_t)m_Width) || (codedHeight != (uint32_t)m_Height)) {
+			sps.Bit(1);
+			sps.UE(0);
+			sps.UE((codedWidth - m_Width) / 2);
+			sps.UE(0);
+			sps.UE((codedHeight - m_Height) / 2);
+		} else {
+			sps.Bit(0);
+		}
+		sps.UE(0);  // bit_depth_luma_minus8
+		sps.UE(0);  // bit_depth_chroma_minus8
+		sps.UE(4);  // log2_max_pic_order_cnt_lsb_minus4
+		sps.Bit(1); // sps_sub_layer_ordering_info_present_flag
+		sps.UE(refs);
+		sps.UE(0);  // sps_max_num_reorder_pics
+		sps.UE(0);  // sps_max_latency_increase_plus1
+		sps.UE(0);  // log2_min_luma_coding_block_size_minus3
+		sps.UE(3);  // log2_diff_max_min_luma_coding_block_size
+		sps.UE(0);  // log2_min_luma_transform_block_size_minus2
+		sps.UE(3);  // log2_diff_max_min_luma_transform_block_size
+		sps.UE(0);  // max_transform_hierarchy_depth_inter
+		sps.UE(0);  // max_transform_hierarchy_depth_intra
+		sps.Bit(0); // scaling_list_enabled_flag
+		sps.Bit(0); // amp_enabled_flag
+		sps.Bit(0); // sample_adaptive_offset_enabled_flag
+		sps.Bit(0); // pcm_enabled_flag
+		sps.UE(1);  // num_short_term_ref_pic_sets
+		sps.UE(1);  // num_negative_pics
+		sps.UE(0);  // num_positive_pics
+		sps.UE(0);  // delta_poc_s0_minus1
+		sps.Bit(1); // used_by_curr_pic_s0_flag
+		sps.Bit(0); // long_term_ref_pics_present_flag
+		sps.Bit(0); // sps_temporal_mvp_enabled_flag
+		sps.Bit(0); // strong_intra_smoothing_enabled_flag
+		sps.Bit(0); // vui_parameters_present_flag
+		sps.Bit(0); // sps_extension_present_flag
+		sps.Trailing();
+		emit_nal(out, {33 << 1, 1}, sps.Data());
+
+		BitWriter pps;
+		pps.UE(0);      // pps_pic_parameter_set_id
+		pps.UE(0);      // pps_seq_parameter_set_id
+		pps.Bit(0);     // dependent_slice_segments_enabled_flag
+		pps.Bit(0);     // output_flag_present_flag
+		pps.Bits(0, 3); // num_extra_slice_header_bits
+		pps.Bit(0);     // sign_data_hiding_enabled_flag
+		pps.Bit(0);     // cabac_init_present_flag
+		pps.UE(0);      // num_ref_idx_l0_default_active_minus1
+		pps.UE(0);      // num_ref_idx_l1_default_active_minus1
+		pps.SE(0);      // init_qp_minus26
+		pps.Bit(0);     // constrained_intra_pred_flag
+		pps.Bit(0);     // transform_skip_enabled_flag
+		pps.Bit(0);     // cu_qp_delta_enabled_flag
+		pps.SE(0);      // pps_cb_qp_offset
+		pps.SE(0);      // pps_cr_qp_offset
+		pps.Bit(0);     // pps_slice_chroma_qp_offsets_present_flag
+		pps.Bit(0);     // weighted_pred_flag
+		pps.Bit(0);     // weighted_bipred_flag
+		pps.Bit(0);     // transquant_bypass_enabled_flag
+		pps.Bit(0);     // tiles_enabled_flag
+		pps.Bit(0);     // entropy_coding_sync_enabled_flag
+		pps.Bit(0);     // pps_loop_filter_across_slices_enabled_flag
+		pps.Bit(1);     // deblocking_filter_control_present_flag
+		pps.Bit(0);     // deblocking_filter_override_enabled_flag
+		pps.Bit(1);     // pps_deblocking_filter_disabled_flag
+		pps.Bit(0);     // pps_scaling_list_data_present_flag
+		pps.Bit(0);     // lists_modification_present_flag
+		pps.UE(0);      // log2_parallel_merge_level_minus2
+		pps.Bit(0);     // slice_segment_header_extension_present_flag
+		pps.Bit(0);     // pps_extension_present_flag
+		pps.Trailing();
+		emit_nal(out, {34 << 1, 1}, pps.Data());
+	}
+	return out;
+}
+
+std::vector<uint8_t> AMFStub::Encoder::BuildSlice(const Frame& frame, size_t payload)
+{
+	std::vector<uint8_t> out;
+	bool                 intra = (frame.type != PictureType::P);
+
+	BitWriter slice;
+	if (m_Codec == Codec::H264) {
+		int64_t profile = QueryInt(AMF_VIDEO_ENCODER_PROFILE, AMF_VIDEO_ENCODER_PROFILE_MAIN);
+		int64_t coding  = QueryInt(AMF_VIDEO_ENCODER_CABAC_ENABLE, AMF_VIDEO_ENCODER_UNDEFINED);
+		bool    cabac   = (profile != AMF_VIDEO_ENCODER_PROFILE_BASELINE)
+					 && (profile != AMF_VIDEO_ENCODER_PROFILE_CONSTRAINED_BASELINE)
+					 && (coding != AMF_VIDEO_ENCODER_CALV);
+
+		slice.UE(0);             // first_mb_in_slice
+		slice.UE(intra ? 7 : 5); // slice_type, same type for the whole picture
+		slice.UE(0);             // pic_parameter_set_id
+		slice.Bits((uint32_t)(frame.sinceIDR & 0xF), 4); // frame_num
+		if (frame.type == PictureType::IDR)
+			slice.UE(frame.idrId & 0xFFFF); // idr_pic_id
+		if (!intra) {
+			slice.Bit(0); // num_ref_idx_active_override_flag
+			slice.Bit(0); // ref_pic_list_modification_flag_l0
+		}
+		if (frame.type == PictureType::IDR) {
+			slice.Bit(0); // no_output_of_prior_pics_flag
+			slice.Bit(0); // long_term_reference_flag
+		} else {
+			slice.Bit(0); // adaptive_ref_pic_marking_mode_flag
+		}
+		if (cabac && !intra)
+			slice.UE(0); // cabac_init_idc
+		slice.SE(0);     // slice_qp_delta
+		slice.UE(1);     // disable_deblocking_filter_idc
+	} else {
+		slice.Bit(1); // first_slice_segment_in_pic_flag
+		if (frame.type == PictureType::IDR)
+			slice.Bit(0);        // no_output_of_prior_pics_flag
+		slice.UE(0);             // slice_pic_parameter_set_id
+		slice.UE(intra ? 2 : 1); // slice_type
+		if (frame.type != PictureType::IDR) {
+			slice.Bits((uint32_t)(frame.sinceIDR & 0xFF), 8); // slice_pic_order_cnt_lsb
+			slice.Bit(1);                                    // short_term_ref_pic_set_sps_flag
+		}
+		if (!intra) {
+			slice.Bit(0); // num_ref_idx_active_override_flag
+			slice.UE(0);  // five_minus_max_num_merge_cand
+		}
+		slice.SE(0); // slice_qp_delta
+		slice.Trailing(); // byte_alignment()
+	}
+
+	// Filler in place of the slice data.
+	for (size_t idx = 0; idx < payload; idx++)
+		slice.Bits(0xAA, 8);
+	slice.Trailing();
+
+	if (m_Codec == Codec::H264) {
+		uint8_t header;
+		switch (frame.type) {
+			case PictureType::IDR:
+				header = 0x65;
+				break;
+			case PictureType::I:
+				header = 0x61;
+				break;
+			default:
+				header = 0x41;
+				break;
+		}
+		emit_nal(out, {header}, slice.Data());
+	} else {
+		uint8_t type = (frame.type == PictureType::IDR) ? 19 : 1; // IDR_W_RADL, TRAIL_R
+		emit_nal(out, {(uint8_t)(type << 1), 1}, slice.Data());
+	}
+	return out;
+}
+
+size_t AMFStub::Encoder::PayloadSize(PictureType type)
+{
+	int64_t         bitrate;
+	amf::AMFVariant rate;
+	if (m_Codec == Codec::H264) {
+		bitrate = QueryInt(AMF_VIDEO_ENCODER_TARGET_BITRATE, 20000000);
+		GetProperty(AMF_VIDEO_ENCODER_FRAMERATE, &rate);
+	} else {
+		bitrate = QueryInt(AMF_VIDEO_ENCODER_HEVC_TARGET_BITRATE, 20000000);
+		GetProperty(AMF_VIDEO_ENCODER_HEVC_FRAMERATE, &rate);
+	}
+
+	AMFRate fps = (rate.type == amf::AMF_VARIANT_RATE) ? rate.ToRate() : AMFConstructRate(30, 1);
+	if ((fps.num == 0) || (fps.den == 0))
+		fps = AMFConstructRate(30, 1);
+
+	size_t size = (size_t)(bitrate / 8 * fps.den / fps.num);
+	if (type != PictureType::P)
+		size *= 4;
+	return (size > 16) ? size : 16;
+}
@@ -0,0 +1,87 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#include <chrono>
+#include <cinttypes>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include "stub-component.hpp"
+
+#include <core/Surface.h>
+
+namespace AMFStub {
+	enum class Codec : uint8_t {
+		H264,
+		H265,
+	};
+
+	/// Video encoder producing syntactically valid parameter sets and slice headers around filler payloads.
+	///
+	/// Picture type decisions, parameter sets and the output properties follow the hardware encoder closely
+	/// enough for the plugin to run end to end, but the pixels are never looked at. Every frame is held back for
+	/// the configured latency before it can be queried, and the input queue rejects frames once it is full.
+	class Encoder : public Component {
+		public:
+		Encoder(amf::AMFContext* context, Codec codec);
+		virtual ~Encoder();
+
+		// AMFComponent
+		AMF_RESULT AMF_STD_CALL Init(amf::AMF_SURFACE_FORMAT format, amf_int32 width, amf_int32 height) override;
+		AMF_RESULT AMF_STD_CALL ReInit(amf_int32 width, amf_int32 height) override;
+		AMF_RESULT AMF_STD_CALL Terminate() override;
+		AMF_RESULT AMF_STD_CALL Drain() override;
+		AMF_RESULT AMF_STD_CALL Flush() override;
+		AMF_RESULT AMF_STD_CALL SubmitInput(amf::AMFData* pData) override;
+		AMF_RESULT AMF_STD_CALL QueryOutput(amf::AMFData** ppData) override;
+
+		private:
+		enum class PictureType : uint8_t {
+			IDR,
+			I,
+			P,
+		};
+
+		struct Frame {
+			amf::AMFSurfacePtr                    surface;
+			PictureType                           type;
+			uint64_t                              sinceIDR;
+			uint32_t                              idrId;
+			std::chrono::steady_clock::time_point ready;
+		};
+
+		void DescribeH264();
+		void DescribeH265();
+
+		std::vector<uint8_t> BuildParameterSets();
+		std::vector<uint8_t> BuildSlice(const Frame& frame, size_t payload);
+		size_t               PayloadSize(PictureType type);
+
+		Codec m_Codec;
+
+		std::mutex        m_Lock;
+		bool              m_Initialized;
+		bool              m_Draining;
+		amf_int32         m_Width, m_Height;
+		std::deque<Frame> m_Queue;
+		uint64_t          m_SinceIDR; // Frames since the last IDR frame, UINT64_MAX before the first one.
+		uint32_t          m_IDRCount;
+	};
+} // namespace AMFStub
@@ -0,0 +1,765 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "stub-memory.hpp"
+#include <cstring>
+
+using namespace AMFStub;
+
+#pragma region Plane
+AMFStub::Plane::Plane(amf::AMF_PLANE_TYPE type, uint8_t* data, amf_int32 pixelSize, amf_int32 width, amf_int32 height,
+					  amf_int32 hPitch, amf_int32 vPitch)
+	: m_Type(type), m_Data(data), m_PixelSize(pixelSize), m_Width(width), m_Height(height), m_HPitch(hPitch),
+	  m_VPitch(vPitch)
+{}
+
+AMFStub::Plane::~Plane() {}
+
+amf::AMF_PLANE_TYPE AMF_STD_CALL AMFStub::Plane::GetType()
+{
+	return m_Type;
+}
+
+void* AMF_STD_CALL AMFStub::Plane::GetNative()
+{
+	return m_Data;
+}
+
+amf_int32 AMF_STD_CALL AMFStub::Plane::GetPixelSizeInBytes()
+{
+	return m_PixelSize;
+}
+
+amf_int32 AMF_STD_CALL AMFStub::Plane::GetOffsetX()
+{
+	return 0;
+}
+
+amf_int32 AMF_STD_CALL AMFStub::Plane::GetOffsetY()
+{
+	return 0;
+}
+
+amf_int32 AMF_STD_CALL AMFStub::Plane::GetWidth()
+{
+	return m_Width;
+}
+
+amf_int32 AMF_STD_CALL AMFStub::Plane::GetHeight()
+{
+	return m_Height;
+}
+
+amf_int32 AMF_STD_CALL AMFStub::Plane::GetHPitch()
+{
+	return m_HPitch;
+}
+
+amf_int32 AMF_STD_CALL AMFStub::Plane::GetVPitch()
+{
+	return m_VPitch;
+}
+
+bool AMF_STD_CALL AMFStub::Plane::IsTiled()
+{
+	return false;
+}
+#pragma endregion Plane
+
+#pragma region Surface
+AMFStub::Surface::Surface(amf::AMF_MEMORY_TYPE memoryType, amf::AMF_SURFACE_FORMAT format, amf_int32 width,
+						  amf_int32 height, amf_int32 hPitch, amf_int32 vPitch, uint8_t* external,
+						  amf::AMFSurfaceObserver* observer)
+	: m_MemoryType(memoryType), m_Format(format), m_Width(width), m_Height(height), m_HPitch(hPitch),
+	  m_VPitch(vPitch), m_FrameType(amf::AMF_FRAME_PROGRESSIVE), m_Pts(0), m_Duration(0)
+{
+	uint8_t* base = external;
+	if (base == nullptr) {
+		size_t size = 0;
+		CalculateLayout(format, width, height, m_HPitch, m_VPitch, size);
+		m_Storage = std::unique_ptr<uint8_t[]>(new uint8_t[size]);
+		base      = m_Storage.get();
+	}
+	if (observer)
+		m_Observers.push_back(observer);
+	CreatePlanes(base);
+}
+
+AMFStub::Surface::~Surface()
+{
+	NotifyObservers();
+}
+
+void AMFStub::Surface::CreatePlanes(uint8_t* base)
+{
+	m_Planes.clear();
+	amf_int32 planeSize = m_HPitch * m_VPitch;
+	switch (m_Format) {
+		case amf::AMF_SURFACE_NV12:
+			m_Planes.push_back(new Plane(amf::AMF_PLANE_Y, base, 1, m_Width, m_Height, m_HPitch, m_VPitch));
+			m_Planes.push_back(new Plane(amf::AMF_PLANE_UV, base + planeSize, 2, m_Width / 2, m_Height / 2, m_HPitch,
+										 m_VPitch / 2));
+			break;
+		case amf::AMF_SURFACE_YUV420P:
+		case amf::AMF_SURFACE_YV12: {
+			uint8_t* first  = base + planeSize;
+			uint8_t* second = first + (m_HPitch / 2) * (m_VPitch / 2);
+			m_Planes.push_back(new Plane(amf::AMF_PLANE_Y, base, 1, m_Width, m_Height, m_HPitch, m_VPitch));
+			if (m_Format == amf::AMF_SURFACE_YUV420P) {
+				m_Planes.push_back(
+					new Plane(amf::AMF_PLANE_U, first, 1, m_Width / 2, m_Height / 2, m_HPitch / 2, m_VPitch / 2));
+				m_Planes.push_back(
+					new Plane(amf::AMF_PLANE_V, second, 1, m_Width / 2, m_Height / 2, m_HPitch / 2, m_VPitch / 2));
+			} else {
+				m_Planes.push_back(
+					new Plane(amf::AMF_PLANE_V, first, 1, m_Width / 2, m_Height / 2, m_HPitch / 2, m_VPitch / 2));
+				m_Planes.push_back(
+					new Plane(amf::AMF_PLANE_U, second, 1, m_Width / 2, m_Height / 2, m_HPitch / 2, m_VPitch / 2));
+			}
+			break;
+		}
+		case amf::AMF_SURFACE_YUY2:
+			m_Planes.push_back(new Plane(amf::AMF_PLANE_PACKED, base, 2, m_Width, m_Height, m_HPitch, m_VPitch));
+			break;
+		case amf::AMF_SURFACE_BGRA:
+		case amf::AMF_SURFACE_RGBA:
+		case amf::AMF_SURFACE_ARGB:
+			m_Planes.push_back(new Plane(amf::AMF_PLANE_PACKED, base, 4, m_Width, m_Height, m_HPitch, m_VPitch));
+			break;
+		case amf::AMF_SURFACE_GRAY8:
+			m_Planes.push_back(new Plane(amf::AMF_PLANE_Y, base, 1, m_Width, m_Height, m_HPitch, m_VPitch));
+			break;
+		default:
+			break;
+	}
+}
+
+void AMFStub::Surface::NotifyObservers()
+{
+	std::vector<amf::AMFSurfaceObserver*> observers;
+	{
+		std::lock_guard<std::mutex> lock(m_ObserverLock);
+		observers.swap(m_Observers);
+	}
+	for (amf::AMFSurfaceObserver* observer : observers)
+		observer->OnSurfaceDataRelease(this);
+}
+
+bool AMFStub::Surface::CalculateLayout(amf::AMF_SURFACE_FORMAT format, amf_int32 width, amf_int32 height,
+									   amf_int32& hPitch, amf_int32& vPitch, size_t& size)
+{
+	vPitch = (height + 1) & ~1;
+	switch (format) {
+		case amf::AMF_SURFACE_NV12:
+		case amf::AMF_SURFACE_YUV420P:
+		case amf::AMF_SURFACE_YV12:
+			hPitch = (width + 1) & ~1;
+			size   = (size_t)hPitch * vPitch * 3 / 2;
+			return true;
+		case amf::AMF_SURFACE_YUY2:
+			hPitch = width * 2;
+			break;
+		case amf::AMF_SURFACE_BGRA:
+		case amf::AMF_SURFACE_RGBA:
+		case amf::AMF_SURFACE_ARGB:
+			hPitch = width * 4;
+			break;
+		case amf::AMF_SURFACE_GRAY8:
+			hPitch = width;
+			break;
+		default:
+			hPitch = 0;
+			size   = 0;
+			return false;
+	}
+	size = (size_t)hPitch * vPitch;
+	return true;
+}
+
+bool AMFStub::Surface::IsHostCompatible(amf::AMF_MEMORY_TYPE type)
+{
+	switch (type) {
+		case amf::AMF_MEMORY_UNKNOWN:
+		case amf::AMF_MEMORY_HOST:
+		case amf::AMF_MEMORY_DX9:
+		case amf::AMF_MEMORY_DX11:
+			return true;
+		default:
+			return false;
+	}
+}
+
+amf::AMF_MEMORY_TYPE AMF_STD_CALL AMFStub::Surface::GetMemoryType()
+{
+	return m_MemoryType;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Surface::Duplicate(amf::AMF_MEMORY_TYPE type, amf::AMFData** ppData)
+{
+	if (ppData == nullptr)
+		return AMF_INVALID_POINTER;
+	if (!IsHostCompatible(type))
+		return AMF_NOT_SUPPORTED;
+
+	Surface* copy = new Surface(type == amf::AMF_MEMORY_UNKNOWN ? m_MemoryType : type, m_Format, m_Width, m_Height,
+								0, 0, nullptr, nullptr);
+	for (size_t idx = 0; idx < m_Planes.size(); idx++) {
+		amf::AMFPlane* src = m_Planes[idx];
+		amf::AMFPlane* dst = copy->m_Planes[idx];
+		size_t         row = (size_t)src->GetWidth() * src->GetPixelSizeInBytes();
+		for (amf_int32 y = 0; y < src->GetHeight(); y++) {
+			std::memcpy(static_cast<uint8_t*>(dst->GetNative()) + (size_t)y * dst->GetHPitch(),
+						static_cast<uint8_t*>(src->GetNative()) + (size_t)y * src->GetHPitch(), row);
+		}
+	}
+	copy->m_FrameType = m_FrameType;
+	copy->m_Pts       = m_Pts;
+	copy->m_Duration  = m_Duration;
+	AddTo(copy, true, true);
+
+	*ppData = copy;
+	copy->Acquire();
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Surface::Convert(amf::AMF_MEMORY_TYPE type)
+{
+	if (!IsHostCompatible(type))
+		return AMF_NOT_SUPPORTED;
+
+	// Supplied memory is copied on the way to the "GPU", after which the caller may reuse it.
+	if (!m_Storage && !m_Planes.empty() && ((type == amf::AMF_MEMORY_DX9) || (type == amf::AMF_MEMORY_DX11))) {
+		size_t size = (size_t)m_HPitch * m_VPitch;
+		if ((m_Format == amf::AMF_SURFACE_NV12) || (m_Format == amf::AMF_SURFACE_YUV420P)
+			|| (m_Format == amf::AMF_SURFACE_YV12))
+			size = size * 3 / 2;
+		m_Storage = std::unique_ptr<uint8_t[]>(new uint8_t[size]);
+		std::memcpy(m_Storage.get(), m_Planes[0]->GetNative(), size);
+		CreatePlanes(m_Storage.get());
+		NotifyObservers();
+	}
+	if (type != amf::AMF_MEMORY_UNKNOWN)
+		m_MemoryType = type;
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Surface::Interop(amf::AMF_MEMORY_TYPE type)
+{
+	return Convert(type);
+}
+
+amf::AMF_DATA_TYPE AMF_STD_CALL AMFStub::Surface::GetDataType()
+{
+	return amf::AMF_DATA_SURFACE;
+}
+
+amf_bool AMF_STD_CALL AMFStub::Surface::IsReusable()
+{
+	return true;
+}
+
+void AMF_STD_CALL AMFStub::Surface::SetPts(amf_pts pts)
+{
+	m_Pts = pts;
+}
+
+amf_pts AMF_STD_CALL AMFStub::Surface::GetPts()
+{
+	return m_Pts;
+}
+
+void AMF_STD_CALL AMFStub::Surface::SetDuration(amf_pts duration)
+{
+	m_Duration = duration;
+}
+
+amf_pts AMF_STD_CALL AMFStub::Surface::GetDuration()
+{
+	return m_Duration;
+}
+
+amf::AMF_SURFACE_FORMAT AMF_STD_CALL AMFStub::Surface::GetFormat()
+{
+	return m_Format;
+}
+
+amf_size AMF_STD_CALL AMFStub::Surface::GetPlanesCount()
+{
+	return m_Planes.size();
+}
+
+amf::AMFPlane* AMF_STD_CALL AMFStub::Surface::GetPlaneAt(amf_size index)
+{
+	if (index >= m_Planes.size())
+		return nullptr;
+	return m_Planes[index];
+}
+
+amf::AMFPlane* AMF_STD_CALL AMFStub::Surface::GetPlane(amf::AMF_PLANE_TYPE type)
+{
+	for (amf::AMFPlanePtr& plane : m_Planes) {
+		if (plane->GetType() == type)
+			return plane;
+	}
+	return nullptr;
+}
+
+amf::AMF_FRAME_TYPE AMF_STD_CALL AMFStub::Surface::GetFrameType()
+{
+	return m_FrameType;
+}
+
+void AMF_STD_CALL AMFStub::Surface::SetFrameType(amf::AMF_FRAME_TYPE type)
+{
+	m_FrameType = type;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Surface::SetCrop(amf_int32 x, amf_int32 y, amf_int32 width, amf_int32 height)
+{
+	if ((x != 0) || (y != 0) || (width != m_Width) || (height != m_Height))
+		return AMF_NOT_SUPPORTED;
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Surface::CopySurfaceRegion(amf::AMFSurface*, amf_int32, amf_int32, amf_int32,
+															amf_int32, amf_int32, amf_int32)
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+void AMF_STD_CALL AMFStub::Surface::AddObserver(amf::AMFSurfaceObserver* pObserver)
+{
+	std::lock_guard<std::mutex> lock(m_ObserverLock);
+	m_Observers.push_back(pObserver);
+}
+
+void AMF_STD_CALL AMFStub::Surface::RemoveObserver(amf::AMFSurfaceObserver* pObserver)
+{
+	std::lock_guard<std::mutex> lock(m_ObserverLock);
+	for (auto it = m_Observers.begin(); it != m_Observers.end(); it++) {
+		if (*it == pObserver) {
+			m_Observers.erase(it);
+			break;
+		}
+	}
+}
+#pragma endregion Surface
+
+#pragma region Buffer
+AMFStub::Buffer::Buffer(amf::AMF_MEMORY_TYPE memoryType, amf_size size, uint8_t* external,
+						amf::AMFBufferObserver* observer)
+	: m_MemoryType(memoryType), m_Pts(0), m_Duration(0), m_External(external), m_Size(size)
+{
+	if (m_External == nullptr)
+		m_Storage.resize(size);
+	if (observer)
+		m_Observers.push_back(observer);
+}
+
+AMFStub::Buffer::~Buffer()
+{
+	std::vector<amf::AMFBufferObserver*> observers;
+	{
+		std::lock_guard<std::mutex> lock(m_ObserverLock);
+		observers.swap(m_Observers);
+	}
+	for (amf::AMFBufferObserver* observer : observers)
+		observer->OnBufferDataRelease(this);
+}
+
+amf::AMF_MEMORY_TYPE AMF_STD_CALL AMFStub::Buffer::GetMemoryType()
+{
+	return m_MemoryType;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Buffer::Duplicate(amf::AMF_MEMORY_TYPE type, amf::AMFData** ppData)
+{
+	if (ppData == nullptr)
+		return AMF_INVALID_POINTER;
+	if ((type != amf::AMF_MEMORY_HOST) && (type != amf::AMF_MEMORY_UNKNOWN))
+		return AMF_NOT_SUPPORTED;
+
+	Buffer* copy = new Buffer(amf::AMF_MEMORY_HOST, m_Size, nullptr, nullptr);
+	std::memcpy(copy->GetNative(), GetNative(), m_Size);
+	copy->m_Pts      = m_Pts;
+	copy->m_Duration = m_Duration;
+	AddTo(copy, true, true);
+
+	*ppData = copy;
+	copy->Acquire();
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Buffer::Convert(amf::AMF_MEMORY_TYPE type)
+{
+	if ((type != amf::AMF_MEMORY_HOST) && (type != amf::AMF_MEMORY_UNKNOWN))
+		return AMF_NOT_SUPPORTED;
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Buffer::Interop(amf::AMF_MEMORY_TYPE type)
+{
+	return Convert(type);
+}
+
+amf::AMF_DATA_TYPE AMF_STD_CALL AMFStub::Buffer::GetDataType()
+{
+	return amf::AMF_DATA_BUFFER;
+}
+
+amf_bool AMF_STD_CALL AMFStub::Buffer::IsReusable()
+{
+	return true;
+}
+
+void AMF_STD_CALL AMFStub::Buffer::SetPts(amf_pts pts)
+{
+	m_Pts = pts;
+}
+
+amf_pts AMF_STD_CALL AMFStub::Buffer::GetPts()
+{
+	return m_Pts;
+}
+
+void AMF_STD_CALL AMFStub::Buffer::SetDuration(amf_pts duration)
+{
+	m_Duration = duration;
+}
+
+amf_pts AMF_STD_CALL AMFStub::Buffer::GetDuration()
+{
+	return m_Duration;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Buffer::SetSize(amf_size newSize)
+{
+	if (m_External != nullptr) {
+		if (newSize > m_Size)
+			return AMF_OUT_OF_RANGE;
+	} else if (newSize > m_Storage.size()) {
+		m_Storage.resize(newSize);
+	}
+	m_Size = newSize;
+	return AMF_OK;
+}
+
+amf_size AMF_STD_CALL AMFStub::Buffer::GetSize()
+{
+	return m_Size;
+}
+
+void* AMF_STD_CALL AMFStub::Buffer::GetNative()
+{
+	return m_External ? m_External : m_Storage.data();
+}
+
+void AMF_STD_CALL AMFStub::Buffer::AddObserver(amf::AMFBufferObserver* pObserver)
+{
+	std::lock_guard<std::mutex> lock(m_ObserverLock);
+	m_Observers.push_back(pObserver);
+}
+
+void AMF_STD_CALL AMFStub::Buffer::RemoveObserver(amf::AMFBufferObserver* pObserver)
+{
+	std::lock_guard<std::mutex> lock(m_ObserverLock);
+	for (auto it = m_Observers.begin(); it != m_Observers.end(); it++) {
+		if (*it == pObserver) {
+			m_Observers.erase(it);
+			break;
+		}
+	}
+}
+#pragma endregion Buffer
+
+#pragma region Context
+AMFStub::Context::Context() : m_DX9Device(nullptr), m_DX11Device(nullptr) {}
+
+AMFStub::Context::~Context() {}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::Terminate()
+{
+	m_DX9Device  = nullptr;
+	m_DX11Device = nullptr;
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::InitDX9(void* pDX9Device)
+{
+	m_DX9Device = pDX9Device;
+	return AMF_OK;
+}
+
+void* AMF_STD_CALL AMFStub::Context::GetDX9Device(amf::AMF_DX_VERSION)
+{
+	return m_DX9Device;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::LockDX9()
+{
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::UnlockDX9()
+{
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::InitDX11(void* pDX11Device, amf::AMF_DX_VERSION)
+{
+	m_DX11Device = pDX11Device;
+	return AMF_OK;
+}
+
+void* AMF_STD_CALL AMFStub::Context::GetDX11Device(amf::AMF_DX_VERSION)
+{
+	return m_DX11Device;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::LockDX11()
+{
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::UnlockDX11()
+{
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::InitOpenCL(void*)
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+void* AMF_STD_CALL AMFStub::Context::GetOpenCLContext()
+{
+	return nullptr;
+}
+
+void* AMF_STD_CALL AMFStub::Context::GetOpenCLCommandQueue()
+{
+	return nullptr;
+}
+
+void* AMF_STD_CALL AMFStub::Context::GetOpenCLDeviceID()
+{
+	return nullptr;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::GetOpenCLComputeFactory(amf::AMFComputeFactory**)
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::InitOpenCLEx(amf::AMFComputeDevice*)
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::LockOpenCL()
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::UnlockOpenCL()
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::InitOpenGL(amf_handle, amf_handle, amf_handle)
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+amf_handle AMF_STD_CALL AMFStub::Context::GetOpenGLContext()
+{
+	return nullptr;
+}
+
+amf_handle AMF_STD_CALL AMFStub::Context::GetOpenGLDrawable()
+{
+	return nullptr;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::LockOpenGL()
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::UnlockOpenGL()
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::InitXV(void*)
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+void* AMF_STD_CALL AMFStub::Context::GetXVDevice()
+{
+	return nullptr;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::LockXV()
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::UnlockXV()
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::InitGralloc(void*)
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+void* AMF_STD_CALL AMFStub::Context::GetGrallocDevice()
+{
+	return nullptr;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::LockGralloc()
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::UnlockGralloc()
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::AllocBuffer(amf::AMF_MEMORY_TYPE type, amf_size size,
+													  amf::AMFBuffer** ppBuffer)
+{
+	if (ppBuffer == nullptr)
+		return AMF_INVALID_POINTER;
+	if ((type != amf::AMF_MEMORY_HOST) && (type != amf::AMF_MEMORY_UNKNOWN))
+		return AMF_NOT_SUPPORTED;
+
+	*ppBuffer = new Buffer(amf::AMF_MEMORY_HOST, size, nullptr, nullptr);
+	(*ppBuffer)->Acquire();
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::AllocSurface(amf::AMF_MEMORY_TYPE type, amf::AMF_SURFACE_FORMAT format,
+													   amf_int32 width, amf_int32 height, amf::AMFSurface** ppSurface)
+{
+	if (ppSurface == nullptr)
+		return AMF_INVALID_POINTER;
+	if ((type != amf::AMF_MEMORY_HOST) && (type != amf::AMF_MEMORY_DX9) && (type != amf::AMF_MEMORY_DX11))
+		return AMF_NOT_SUPPORTED;
+	if ((width <= 0) || (height <= 0))
+		return AMF_INVALID_ARG;
+
+	amf_int32 hPitch, vPitch;
+	size_t    size;
+	if (!Surface::CalculateLayout(format, width, height, hPitch, vPitch, size))
+		return AMF_NOT_SUPPORTED;
+
+	*ppSurface = new Surface(type, format, width, height, hPitch, vPitch, nullptr, nullptr);
+	(*ppSurface)->Acquire();
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::AllocAudioBuffer(amf::AMF_MEMORY_TYPE, amf::AMF_AUDIO_FORMAT, amf_int32,
+														   amf_int32, amf_int32, amf::AMFAudioBuffer**)
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::CreateBufferFromHostNative(void* pHostBuffer, amf_size size,
+																	 amf::AMFBuffer**        ppBuffer,
+																	 amf::AMFBufferObserver* pObserver)
+{
+	if ((pHostBuffer == nullptr) || (ppBuffer == nullptr))
+		return AMF_INVALID_POINTER;
+
+	*ppBuffer = new Buffer(amf::AMF_MEMORY_HOST, size, static_cast<uint8_t*>(pHostBuffer), pObserver);
+	(*ppBuffer)->Acquire();
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::CreateSurfaceFromHostNative(amf::AMF_SURFACE_FORMAT format, amf_int32 width,
+																	  amf_int32 height, amf_int32 hPitch,
+																	  amf_int32 vPitch, void* pData,
+																	  amf::AMFSurface**        ppSurface,
+																	  amf::AMFSurfaceObserver* pObserver)
+{
+	if ((pData == nullptr) || (ppSurface == nullptr))
+		return AMF_INVALID_POINTER;
+	if ((width <= 0) || (height <= 0) || (hPitch <= 0) || (vPitch < height))
+		return AMF_INVALID_ARG;
+
+	amf_int32 minHPitch, minVPitch;
+	size_t    size;
+	if (!Surface::CalculateLayout(format, width, height, minHPitch, minVPitch, size))
+		return AMF_NOT_SUPPORTED;
+	if (hPitch < minHPitch)
+		return AMF_INVALID_ARG;
+
+	*ppSurface = new Surface(amf::AMF_MEMORY_HOST, format, width, height, hPitch, vPitch, static_cast<uint8_t*>(pData),
+							 pObserver);
+	(*ppSurface)->Acquire();
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::CreateSurfaceFromDX9Native(void*, amf::AMFSurface**,
+																	 amf::AMFSurfaceObserver*)
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::CreateSurfaceFromDX11Native(void*, amf::AMFSurface**,
+																	  amf::AMFSurfaceObserver*)
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::CreateSurfaceFromOpenGLNative(amf::AMF_SURFACE_FORMAT, amf_handle,
+																		amf::AMFSurface**, amf::AMFSurfaceObserver*)
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::CreateSurfaceFromGrallocNative(amf_handle, amf::AMFSurface**,
+																		 amf::AMFSurfaceObserver*)
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::CreateSurfaceFromOpenCLNative(amf::AMF_SURFACE_FORMAT, amf_int32,
+																		amf_int32, void**, amf::AMFSurface**,
+																		amf::AMFSurfaceObserver*)
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::CreateBufferFromOpenCLNative(void*, amf_size, amf::AMFBuffer**)
+{
+	return AMF_NOT_SUPPORTED;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Context::GetCompute(amf::AMF_MEMORY_TYPE, amf::AMFCompute**)
+{
+	return AMF_NOT_SUPPORTED;
+}
+#pragma endregion Context
@@ -0,0 +1,243 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "stub.hpp"
+
+#include <core/Buffer.h>
+#include <core/Context.h>
+#include <core/Plane.h>
+#include <core/Surface.h>
+
+namespace AMFStub {
+	class Plane : public Object<amf::AMFPlane> {
+		public:
+		Plane(amf::AMF_PLANE_TYPE type, uint8_t* data, amf_int32 pixelSize, amf_int32 width, amf_int32 height,
+			  amf_int32 hPitch, amf_int32 vPitch);
+		virtual ~Plane();
+
+		amf::AMF_PLANE_TYPE AMF_STD_CALL GetType() override;
+		void* AMF_STD_CALL               GetNative() override;
+		amf_int32 AMF_STD_CALL           GetPixelSizeInBytes() override;
+		amf_int32 AMF_STD_CALL           GetOffsetX() override;
+		amf_int32 AMF_STD_CALL           GetOffsetY() override;
+		amf_int32 AMF_STD_CALL           GetWidth() override;
+		amf_int32 AMF_STD_CALL           GetHeight() override;
+		amf_int32 AMF_STD_CALL           GetHPitch() override;
+		amf_int32 AMF_STD_CALL           GetVPitch() override;
+		bool AMF_STD_CALL                IsTiled() override;
+
+		private:
+		amf::AMF_PLANE_TYPE m_Type;
+		uint8_t*            m_Data;
+		amf_int32           m_PixelSize;
+		amf_int32           m_Width, m_Height;
+		amf_int32           m_HPitch, m_VPitch;
+	};
+
+	/// Surface in host memory.
+	///
+	/// The memory is either owned by the surface or supplied by the caller, in which case the observers are told
+	/// once the surface no longer references it. Surfaces may be labelled as DX9 or DX11 memory so the encoder can
+	/// treat them like GPU surfaces, the data itself always stays in host memory. Like an upload to the GPU, the
+	/// conversion of supplied memory to either of them copies it and releases the caller's memory.
+	class Surface : public PropertyObject<amf::AMFSurface, amf::AMFData, amf::AMFPropertyStorage> {
+		public:
+		Surface(amf::AMF_MEMORY_TYPE memoryType, amf::AMF_SURFACE_FORMAT format, amf_int32 width, amf_int32 height,
+				amf_int32 hPitch, amf_int32 vPitch, uint8_t* external, amf::AMFSurfaceObserver* observer);
+		virtual ~Surface();
+
+		/// Pitches in bytes for surfaces that allocate their own memory, false for unsupported formats.
+		static bool CalculateLayout(amf::AMF_SURFACE_FORMAT format, amf_int32 width, amf_int32 height,
+									amf_int32& hPitch, amf_int32& vPitch, size_t& size);
+
+		using PropertyObject::AddObserver;
+		using PropertyObject::RemoveObserver;
+
+		// AMFData
+		amf::AMF_MEMORY_TYPE AMF_STD_CALL GetMemoryType() override;
+		AMF_RESULT AMF_STD_CALL           Duplicate(amf::AMF_MEMORY_TYPE type, amf::AMFData** ppData) override;
+		AMF_RESULT AMF_STD_CALL           Convert(amf::AMF_MEMORY_TYPE type) override;
+		AMF_RESULT AMF_STD_CALL           Interop(amf::AMF_MEMORY_TYPE type) override;
+		amf::AMF_DATA_TYPE AMF_STD_CALL   GetDataType() override;
+		amf_bool AMF_STD_CALL             IsReusable() override;
+		void AMF_STD_CALL                 SetPts(amf_pts pts) override;
+		amf_pts AMF_STD_CALL              GetPts() override;
+		void AMF_STD_CALL                 SetDuration(amf_pts duration) override;
+		amf_pts AMF_STD_CALL              GetDuration() override;
+
+		// AMFSurface
+		amf::AMF_SURFACE_FORMAT AMF_STD_CALL GetFormat() override;
+		amf_size AMF_STD_CALL                GetPlanesCount() override;
+		amf::AMFPlane* AMF_STD_CALL          GetPlaneAt(amf_size index) override;
+		amf::AMFPlane* AMF_STD_CALL          GetPlane(amf::AMF_PLANE_TYPE type) override;
+		amf::AMF_FRAME_TYPE AMF_STD_CALL     GetFrameType() override;
+		void AMF_STD_CALL                    SetFrameType(amf::AMF_FRAME_TYPE type) override;
+		AMF_RESULT AMF_STD_CALL SetCrop(amf_int32 x, amf_int32 y, amf_int32 width, amf_int32 height) override;
+		AMF_RESULT AMF_STD_CALL CopySurfaceRegion(amf::AMFSurface* pDest, amf_int32 dstX, amf_int32 dstY,
+												  amf_int32 srcX, amf_int32 srcY, amf_int32 width,
+												  amf_int32 height) override;
+		void AMF_STD_CALL       AddObserver(amf::AMFSurfaceObserver* pObserver) override;
+		void AMF_STD_CALL       RemoveObserver(amf::AMFSurfaceObserver* pObserver) override;
+
+		private:
+		static bool IsHostCompatible(amf::AMF_MEMORY_TYPE type);
+		void        CreatePlanes(uint8_t* base);
+		void        NotifyObservers();
+
+		amf::AMF_MEMORY_TYPE    m_MemoryType;
+		amf::AMF_SURFACE_FORMAT m_Format;
+		amf_int32               m_Width, m_Height;
+		amf_int32               m_HPitch, m_VPitch;
+		amf::AMF_FRAME_TYPE     m_FrameType;
+		amf_pts                 m_Pts, m_Duration;
+
+		std::unique_ptr<uint8_t[]>     m_Storage;
+		std::vector<amf::AMFPlanePtr>  m_Planes;
+
+		std::mutex                            m_ObserverLock;
+		std::vector<amf::AMFSurfaceObserver*> m_Observers;
+	};
+
+	class Buffer : public PropertyObject<amf::AMFBuffer, amf::AMFData, amf::AMFPropertyStorage> {
+		public:
+		Buffer(amf::AMF_MEMORY_TYPE memoryType, amf_size size, uint8_t* external, amf::AMFBufferObserver* observer);
+		virtual ~Buffer();
+
+		using PropertyObject::AddObserver;
+		using PropertyObject::RemoveObserver;
+
+		// AMFData
+		amf::AMF_MEMORY_TYPE AMF_STD_CALL GetMemoryType() override;
+		AMF_RESULT AMF_STD_CALL           Duplicate(amf::AMF_MEMORY_TYPE type, amf::AMFData** ppData) override;
+		AMF_RESULT AMF_STD_CALL           Convert(amf::AMF_MEMORY_TYPE type) override;
+		AMF_RESULT AMF_STD_CALL           Interop(amf::AMF_MEMORY_TYPE type) override;
+		amf::AMF_DATA_TYPE AMF_STD_CALL   GetDataType() override;
+		amf_bool AMF_STD_CALL             IsReusable() override;
+		void AMF_STD_CALL                 SetPts(amf_pts pts) override;
+		amf_pts AMF_STD_CALL              GetPts() override;
+		void AMF_STD_CALL                 SetDuration(amf_pts duration) override;
+		amf_pts AMF_STD_CALL              GetDuration() override;
+
+		// AMFBuffer
+		AMF_RESULT AMF_STD_CALL SetSize(amf_size newSize) override;
+		amf_size AMF_STD_CALL   GetSize() override;
+		void* AMF_STD_CALL      GetNative() override;
+		void AMF_STD_CALL       AddObserver(amf::AMFBufferObserver* pObserver) override;
+		void AMF_STD_CALL       RemoveObserver(amf::AMFBufferObserver* pObserver) override;
+
+		private:
+		amf::AMF_MEMORY_TYPE m_MemoryType;
+		amf_pts              m_Pts, m_Duration;
+
+		std::vector<uint8_t> m_Storage;
+		uint8_t*             m_External;
+		amf_size             m_Size;
+
+		std::mutex                           m_ObserverLock;
+		std::vector<amf::AMFBufferObserver*> m_Observers;
+	};
+
+	/// Host memory context. DX9 and DX11 devices are accepted but never touched.
+	class Context : public PropertyObject<amf::AMFContext, amf::AMFPropertyStorage> {
+		public:
+		Context();
+		virtual ~Context();
+
+		AMF_RESULT AMF_STD_CALL Terminate() override;
+
+		// DirectX 9
+		AMF_RESULT AMF_STD_CALL InitDX9(void* pDX9Device) override;
+		void* AMF_STD_CALL      GetDX9Device(amf::AMF_DX_VERSION dxVersionRequired) override;
+		AMF_RESULT AMF_STD_CALL LockDX9() override;
+		AMF_RESULT AMF_STD_CALL UnlockDX9() override;
+
+		// DirectX 11
+		AMF_RESULT AMF_STD_CALL InitDX11(void* pDX11Device, amf::AMF_DX_VERSION dxVersionRequired) override;
+		void* AMF_STD_CALL      GetDX11Device(amf::AMF_DX_VERSION dxVersionRequired) override;
+		AMF_RESULT AMF_STD_CALL LockDX11() override;
+		AMF_RESULT AMF_STD_CALL UnlockDX11() override;
+
+		// OpenCL
+		AMF_RESULT AMF_STD_CALL InitOpenCL(void* pCommandQueue) override;
+		void* AMF_STD_CALL      GetOpenCLContext() override;
+		void* AMF_STD_CALL      GetOpenCLCommandQueue() override;
+		void* AMF_STD_CALL      GetOpenCLDeviceID() override;
+		AMF_RESULT AMF_STD_CALL GetOpenCLComputeFactory(amf::AMFComputeFactory** ppFactory) override;
+		AMF_RESULT AMF_STD_CALL InitOpenCLEx(amf::AMFComputeDevice* pDevice) override;
+		AMF_RESULT AMF_STD_CALL LockOpenCL() override;
+		AMF_RESULT AMF_STD_CALL UnlockOpenCL() override;
+
+		// OpenGL
+		AMF_RESULT AMF_STD_CALL InitOpenGL(amf_handle hOpenGLContext, amf_handle hWindow, amf_handle hDC) override;
+		amf_handle AMF_STD_CALL GetOpenGLContext() override;
+		amf_handle AMF_STD_CALL GetOpenGLDrawable() override;
+		AMF_RESULT AMF_STD_CALL LockOpenGL() override;
+		AMF_RESULT AMF_STD_CALL UnlockOpenGL() override;
+
+		// XV
+		AMF_RESULT AMF_STD_CALL InitXV(void* pXVDevice) override;
+		void* AMF_STD_CALL      GetXVDevice() override;
+		AMF_RESULT AMF_STD_CALL LockXV() override;
+		AMF_RESULT AMF_STD_CALL UnlockXV() override;
+
+		// Gralloc
+		AMF_RESULT AMF_STD_CALL InitGralloc(void* pGrallocDevice) override;
+		void* AMF_STD_CALL      GetGrallocDevice() override;
+		AMF_RESULT AMF_STD_CALL LockGralloc() override;
+		AMF_RESULT AMF_STD_CALL UnlockGralloc() override;
+
+		// Allocation
+		AMF_RESULT AMF_STD_CALL AllocBuffer(amf::AMF_MEMORY_TYPE type, amf_size size, amf::AMFBuffer** ppBuffer) override;
+		AMF_RESULT AMF_STD_CALL AllocSurface(amf::AMF_MEMORY_TYPE type, amf::AMF_SURFACE_FORMAT format, amf_int32 width,
+											 amf_int32 height, amf::AMFSurface** ppSurface) override;
+		AMF_RESULT AMF_STD_CALL AllocAudioBuffer(amf::AMF_MEMORY_TYPE type, amf::AMF_AUDIO_FORMAT format,
+												 amf_int32 samples, amf_int32 sampleRate, amf_int32 channels,
+												 amf::AMFAudioBuffer** ppAudioBuffer) override;
+		AMF_RESULT AMF_STD_CALL CreateBufferFromHostNative(void* pHostBuffer, amf_size size, amf::AMFBuffer** ppBuffer,
+														   amf::AMFBufferObserver* pObserver) override;
+		AMF_RESULT AMF_STD_CALL CreateSurfaceFromHostNative(amf::AMF_SURFACE_FORMAT format, amf_int32 width,
+															amf_int32 height, amf_int32 hPitch, amf_int32 vPitch,
+															void* pData, amf::AMFSurface** ppSurface,
+															amf::AMFSurfaceObserver* pObserver) override;
+		AMF_RESULT AMF_STD_CALL CreateSurfaceFromDX9Native(void* pDX9Surface, amf::AMFSurface** ppSurface,
+														   amf::AMFSurfaceObserver* pObserver) override;
+		AMF_RESULT AMF_STD_CALL CreateSurfaceFromDX11Native(void* pDX11Surface, amf::AMFSurface** ppSurface,
+															amf::AMFSurfaceObserver* pObserver) override;
+		AMF_RESULT AMF_STD_CALL CreateSurfaceFromOpenGLNative(amf::AMF_SURFACE_FORMAT format, amf_handle hGLTextureID,
+															  amf::AMFSurface**        ppSurface,
+															  amf::AMFSurfaceObserver* pObserver) override;
+		AMF_RESULT AMF_STD_CALL CreateSurfaceFromGrallocNative(amf_handle hGrallocSurface, amf::AMFSurface** ppSurface,
+															   amf::AMFSurfaceObserver* pObserver) override;
+		AMF_RESULT AMF_STD_CALL CreateSurfaceFromOpenCLNative(amf::AMF_SURFACE_FORMAT format, amf_int32 width,
+															  amf_int32 height, void** pClPlanes,
+															  amf::AMFSurface**        ppSurface,
+															  amf::AMFSurfaceObserver* pObserver) override;
+		AMF_RESULT AMF_STD_CALL CreateBufferFromOpenCLNative(void* pCLBuffer, amf_size size,
+															 amf::AMFBuffer** ppBuffer) override;
+		AMF_RESULT AMF_STD_CALL GetCompute(amf::AMF_MEMORY_TYPE eMemType, amf::AMFCompute** ppCompute) override;
+
+		private:
+		void* m_DX9Device;
+		void* m_DX11Device;
+	};
+} // namespace AMFStub
@@ -0,0 +1,522 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cwchar>
+#include <map>
+#include <mutex>
+#include <string>
+#include "stub-converter.hpp"
+#include "stub-encoder.hpp"
+#include "stub-memory.hpp"
+#include "stub.hpp"
+
+#include <components/VideoConverter.h>
+#include <components/VideoEncoderHEVC.h>
+#include <components/VideoEncoderVCE.h>
+#include <core/Debug.h>
+#include <core/Factory.h>
+#include <core/Version.h>
+
+// Size of a single formatted trace message.
+#define TRACE_MESSAGE_SIZE 4096
+
+using namespace AMFStub;
+
+namespace AMFStub {
+	/// Trace with the three built-in writers of the real runtime. Console and debug output both go to stderr.
+	class TraceLog : public amf::AMFTrace {
+		public:
+		TraceLog() : m_GlobalLevel(AMF_TRACE_WARNING), m_Indentation(0), m_File(nullptr)
+		{
+			m_Writers[AMF_TRACE_WRITER_CONSOLE]      = {nullptr, false, AMF_TRACE_WARNING};
+			m_Writers[AMF_TRACE_WRITER_DEBUG_OUTPUT] = {nullptr, false, AMF_TRACE_WARNING};
+			m_Writers[AMF_TRACE_WRITER_FILE]         = {nullptr, false, AMF_TRACE_WARNING};
+		}
+
+		virtual ~TraceLog()
+		{
+			if (m_File)
+				fclose(m_File);
+		}
+
+		void AMF_STD_CALL TraceW(const wchar_t* src_path, amf_int32 line, amf_int32 level, const wchar_t* scope,
+								 amf_int32, const wchar_t* format, ...) override
+		{
+			va_list args;
+			va_start(args, format);
+			Trace(src_path, line, level, scope, format, &args);
+			va_end(args);
+		}
+
+		void AMF_STD_CALL Trace(const wchar_t*, amf_int32, amf_int32 level, const wchar_t* scope,
+								const wchar_t* message, va_list* pArglist) override
+		{
+			if ((message == nullptr) || !IsLogged(level, m_GlobalLevel))
+				return;
+
+			wchar_t buffer[TRACE_MESSAGE_SIZE];
+			if (pArglist != nullptr) {
+				va_list args;
+				va_copy(args, *pArglist);
+				if (vswprintf(buffer, TRACE_MESSAGE_SIZE, message, args) < 0)
+					buffer[TRACE_MESSAGE_SIZE - 1] = L'\0';
+				va_end(args);
+				message = buffer;
+			}
+			if (scope == nullptr)
+				scope = L"";
+
+			std::lock_guard<std::mutex> lock(m_Lock);
+			for (auto& kv : m_Writers) {
+				Writer& writer = kv.second;
+				if (!writer.enabled || !IsLogged(level, writer.level))
+					continue;
+
+				if (writer.writer != nullptr) {
+					writer.writer->Write(scope, message);
+				} else if (kv.first == AMF_TRACE_WRITER_FILE) {
+					if ((m_File == nullptr) && !m_Path.empty())
+						m_File = fopen(m_Path.c_str(), "a");
+					if (m_File)
+						fwprintf(m_File, L"%ls: %ls\n", scope, message);
+				} else {
+					fwprintf(stderr, L"%ls: %ls\n", scope, message);
+				}
+			}
+		}
+
+		amf_int32 AMF_STD_CALL SetGlobalLevel(amf_int32 level) override
+		{
+			amf_int32 old = m_GlobalLevel;
+			m_GlobalLevel = level;
+			return old;
+		}
+
+		amf_int32 AMF_STD_CALL GetGlobalLevel() override
+		{
+			return m_GlobalLevel;
+		}
+
+		amf_bool AMF_STD_CALL EnableWriter(const wchar_t* writerID, bool enable) override
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+			auto                        it = m_Writers.find(writerID);
+			if (it == m_Writers.end())
+				return false;
+			bool old           = it->second.enabled;
+			it->second.enabled = enable;
+			return old;
+		}
+
+		amf_bool AMF_STD_CALL WriterEnabled(const wchar_t* writerID) override
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+			auto                        it = m_Writers.find(writerID);
+			return (it != m_Writers.end()) && it->second.enabled;
+		}
+
+		AMF_RESULT AMF_STD_CALL TraceEnableAsync(amf_bool) override
+		{
+			return AMF_OK;
+		}
+
+		AMF_RESULT AMF_STD_CALL TraceFlush() override
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+			for (auto& kv : m_Writers) {
+				if (kv.second.writer != nullptr)
+					kv.second.writer->Flush();
+			}
+			if (m_File)
+				fflush(m_File);
+			return AMF_OK;
+		}
+
+		AMF_RESULT AMF_STD_CALL SetPath(const wchar_t* path) override
+		{
+			if (path == nullptr)
+				return AMF_INVALID_POINTER;
+
+			std::lock_guard<std::mutex> lock(m_Lock);
+			m_WidePath = path;
+			m_Path.resize(wcstombs(nullptr, path, 0) + 1);
+			m_Path.resize(wcstombs(&m_Path[0], path, m_Path.size()));
+			if (m_File) {
+				fclose(m_File);
+				m_File = nullptr;
+			}
+			return AMF_OK;
+		}
+
+		AMF_RESULT AMF_STD_CALL GetPath(wchar_t* path, amf_size* pSize) override
+		{
+			if (pSize == nullptr)
+				return AMF_INVALID_POINTER;
+
+			std::lock_guard<std::mutex> lock(m_Lock);
+			if ((path == nullptr) || (*pSize <= m_WidePath.size())) {
+				*pSize = m_WidePath.size() + 1;
+				return (path == nullptr) ? AMF_OK : AMF_INVALID_ARG;
+			}
+			wcscpy(path, m_WidePath.c_str());
+			return AMF_OK;
+		}
+
+		amf_int32 AMF_STD_CALL SetWriterLevel(const wchar_t* writerID, amf_int32 level) override
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+			auto                        it = m_Writers.find(writerID);
+			if (it == m_Writers.end())
+				return AMF_TRACE_NOLOG;
+			amf_int32 old    = it->second.level;
+			it->second.level = level;
+			return old;
+		}
+
+		amf_int32 AMF_STD_CALL GetWriterLevel(const wchar_t* writerID) override
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+			auto                        it = m_Writers.find(writerID);
+			return (it != m_Writers.end()) ? it->second.level : AMF_TRACE_NOLOG;
+		}
+
+		amf_int32 AMF_STD_CALL SetWriterLevelForScope(const wchar_t* writerID, const wchar_t*, amf_int32 level) override
+		{
+			return SetWriterLevel(writerID, level);
+		}
+
+		amf_int32 AMF_STD_CALL GetWriterLevelForScope(const wchar_t* writerID, const wchar_t*) override
+		{
+			return GetWriterLevel(writerID);
+		}
+
+		amf_int32 AMF_STD_CALL GetIndentation() override
+		{
+			return m_Indentation;
+		}
+
+		void AMF_STD_CALL Indent(amf_int32 addIndent) override
+		{
+			m_Indentation += addIndent;
+		}
+
+		void AMF_STD_CALL RegisterWriter(const wchar_t* writerID, amf::AMFTraceWriter* pWriter, amf_bool enable) override
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+			m_Writers[writerID] = {pWriter, enable, AMF_TRACE_WARNING};
+		}
+
+		void AMF_STD_CALL UnregisterWriter(const wchar_t* writerID) override
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+			auto                        it = m_Writers.find(writerID);
+			if ((it != m_Writers.end()) && (it->second.writer != nullptr))
+				m_Writers.erase(it);
+		}
+
+		const wchar_t* AMF_STD_CALL GetResultText(AMF_RESULT res) override
+		{
+			switch (res) {
+				case AMF_OK:
+					return L"AMF_OK";
+				case AMF_FAIL:
+					return L"AMF_FAIL";
+				case AMF_UNEXPECTED:
+					return L"AMF_UNEXPECTED";
+				case AMF_ACCESS_DENIED:
+					return L"AMF_ACCESS_DENIED";
+				case AMF_INVALID_ARG:
+					return L"AMF_INVALID_ARG";
+				case AMF_OUT_OF_RANGE:
+					return L"AMF_OUT_OF_RANGE";
+				case AMF_OUT_OF_MEMORY:
+					return L"AMF_OUT_OF_MEMORY";
+				case AMF_INVALID_POINTER:
+					return L"AMF_INVALID_POINTER";
+				case AMF_NO_INTERFACE:
+					return L"AMF_NO_INTERFACE";
+				case AMF_NOT_IMPLEMENTED:
+					return L"AMF_NOT_IMPLEMENTED";
+				case AMF_NOT_SUPPORTED:
+					return L"AMF_NOT_SUPPORTED";
+				case AMF_NOT_FOUND:
+					return L"AMF_NOT_FOUND";
+				case AMF_ALREADY_INITIALIZED:
+					return L"AMF_ALREADY_INITIALIZED";
+				case AMF_NOT_INITIALIZED:
+					return L"AMF_NOT_INITIALIZED";
+				case AMF_INVALID_FORMAT:
+					return L"AMF_INVALID_FORMAT";
+				case AMF_WRONG_STATE:
+					return L"AMF_WRONG_STATE";
+				case AMF_NO_DEVICE:
+					return L"AMF_NO_DEVICE";
+				case AMF_EOF:
+					return L"AMF_EOF";
+				case AMF_REPEAT:
+					return L"AMF_REPEAT";
+				case AMF_INPUT_FULL:
+					return L"AMF_INPUT_FULL";
+				case AMF_RESOLUTION_CHANGED:
+					return L"AMF_RESOLUTION_CHANGED";
+				case AMF_INVALID_DATA_TYPE:
+					return L"AMF_INVALID_DATA_TYPE";
+				case AMF_INVALID_RESOLUTION:
+					return L"AMF_INVALID_RESOLUTION";
+				case AMF_CODEC_NOT_SUPPORTED:
+					return L"AMF_CODEC_NOT_SUPPORTED";
+				case AMF_SURFACE_FORMAT_NOT_SUPPORTED:
+					return L"AMF_SURFACE_FORMAT_NOT_SUPPORTED";
+				case AMF_ENCODER_NOT_PRESENT:
+					return L"AMF_ENCODER_NOT_PRESENT";
+				default:
+					return L"AMF_UNKNOWN_RESULT";
+			}
+		}
+
+		const wchar_t* AMF_STD_CALL SurfaceGetFormatName(const amf::AMF_SURFACE_FORMAT eSurfaceFormat) override
+		{
+			switch (eSurfaceFormat) {
+				case amf::AMF_SURFACE_NV12:
+					return L"NV12";
+				case amf::AMF_SURFACE_YV12:
+					return L"YV12";
+				case amf::AMF_SURFACE_BGRA:
+					return L"BGRA";
+				case amf::AMF_SURFACE_ARGB:
+					return L"ARGB";
+				case amf::AMF_SURFACE_RGBA:
+					return L"RGBA";
+				case amf::AMF_SURFACE_GRAY8:
+					return L"GRAY8";
+				case amf::AMF_SURFACE_YUV420P:
+					return L"YUV420P";
+				case amf::AMF_SURFACE_YUY2:
+					return L"YUY2";
+				default:
+					return L"UNKNOWN";
+			}
+		}
+
+		amf::AMF_SURFACE_FORMAT AMF_STD_CALL SurfaceGetFormatByName(const wchar_t* name) override
+		{
+			for (int format = amf::AMF_SURFACE_FIRST; format <= amf::AMF_SURFACE_LAST; format++) {
+				if (wcscmp(SurfaceGetFormatName((amf::AMF_SURFACE_FORMAT)format), name) == 0)
+					return (amf::AMF_SURFACE_FORMAT)format;
+			}
+			return amf::AMF_SURFACE_UNKNOWN;
+		}
+
+		const wchar_t* const AMF_STD_CALL GetMemoryTypeName(const amf::AMF_MEMORY_TYPE memoryType) override
+		{
+			switch (memoryType) {
+				case amf::AMF_MEMORY_HOST:
+					return L"Host";
+				case amf::AMF_MEMORY_DX9:
+					return L"DX9";
+				case amf::AMF_MEMORY_DX11:
+					return L"DX11";
+				case amf::AMF_MEMORY_OPENCL:
+					return L"OpenCL";
+				case amf::AMF_MEMORY_OPENGL:
+					return L"OpenGL";
+				case amf::AMF_MEMORY_VULKAN:
+					return L"Vulkan";
+				default:
+					return L"Unknown";
+			}
+		}
+
+		amf::AMF_MEMORY_TYPE AMF_STD_CALL GetMemoryTypeByName(const wchar_t* name) override
+		{
+			for (int type = amf::AMF_MEMORY_HOST; type <= amf::AMF_MEMORY_VULKAN; type++) {
+				if (wcscmp(GetMemoryTypeName((amf::AMF_MEMORY_TYPE)type), name) == 0)
+					return (amf::AMF_MEMORY_TYPE)type;
+			}
+			return amf::AMF_MEMORY_UNKNOWN;
+		}
+
+		const wchar_t* const AMF_STD_CALL GetSampleFormatName(const amf::AMF_AUDIO_FORMAT) override
+		{
+			return L"Unknown";
+		}
+
+		amf::AMF_AUDIO_FORMAT AMF_STD_CALL GetSampleFormatByName(const wchar_t*) override
+		{
+			return amf::AMFAF_UNKNOWN;
+		}
+
+		private:
+		/// Messages up to the given verbosity are logged, AMF_TRACE_NOLOG silences everything.
+		static bool IsLogged(amf_int32 level, amf_int32 threshold)
+		{
+			return (threshold != AMF_TRACE_NOLOG) && (level <= threshold);
+		}
+
+		struct Writer {
+			amf::AMFTraceWriter* writer; // nullptr for the built-in writers.
+			bool                 enabled;
+			amf_int32            level;
+		};
+
+		std::mutex                     m_Lock;
+		std::map<std::wstring, Writer> m_Writers;
+		amf_int32                      m_GlobalLevel;
+		amf_int32                      m_Indentation;
+		std::wstring                   m_WidePath;
+		std::string                    m_Path;
+		FILE*                          m_File;
+	};
+
+	class Debug : public amf::AMFDebug {
+		public:
+		Debug() : m_PerformanceMonitor(false), m_Asserts(false) {}
+
+		void AMF_STD_CALL EnablePerformanceMonitor(amf_bool enable) override
+		{
+			m_PerformanceMonitor = enable;
+		}
+
+		amf_bool AMF_STD_CALL PerformanceMonitorEnabled() override
+		{
+			return m_PerformanceMonitor;
+		}
+
+		void AMF_STD_CALL AssertsEnable(amf_bool enable) override
+		{
+			m_Asserts = enable;
+		}
+
+		amf_bool AMF_STD_CALL AssertsEnabled() override
+		{
+			return m_Asserts;
+		}
+
+		private:
+		bool m_PerformanceMonitor;
+		bool m_Asserts;
+	};
+
+	class Factory : public amf::AMFFactory {
+		public:
+		AMF_RESULT AMF_STD_CALL CreateContext(amf::AMFContext** ppContext) override
+		{
+			if (ppContext == nullptr)
+				return AMF_INVALID_POINTER;
+			*ppContext = new Context();
+			(*ppContext)->Acquire();
+			return AMF_OK;
+		}
+
+		AMF_RESULT AMF_STD_CALL CreateComponent(amf::AMFContext* pContext, const wchar_t* id,
+												amf::AMFComponent** ppComponent) override
+		{
+			if ((id == nullptr) || (ppComponent == nullptr))
+				return AMF_INVALID_POINTER;
+
+			if (wcscmp(id, AMFVideoConverter) == 0) {
+				*ppComponent = new Converter(pContext);
+			} else if ((wcscmp(id, AMFVideoEncoderVCE_AVC) == 0) || (wcscmp(id, AMFVideoEncoderVCE_SVC) == 0)) {
+				*ppComponent = new Encoder(pContext, Codec::H264);
+			} else if (wcscmp(id, AMFVideoEncoder_HEVC) == 0) {
+				*ppComponent = new Encoder(pContext, Codec::H265);
+			} else {
+				Log(AMF_TRACE_WARNING, L"Factory", L"Component %ls is not available.", id);
+				return AMF_NOT_SUPPORTED;
+			}
+			(*ppComponent)->Acquire();
+			return AMF_OK;
+		}
+
+		AMF_RESULT AMF_STD_CALL SetCacheFolder(const wchar_t* path) override
+		{
+			m_CacheFolder = path ? path : L"";
+			return AMF_OK;
+		}
+
+		const wchar_t* AMF_STD_CALL GetCacheFolder() override
+		{
+			return m_CacheFolder.c_str();
+		}
+
+		AMF_RESULT AMF_STD_CALL GetDebug(amf::AMFDebug** ppDebug) override;
+		AMF_RESULT AMF_STD_CALL GetTrace(amf::AMFTrace** ppTrace) override;
+
+		AMF_RESULT AMF_STD_CALL GetPrograms(amf::AMFPrograms**) override
+		{
+			return AMF_NOT_SUPPORTED;
+		}
+
+		private:
+		std::wstring m_CacheFolder;
+	};
+} // namespace AMFStub
+
+// The real runtime hands out process-wide singletons that are never reference counted.
+static AMFStub::TraceLog g_Trace;
+static AMFStub::Debug    g_Debug;
+static AMFStub::Factory  g_Factory;
+
+AMF_RESULT AMF_STD_CALL AMFStub::Factory::GetDebug(amf::AMFDebug** ppDebug)
+{
+	if (ppDebug == nullptr)
+		return AMF_INVALID_POINTER;
+	*ppDebug = &g_Debug;
+	return AMF_OK;
+}
+
+AMF_RESULT AMF_STD_CALL AMFStub::Factory::GetTrace(amf::AMFTrace** ppTrace)
+{
+	if (ppTrace == nullptr)
+		return AMF_INVALID_POINTER;
+	*ppTrace = &g_Trace;
+	return AMF_OK;
+}
+
+void AMFStub::Log(amf_int32 level, const wchar_t* scope, const wchar_t* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	g_Trace.Trace(nullptr, 0, level, scope, format, &args);
+	va_end(args);
+}
+
+extern "C" {
+AMF_CORE_LINK AMF_RESULT AMF_CDECL_CALL AMFQueryVersion(amf_uint64* pVersion)
+{
+	if (pVersion == nullptr)
+		return AMF_INVALID_POINTER;
+	*pVersion = AMF_FULL_VERSION;
+	return AMF_OK;
+}
+
+AMF_CORE_LINK AMF_RESULT AMF_CDECL_CALL AMFInit(amf_uint64 version, amf::AMFFactory** ppFactory)
+{
+	if (ppFactory == nullptr)
+		return AMF_INVALID_POINTER;
+	if (version > AMF_FULL_VERSION)
+		return AMF_NOT_SUPPORTED;
+
+	*ppFactory = &g_Factory;
+	return AMF_OK;
+}
+}
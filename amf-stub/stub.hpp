@@ -0,0 +1,229 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#include <atomic>
+#include <initializer_list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <core/Interface.h>
+#include <core/PropertyStorage.h>
+#include <core/PropertyStorageEx.h>
+#include <core/Trace.h>
+#include <core/Variant.h>
+
+namespace AMFStub {
+	/// Reference counting and QueryInterface for a single inheritance chain of AMF interfaces.
+	///
+	/// Base is the most derived interface, Chain lists the interfaces between it and AMFInterface. All of them
+	/// share the same vtable pointer, so every supported IID hands out the same pointer.
+	template<class Base, class... Chain>
+	class Object : public Base {
+		public:
+		virtual ~Object() {}
+
+		amf_long AMF_STD_CALL Acquire() override
+		{
+			return ++m_RefCount;
+		}
+
+		amf_long AMF_STD_CALL Release() override
+		{
+			amf_long count = --m_RefCount;
+			if (count == 0)
+				delete this;
+			return count;
+		}
+
+		AMF_RESULT AMF_STD_CALL QueryInterface(const amf::AMFGuid& interfaceID, void** ppInterface) override
+		{
+			if (ppInterface == nullptr)
+				return AMF_INVALID_POINTER;
+
+			for (const amf::AMFGuid& iid : {Base::IID(), Chain::IID()..., amf::AMFInterface::IID()}) {
+				if (iid == interfaceID) {
+					*ppInterface = static_cast<Base*>(this);
+					Acquire();
+					return AMF_OK;
+				}
+			}
+			*ppInterface = nullptr;
+			return AMF_NO_INTERFACE;
+		}
+
+		private:
+		std::atomic<amf_long> m_RefCount = 0;
+	};
+
+	/// Thread-safe AMFPropertyStorage on top of Object.
+	///
+	/// Derived classes can coerce or reject values by overriding Validate(), which also backs ValidateProperty
+	/// for components.
+	template<class Base, class... Chain>
+	class PropertyObject : public Object<Base, Chain...> {
+		public:
+		using amf::AMFPropertyStorage::GetProperty;
+		using amf::AMFPropertyStorage::SetProperty;
+
+		AMF_RESULT AMF_STD_CALL SetProperty(const wchar_t* name, amf::AMFVariantStruct value) override
+		{
+			if (name == nullptr)
+				return AMF_INVALID_POINTER;
+
+			amf::AMFVariant validated;
+			AMF_RESULT      res = Validate(name, value, validated);
+			if (res != AMF_OK)
+				return res;
+
+			std::vector<amf::AMFPropertyStorageObserver*> observers;
+			{
+				std::lock_guard<std::mutex> lock(m_PropertyLock);
+				m_Properties[name] = validated;
+				observers          = m_PropertyObservers;
+			}
+			for (amf::AMFPropertyStorageObserver* observer : observers)
+				observer->OnPropertyChanged(name);
+			return AMF_OK;
+		}
+
+		AMF_RESULT AMF_STD_CALL GetProperty(const wchar_t* name, amf::AMFVariantStruct* pValue) const override
+		{
+			if ((name == nullptr) || (pValue == nullptr))
+				return AMF_INVALID_POINTER;
+
+			std::lock_guard<std::mutex> lock(m_PropertyLock);
+			auto                        it = m_Properties.find(name);
+			if (it == m_Properties.end())
+				return AMF_NOT_FOUND;
+			return amf::AMFVariantCopy(pValue, &it->second);
+		}
+
+		amf_bool AMF_STD_CALL HasProperty(const wchar_t* name) const override
+		{
+			if (name == nullptr)
+				return false;
+
+			std::lock_guard<std::mutex> lock(m_PropertyLock);
+			return m_Properties.count(name) != 0;
+		}
+
+		amf_size AMF_STD_CALL GetPropertyCount() const override
+		{
+			std::lock_guard<std::mutex> lock(m_PropertyLock);
+			return m_Properties.size();
+		}
+
+		AMF_RESULT AMF_STD_CALL GetPropertyAt(amf_size index, wchar_t* name, amf_size nameSize,
+											  amf::AMFVariantStruct* pValue) const override
+		{
+			if ((name == nullptr) || (pValue == nullptr))
+				return AMF_INVALID_POINTER;
+
+			std::lock_guard<std::mutex> lock(m_PropertyLock);
+			if (index >= m_Properties.size())
+				return AMF_OUT_OF_RANGE;
+
+			auto it = m_Properties.begin();
+			std::advance(it, index);
+			if (it->first.size() >= nameSize)
+				return AMF_INVALID_ARG;
+			it->first.copy(name, it->first.size());
+			name[it->first.size()] = L'\0';
+			return amf::AMFVariantCopy(pValue, &it->second);
+		}
+
+		AMF_RESULT AMF_STD_CALL Clear() override
+		{
+			std::lock_guard<std::mutex> lock(m_PropertyLock);
+			m_Properties.clear();
+			return AMF_OK;
+		}
+
+		AMF_RESULT AMF_STD_CALL AddTo(amf::AMFPropertyStorage* pDest, amf_bool overwrite, amf_bool) const override
+		{
+			if (pDest == nullptr)
+				return AMF_INVALID_POINTER;
+
+			// Copy first, the destination may be this object or call back into it.
+			std::map<std::wstring, amf::AMFVariant> properties;
+			{
+				std::lock_guard<std::mutex> lock(m_PropertyLock);
+				properties = m_Properties;
+			}
+			for (auto& kv : properties) {
+				if (!overwrite && pDest->HasProperty(kv.first.c_str()))
+					continue;
+				AMF_RESULT res = pDest->SetProperty(kv.first.c_str(), static_cast<const amf::AMFVariantStruct&>(kv.second));
+				if (res != AMF_OK)
+					return res;
+			}
+			return AMF_OK;
+		}
+
+		AMF_RESULT AMF_STD_CALL CopyTo(amf::AMFPropertyStorage* pDest, amf_bool deep) const override
+		{
+			if (pDest == nullptr)
+				return AMF_INVALID_POINTER;
+			pDest->Clear();
+			return AddTo(pDest, true, deep);
+		}
+
+		void AMF_STD_CALL AddObserver(amf::AMFPropertyStorageObserver* pObserver) override
+		{
+			std::lock_guard<std::mutex> lock(m_PropertyLock);
+			m_PropertyObservers.push_back(pObserver);
+		}
+
+		void AMF_STD_CALL RemoveObserver(amf::AMFPropertyStorageObserver* pObserver) override
+		{
+			std::lock_guard<std::mutex> lock(m_PropertyLock);
+			for (auto it = m_PropertyObservers.begin(); it != m_PropertyObservers.end(); it++) {
+				if (*it == pObserver) {
+					m_PropertyObservers.erase(it);
+					break;
+				}
+			}
+		}
+
+		protected:
+		virtual AMF_RESULT Validate(const wchar_t*, const amf::AMFVariantStruct& value, amf::AMFVariant& validated) const
+		{
+			validated = amf::AMFVariant(value);
+			return AMF_OK;
+		}
+
+		/// Stores a value without validation or notification, for values owned by the object itself.
+		void StoreProperty(const wchar_t* name, const amf::AMFVariant& value)
+		{
+			std::lock_guard<std::mutex> lock(m_PropertyLock);
+			m_Properties[name] = value;
+		}
+
+		private:
+		mutable std::mutex                            m_PropertyLock;
+		std::map<std::wstring, amf::AMFVariant>       m_Properties;
+		std::vector<amf::AMFPropertyStorageObserver*> m_PropertyObservers;
+	};
+
+	/// Sends a message to the trace writers registered with the runtime.
+	void Log(amf_int32 level, const wchar_t* scope, const wchar_t* format, ...);
+} // namespace AMFStub
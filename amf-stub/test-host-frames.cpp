@@ -0,0 +1,181 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+// Runs OBS frames through the encoder against the stand-in runtime, once submitted without a copy and once with a
+// runtime that keeps the frame memory referenced, which has to fall back to copying.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "amf.hpp"
+#include "api-base.hpp"
+
+// The wrapping path depends on the memory type of the API, so the test reaches into the encoder to force it.
+#define private public
+#define protected public
+#include "amf-encoder-h264.hpp"
+#undef protected
+#undef private
+
+using namespace Plugin;
+using namespace Plugin::AMD;
+
+// Frame size and count used for every run.
+#define TEST_WIDTH 640
+#define TEST_HEIGHT 360
+#define TEST_FRAMES 8
+// Matches the minimum alignment the encoder requires for wrapping.
+#define TEST_ALIGNMENT 32
+
+static int __failures = 0;
+
+#define CHECK(expr)                                                   \
+	if (!(expr)) {                                                    \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+		__failures++;                                                 \
+	}
+
+// Normally provided by OBS_MODULE_USE_DEFAULT_LOCALE in plugin.cpp.
+extern "C" const char* obs_module_text(const char* text)
+{
+	return text;
+}
+
+/// NV12 frame laid out like a single host surface, so the encoder may wrap it.
+class WrappableFrame {
+	public:
+	WrappableFrame()
+	{
+		std::memset(&m_Frame, 0, sizeof(m_Frame));
+		m_Memory.resize((size_t)TEST_WIDTH * TEST_HEIGHT * 3 / 2 + TEST_ALIGNMENT, 0x80);
+
+		uint8_t* ptr = m_Memory.data();
+		ptr += (TEST_ALIGNMENT - (reinterpret_cast<uintptr_t>(ptr) % TEST_ALIGNMENT)) % TEST_ALIGNMENT;
+		m_Frame.data[0]     = ptr;
+		m_Frame.linesize[0] = TEST_WIDTH;
+		m_Frame.data[1]     = ptr + (size_t)TEST_WIDTH * TEST_HEIGHT;
+		m_Frame.linesize[1] = TEST_WIDTH;
+	}
+
+	struct encoder_frame* Get(int64_t pts)
+	{
+		m_Frame.pts = pts;
+		return &m_Frame;
+	}
+
+	private:
+	std::vector<uint8_t> m_Memory;
+	struct encoder_frame m_Frame;
+};
+
+static std::unique_ptr<EncoderH264> create_encoder(std::shared_ptr<API::IAPI> api, API::Adapter adapter,
+												   amf::AMF_MEMORY_TYPE memoryType)
+{
+	std::unique_ptr<EncoderH264> encoder = std::make_unique<EncoderH264>(api, adapter);
+	encoder->SetUsage(Usage::Transcoding);
+	encoder->SetResolution(std::make_pair(TEST_WIDTH, TEST_HEIGHT));
+	encoder->SetFrameRate(std::make_pair(60, 1));
+	encoder->SetRateControlMethod(RateControlMethod::ConstantBitrate);
+	encoder->SetTargetBitrate(2000000);
+	// The stand-in runtime labels host memory as DX11 and copies wrapped frames when converting to it.
+	encoder->m_AMFMemoryType = memoryType;
+	return encoder;
+}
+
+/// Encodes TEST_FRAMES frames and returns the number of packets.
+static uint64_t encode_frames(EncoderH264* encoder, WrappableFrame& frame)
+{
+	uint64_t packets = 0;
+	for (int64_t idx = 0; idx < TEST_FRAMES; idx++) {
+		struct encoder_packet packet;
+		std::memset(&packet, 0, sizeof(packet));
+		bool received = false;
+		CHECK(encoder->Encode(frame.Get(idx), &packet, &received));
+		if (received)
+			packets++;
+	}
+	CHECK(encoder->Drain([&packets](struct encoder_packet*) { packets++; }, std::chrono::seconds(10)));
+	return packets;
+}
+
+int main(int, char*[])
+{
+	try {
+		AMF::Initialize();
+		API::InitializeAPIs();
+	} catch (const std::exception& ex) {
+		printf("Unable to initialize: %s\n", ex.what());
+		return 1;
+	}
+
+	std::shared_ptr<API::IAPI> api     = API::GetAPI(0);
+	API::Adapter               adapter = api->EnumerateAdapters()[0];
+	WrappableFrame             frame;
+
+	try {
+		// The conversion to DX11 detaches the surface from the frame, every frame goes to the encoder directly.
+		std::unique_ptr<EncoderH264> direct = create_encoder(api, adapter, amf::AMF_MEMORY_DX11);
+		direct->Start();
+		CHECK(direct->m_HostFrameWrapping);
+		CHECK(encode_frames(direct.get(), frame) == TEST_FRAMES);
+		CHECK(direct->m_WrappedFrameCount == TEST_FRAMES);
+		CHECK(direct->m_CopiedFrameCount == 0);
+		CHECK(direct->m_HostFrameWrapping);
+		direct->Stop();
+
+		// Host memory stays on the frame, so the first wrapped frame is copied after all and wrapping given up.
+		std::unique_ptr<EncoderH264> fallback = create_encoder(api, adapter, amf::AMF_MEMORY_HOST);
+		fallback->Start();
+		CHECK(!fallback->m_HostFrameWrapping);
+		fallback->m_HostFrameWrapping = true;
+		CHECK(encode_frames(fallback.get(), frame) == TEST_FRAMES);
+		CHECK(fallback->m_WrappedFrameCount == 0);
+		CHECK(fallback->m_CopiedFrameCount == TEST_FRAMES);
+		CHECK(!fallback->m_HostFrameWrapping);
+		fallback->Stop();
+	} catch (const std::exception& ex) {
+		printf("Encoding failed: %s\n", ex.what());
+		__failures++;
+	}
+
+	API::FinalizeAPIs();
+	AMF::Finalize();
+
+	if (__failures > 0) {
+		printf("%d checks failed.\n", __failures);
+		return 1;
+	}
+	printf("All checks passed.\n");
+	return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+// Checks capacity, full and empty handling and ordering of the single producer, single consumer ring.
+
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include "amf-queue.hpp"
+
+using namespace Plugin::AMD;
+
+// Values passed from the producer to the consumer thread.
+#define TEST_VALUES 1000000
+
+static int __failures = 0;
+
+#define CHECK(expr)                                                   \
+	if (!(expr)) {                                                    \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+		__failures++;                                                 \
+	}
+
+int main(int, char*[])
+{
+	// Capacity is rounded up to the next power of two.
+	CHECK(SPSCQueue<int>(1).Capacity() == 1);
+	CHECK(SPSCQueue<int>(2).Capacity() == 2);
+	CHECK(SPSCQueue<int>(3).Capacity() == 4);
+	CHECK(SPSCQueue<int>(8).Capacity() == 8);
+	CHECK(SPSCQueue<int>(9).Capacity() == 16);
+	bool thrown = false;
+	try {
+		SPSCQueue<int> empty(0);
+	} catch (const std::invalid_argument&) {
+		thrown = true;
+	}
+	CHECK(thrown);
+
+	// Pop fails while empty, Push fails once full, and both recover after the other side made progress.
+	{
+		SPSCQueue<int> queue(3);
+		int            value = -1;
+		CHECK(queue.Empty());
+		CHECK(!queue.Pop(value));
+		CHECK(queue.Peek() == nullptr);
+		for (int idx = 0; idx < 4; idx++)
+			CHECK(queue.Push(idx));
+		CHECK(queue.Size() == 4);
+		CHECK(!queue.Push(4));
+		CHECK((queue.Peek() != nullptr) && (*queue.Peek() == 0));
+		CHECK(queue.Pop(value) && (value == 0));
+		CHECK(queue.Push(4));
+		CHECK(!queue.Push(5));
+		for (int idx = 1; idx < 5; idx++)
+			CHECK(queue.Pop(value) && (value == idx));
+		CHECK(!queue.Pop(value));
+		CHECK(queue.Empty());
+	}
+
+	// Popped slots are cleared, so the ring does not keep references alive.
+	{
+		SPSCQueue<std::shared_ptr<int>> queue(2);
+		std::shared_ptr<int>            value = std::make_shared<int>(1);
+		std::shared_ptr<int>            popped;
+		CHECK(queue.Push(value));
+		CHECK(queue.Pop(popped));
+		popped = nullptr;
+		CHECK(value.use_count() == 1);
+	}
+
+	// A producer and a consumer thread on a small ring, so both sides hit full and empty many times. Every value
+	// has to arrive exactly once and in order.
+	{
+		SPSCQueue<uint64_t> queue(16);
+		std::thread         producer([&queue] {
+			for (uint64_t idx = 0; idx < TEST_VALUES;) {
+				if (queue.Push(idx))
+					idx++;
+				else
+					std::this_thread::yield();
+			}
+		});
+
+		uint64_t expected = 0, received = 0, misordered = 0;
+		while (expected < TEST_VALUES) {
+			uint64_t value;
+			if (!queue.Pop(value)) {
+				std::this_thread::yield();
+				continue;
+			}
+			if (value != expected)
+				misordered++;
+			expected = value + 1;
+			received++;
+		}
+		producer.join();
+
+		CHECK(misordered == 0);
+		CHECK(received == TEST_VALUES);
+		CHECK(queue.Empty());
+	}
+
+	if (__failures > 0) {
+		printf("%d checks failed.\n", __failures);
+		return 1;
+	}
+	printf("All checks passed.\n");
+	return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+// Checks slot reuse and release of the host surface pool against the stand-in runtime.
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "amf-surface-pool.hpp"
+
+#include <core/Factory.h>
+
+extern "C" AMF_RESULT AMF_CDECL_CALL AMFInit(amf_uint64 version, amf::AMFFactory** ppFactory);
+
+using namespace Plugin::AMD;
+
+// Frame size used for every surface in the test.
+#define TEST_WIDTH 64
+#define TEST_HEIGHT 64
+
+static int __failures = 0;
+
+#define CHECK(expr)                                                   \
+	if (!(expr)) {                                                    \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+		__failures++;                                                 \
+	}
+
+static void* plane_memory(amf::AMFSurfacePtr& surface)
+{
+	return surface->GetPlaneAt(0)->GetNative();
+}
+
+int main(int, char*[])
+{
+	amf::AMFFactory* factory = nullptr;
+	if (AMFInit(AMF_FULL_VERSION, &factory) != AMF_OK) {
+		printf("Unable to initialize the runtime.\n");
+		return 1;
+	}
+	amf::AMFContextPtr context;
+	if (factory->CreateContext(&context) != AMF_OK) {
+		printf("Unable to create a context.\n");
+		return 1;
+	}
+
+	auto pool = std::make_unique<SurfacePool>(context, amf::AMF_SURFACE_NV12, TEST_WIDTH, TEST_HEIGHT, 2);
+
+	// Both slots are handed out, the third surface falls back to an allocation.
+	std::vector<amf::AMFSurfacePtr> surfaces(3);
+	for (amf::AMFSurfacePtr& surface : surfaces)
+		CHECK(pool->Acquire(&surface) == AMF_OK);
+	SurfacePoolStatistics stats = pool->GetStatistics();
+	CHECK(stats.hits == 2);
+	CHECK(stats.misses == 1);
+	CHECK(stats.outstanding == 2);
+	CHECK(stats.highwater == 2);
+
+	// Releasing a surface hands its slot back, and the next surface reuses the same memory.
+	void* memory = plane_memory(surfaces[0]);
+	surfaces[0]  = nullptr;
+	CHECK(pool->GetStatistics().outstanding == 1);
+	CHECK(pool->Acquire(&surfaces[0]) == AMF_OK);
+	CHECK(plane_memory(surfaces[0]) == memory);
+	CHECK(pool->GetStatistics().hits == 3);
+
+	// Fallback surfaces don't occupy a slot.
+	surfaces[2] = nullptr;
+	CHECK(pool->GetStatistics().outstanding == 2);
+
+	// Surfaces may outlive the pool, their memory stays valid until they are released.
+	pool = nullptr;
+	memset(plane_memory(surfaces[0]), 0x10, TEST_WIDTH);
+	memset(plane_memory(surfaces[1]), 0x20, TEST_WIDTH);
+	surfaces.clear();
+
+	context = nullptr;
+
+	if (__failures > 0) {
+		printf("%d checks failed.\n", __failures);
+		return 1;
+	}
+	printf("All checks passed.\n");
+	return 0;
+}
@@ -229,11 +229,23 @@ endif()
 # ######################################################################################################################
 set(PROJECT_HEADERS
     "${PROJECT_SOURCE_DIR}/include/amf.hpp"
+    "${PROJECT_SOURCE_DIR}/include/amf-band-pool.hpp"
     "${PROJECT_SOURCE_DIR}/include/amf-capabilities.hpp"
+    "${PROJECT_SOURCE_DIR}/include/amf-color-convert.hpp"
+    "${PROJECT_SOURCE_DIR}/include/amf-context.hpp"
     "${PROJECT_SOURCE_DIR}/include/amf-encoder.hpp"
+    "${PROJECT_SOURCE_DIR}/include/amf-encoder-pool.hpp"
+    "${PROJECT_SOURCE_DIR}/include/amf-property-transaction.hpp"
     "${PROJECT_SOURCE_DIR}/include/amf-encoder-h264.hpp"
     "${PROJECT_SOURCE_DIR}/include/enc-h264.hpp"
     "${PROJECT_SOURCE_DIR}/include/amf-encoder-h265.hpp"
+    "${PROJECT_SOURCE_DIR}/include/amf-plane-copy.hpp"
+    "${PROJECT_SOURCE_DIR}/include/amf-queue.hpp"
+    "${PROJECT_SOURCE_DIR}/include/amf-shared-input.hpp"
+    "${PROJECT_SOURCE_DIR}/include/amf-statistics.hpp"
+    "${PROJECT_SOURCE_DIR}/include/amf-surface-pool.hpp"
+    "${PROJECT_SOURCE_DIR}/include/amf-telemetry.hpp"
+    "${PROJECT_SOURCE_DIR}/include/amf-wait.hpp"
     "${PROJECT_SOURCE_DIR}/include/enc-h265.hpp"
     "${PROJECT_SOURCE_DIR}/include/api-base.hpp"
     "${PROJECT_SOURCE_DIR}/include/api-host.hpp"
@@ -244,11 +256,22 @@ set(PROJECT_HEADERS
     "${PROJECT_BINARY_DIR}/include/version.hpp")
 set(PROJECT_SOURCES
     "${PROJECT_SOURCE_DIR}/source/amf.cpp"
+    "${PROJECT_SOURCE_DIR}/source/amf-band-pool.cpp"
     "${PROJECT_SOURCE_DIR}/source/amf-capabilities.cpp"
+    "${PROJECT_SOURCE_DIR}/source/amf-color-convert.cpp"
+    "${PROJECT_SOURCE_DIR}/source/amf-context.cpp"
     "${PROJECT_SOURCE_DIR}/source/amf-encoder.cpp"
+    "${PROJECT_SOURCE_DIR}/source/amf-encoder-pool.cpp"
+    "${PROJECT_SOURCE_DIR}/source/amf-property-transaction.cpp"
     "${PROJECT_SOURCE_DIR}/source/amf-encoder-h264.cpp"
     "${PROJECT_SOURCE_DIR}/source/enc-h264.cpp"
     "${PROJECT_SOURCE_DIR}/source/amf-encoder-h265.cpp"
+    "${PROJECT_SOURCE_DIR}/source/amf-plane-copy.cpp"
+    "${PROJECT_SOURCE_DIR}/source/amf-shared-input.cpp"
+    "${PROJECT_SOURCE_DIR}/source/amf-statistics.cpp"
+    "${PROJECT_SOURCE_DIR}/source/amf-surface-pool.cpp"
+    "${PROJECT_SOURCE_DIR}/source/amf-telemetry.cpp"
+    "${PROJECT_SOURCE_DIR}/source/amf-wait.cpp"
     "${PROJECT_SOURCE_DIR}/source/enc-h265.cpp"
     "${PROJECT_SOURCE_DIR}/source/api-base.cpp"
     "${PROJECT_SOURCE_DIR}/source/api-host.cpp"
@@ -438,3 +461,9 @@ endif()
 
 # Sub Project
 add_subdirectory(amf-test)
+add_subdirectory(amf-bench)
+
+option(ENABLE_AMF_STUB "Build the host-memory stand-in AMF runtime (amf-stub)" OFF)
+if(ENABLE_AMF_STUB)
+  add_subdirectory(amf-stub)
+endif()
@@ -0,0 +1,99 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Plugin {
+	namespace AMD {
+		/// Small per-process thread pool that splits host frame uploads into horizontal bands.
+		///
+		/// Run() calls a job once for every band index, on the calling thread and on up to the requested number of
+		/// helper threads, and returns once every call has returned. Helper threads are started on first use and
+		/// shared by all encoders, the pool lives as long as one of them holds a reference. One job runs at a time,
+		/// a caller that finds the pool busy does all of its bands itself instead of waiting.
+		class BandPool {
+			public:
+			static std::shared_ptr<BandPool> Instance();
+			~BandPool();
+
+			public: // Remove all Copy operators
+			BandPool(BandPool const&) = delete;
+			void operator=(BandPool const&) = delete;
+
+			template<typename T>
+			void Run(size_t count, size_t helpers, T& job)
+			{
+				RunJob(count, helpers, [](void* context, size_t index) { (*static_cast<T*>(context))(index); }, &job);
+			}
+
+			/// Upper limit for helper threads, one less than the number of hardware threads.
+			static size_t GetHelperLimit();
+
+			private:
+			BandPool();
+
+			void RunJob(size_t count, size_t helpers, void (*function)(void*, size_t), void* context);
+			void Work();
+			void HelperMain(size_t index);
+
+			std::mutex               m_RunLock; // Held by the caller of the current job.
+			std::mutex               m_Lock;
+			std::condition_variable  m_Signal;   // New job or shutdown.
+			std::condition_variable  m_Finished; // A helper finished its part.
+			std::vector<std::thread> m_Helpers;
+			bool                     m_Shutdown;
+
+			// Current job, guarded by m_Lock except for m_Next.
+			uint64_t            m_Generation;
+			void (*m_Function)(void*, size_t);
+			void*               m_Context;
+			size_t              m_Count;
+			size_t              m_HelpersWanted;
+			size_t              m_Active; // Helpers working on the current job.
+			std::atomic<size_t> m_Next;
+		};
+
+		/// Picks the number of bands for a frame.
+		///
+		/// Starts from the resolution and then follows the measured time of the work, so every band gets about
+		/// BAND_TARGET_TIME of it. Small frames stay on the calling thread, where waking helpers costs more than it
+		/// saves. Bands are never shorter than BAND_MINIMUM_ROWS rows.
+		class BandPlanner {
+			public:
+			BandPlanner();
+
+			void   Reset(uint32_t width, uint32_t height);
+			size_t GetBandCount(size_t maxHelpers);
+			/// Total time spent in all bands of the last frame, as if run on a single thread.
+			void Record(std::chrono::nanoseconds work);
+
+			private:
+			uint32_t m_Width, m_Height;
+			uint64_t m_AverageWork; // Nanoseconds, 0 until the first frame.
+		};
+	} // namespace AMD
+} // namespace Plugin
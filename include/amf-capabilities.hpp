@@ -18,10 +18,13 @@
  */
 
 #pragma once
+#include <chrono>
 #include <cinttypes>
-#include <list>
-#include <map>
-#include <tuple>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include "amf-encoder-h264.hpp"
 #include "amf-encoder-h265.hpp"
@@ -30,10 +33,28 @@
 #include "api-base.hpp"
 #include "plugin.hpp"
 
-#include <components\ComponentCaps.h>
+#include <components/ComponentCaps.h>
 
 namespace Plugin {
 	namespace AMD {
+		/// Capabilities of an encoder with default settings, used to limit the choices in the properties.
+		struct EncoderCaps {
+			std::vector<QualityPreset>     qualityPresets;
+			std::vector<Profile>           profiles;
+			std::vector<ProfileLevel>      profileLevels;
+			std::vector<CodingType>        codingTypes;
+			std::pair<uint64_t, uint64_t>  maximumReferenceFrames;
+			std::vector<RateControlMethod> rateControlMethods;
+			bool                           prePassModeSupported;
+			std::vector<PrePassMode>       prePassModes;
+			std::pair<uint64_t, uint64_t>  targetBitrate;
+			std::pair<uint64_t, uint64_t>  peakBitrate;
+			std::pair<uint64_t, uint64_t>  vbvBufferSize;
+
+			uint8_t                 bFramePattern; // H264
+			std::vector<H265::Tier> tiers;         // H265
+		};
+
 		class CapabilityManager {
 #pragma region Singleton
 			public:
@@ -53,9 +74,74 @@ namespace Plugin {
 			bool IsCodecSupported(AMD::Codec codec);
 			bool IsCodecSupportedByAPI(AMD::Codec codec, API::Type api);
 			bool IsCodecSupportedByAPIAdapter(AMD::Codec codec, API::Type api, API::Adapter adapter);
+			/// Tests all adapters at once, in the same order. Faster than asking for one after another, as every test
+			/// may take up to the test timeout.
+			std::vector<bool> IsCodecSupportedByAPIAdapters(AMD::Codec codec, API::Type api,
+															const std::vector<API::Adapter>& adapters);
+
+#ifndef LITE_OBS
+			/// Creates an encoder on first use, afterwards the same table is returned for the same adapter and codec.
+			std::shared_ptr<EncoderCaps> GetEncoderCaps(AMD::Codec codec, std::shared_ptr<API::IAPI> api,
+														API::Adapter adapter);
+#endif
 
 			private:
-			std::map<std::tuple<API::Type, API::Adapter, AMD::Codec>, bool> m_CapabilityMap;
+			struct CapabilityKey {
+				API::Type  api;
+				int32_t    idLow, idHigh;
+				AMD::Codec codec;
+
+				bool operator==(const CapabilityKey& other) const;
+			};
+			struct CapabilityKeyHash {
+				size_t operator()(const CapabilityKey& key) const;
+			};
+
+			enum class CapabilityState : uint8_t {
+				Untested,
+				Testing,
+				Cached,
+				Tested,
+				TimedOut,
+			};
+			// Filled in by the test thread, which outlives everything else if the driver hangs.
+			struct CapabilityTest {
+				std::mutex               lock;
+				std::condition_variable  signal;
+				bool                     done;
+				bool                     supported;
+				std::chrono::nanoseconds time;
+			};
+			struct Capability {
+				std::string                                    name; // Adapter name, ids may be reused.
+				bool                                           supported;
+				CapabilityState                                state;
+				std::chrono::nanoseconds                       time; // Duration of the test
+				std::shared_ptr<CapabilityTest>                test;
+				std::chrono::high_resolution_clock::time_point deadline;
+			};
+			struct EncoderCapsEntry {
+				std::string                  name; // Adapter name, ids may be reused.
+				std::once_flag               filled;
+				std::shared_ptr<EncoderCaps> caps;
+			};
+
+			// Starts the test unless the result is known, in which case it is stored in supported and nullptr returned.
+			std::shared_ptr<CapabilityTest> StartTest(AMD::Codec codec, API::Type api, const API::Adapter& adapter,
+													  std::chrono::high_resolution_clock::time_point& deadline,
+													  bool&                                           supported);
+			// Waits for a test started by StartTest() and records its result, changed is set if it is new.
+			bool FinishTest(AMD::Codec codec, API::Type api, const API::Adapter& adapter,
+							std::shared_ptr<CapabilityTest>                test,
+							std::chrono::high_resolution_clock::time_point deadline, bool& changed);
+
+			// Results of a previous start are only reused for the same runtime and plugin version.
+			void LoadCache();
+			void SaveCache();
+
+			std::mutex                                                                              m_Lock;
+			std::unordered_map<CapabilityKey, Capability, CapabilityKeyHash>                        m_Capabilities;
+			std::unordered_map<CapabilityKey, std::shared_ptr<EncoderCapsEntry>, CapabilityKeyHash> m_EncoderCaps;
 		};
 	} // namespace AMD
 } // namespace Plugin
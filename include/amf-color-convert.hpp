@@ -0,0 +1,59 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#include <cinttypes>
+#include <cstddef>
+
+namespace Plugin {
+	namespace AMD {
+		enum class ColorFormat : uint8_t;
+		enum class ColorSpace : uint8_t;
+
+		/// Fixed point RGB to YCbCr matrix with 14 fractional bits, in the byte order of the source pixels.
+		struct ColorMatrix {
+			int16_t y[4], u[4], v[4]; // The fourth entry belongs to the alpha channel and is always 0.
+			int32_t yBias, cBias;     // Offset and rounding, yBias at 14 and cBias at 16 fractional bits.
+		};
+
+		/// Converts packed 8-bit RGBA or BGRA frames to NV12 on the CPU.
+		///
+		/// Writes straight into the planes of an encoder input surface, which makes the AMF converter and the
+		/// intermediate RGB surface unnecessary. Chroma is the average of each 2x2 block, odd edges repeat the
+		/// last row or column. The SSE2 kernel converts eight pixels of two rows at once and produces the same
+		/// result as the scalar one.
+		class HostColorConverter {
+			public:
+			HostColorConverter(ColorFormat format, ColorSpace space, bool fullRange);
+
+			void Convert(const uint8_t* src, size_t srcPitch, uint8_t* dstY, size_t dstYPitch, uint8_t* dstUV,
+						 size_t dstUVPitch, size_t width, size_t height);
+			/// Same as Convert without SIMD.
+			void ConvertScalar(const uint8_t* src, size_t srcPitch, uint8_t* dstY, size_t dstYPitch,
+							   uint8_t* dstUV, size_t dstUVPitch, size_t width, size_t height);
+
+			static bool        IsFormatSupported(ColorFormat format);
+			static bool        IsVectorized();
+			static const char* GetKernelName();
+
+			private:
+			ColorMatrix m_Matrix;
+		};
+	} // namespace AMD
+} // namespace Plugin
@@ -0,0 +1,74 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#include <cinttypes>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include "amf.hpp"
+#include "api-base.hpp"
+#include "plugin.hpp"
+
+#include <core/Context.h>
+
+namespace Plugin {
+	namespace AMD {
+		/// Device and AMF context of a single adapter, shared by every encoder running on it.
+		///
+		/// Acquire() hands out the context that already exists for the adapter, or creates one if the last user
+		/// released it. Creating the device and context happens outside of the registry lock, so a slow or hung
+		/// driver only holds up encoders on the same adapter. The AMF context itself is thread-safe, but the
+		/// OpenCL queue behind GetCompute() is not, so users of the queue must hold GetComputeLock().
+		class SharedContext {
+			public:
+			static std::shared_ptr<SharedContext> Acquire(std::shared_ptr<API::IAPI> api, API::Adapter adapter);
+
+			SharedContext(std::shared_ptr<API::IAPI> api, API::Adapter adapter);
+			~SharedContext();
+
+			public: // Remove all Copy operators
+			SharedContext(SharedContext const&) = delete;
+			void operator=(SharedContext const&) = delete;
+
+			/// The API and adapter may differ from the requested ones for APIs that AMF can not use directly.
+			std::shared_ptr<API::IAPI>     GetAPI();
+			API::Adapter                   GetAdapter();
+			std::shared_ptr<API::Instance> GetDevice();
+			amf::AMFContextPtr             GetContext();
+			amf::AMF_MEMORY_TYPE           GetMemoryType();
+
+			/// Initializes OpenCL on the first call, later calls return the same result.
+			AMF_RESULT  InitOpenCL();
+			std::mutex& GetComputeLock();
+
+			private:
+			std::shared_ptr<API::IAPI>     m_API;
+			API::Adapter                   m_Adapter;
+			std::shared_ptr<API::Instance> m_Device;
+			amf::AMFContextPtr             m_Context;
+			amf::AMF_MEMORY_TYPE           m_MemoryType;
+
+			std::mutex m_ComputeLock;
+			bool       m_OpenCLInitialized;
+			AMF_RESULT m_OpenCLResult;
+		};
+	} // namespace AMD
+} // namespace Plugin
@@ -0,0 +1,47 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "amf-encoder.hpp"
+
+namespace Plugin {
+	namespace AMD {
+		/// A started encoder kept in reserve, so that the next encoder with the same settings starts instantly.
+		///
+		/// Only the settings used last are kept. Prepare() builds the standby on a background thread, replacing
+		/// one with different settings, and Take() hands it out if the signature matches, waiting a bounded time for
+		/// it if it is still being built. The standby holds an encoder session on the adapter while it waits.
+		class EncoderPool {
+			public:
+			static std::unique_ptr<Encoder> Take(const std::string& signature);
+			static void Prepare(const std::string& signature, std::function<std::unique_ptr<Encoder>()> factory);
+			/// Destroys the standby and waits for a standby that is still being built.
+			static void Clear();
+
+			private:
+			static void Build(uint64_t generation, std::function<std::unique_ptr<Encoder>()> factory);
+			static void Destroy(std::unique_ptr<Encoder> encoder);
+		};
+	} // namespace AMD
+} // namespace Plugin
@@ -18,13 +18,28 @@
  */
 
 #pragma once
+#include <atomic>
 #include <chrono>
 #include <cinttypes>
+#include <cmath>
 #include <condition_variable>
+#include <deque>
+#include <functional>
 #include <mutex>
 #include <queue>
+#include <string>
 #include <thread>
 #include <vector>
+#include "amf-band-pool.hpp"
+#include "amf-color-convert.hpp"
+#include "amf-context.hpp"
+#include "amf-plane-copy.hpp"
+#include "amf-queue.hpp"
+#include "amf-shared-input.hpp"
+#include "amf-statistics.hpp"
+#include "amf-surface-pool.hpp"
+#include "amf-telemetry.hpp"
+#include "amf-wait.hpp"
 #include "amf.hpp"
 #include "api-base.hpp"
 #include "plugin.hpp"
@@ -41,16 +56,7 @@ extern "C" {
 #pragma warning(pop)
 #endif
 
-#define AMF_TIMESTAMP_ALLOCATE L"TS_Allocate"
-#define AMF_TIME_ALLOCATE L"T_Allocate"
-#define AMF_TIMESTAMP_STORE L"TS_Store"
-#define AMF_TIME_STORE L"T_Store"
-#define AMF_TIMESTAMP_CONVERT L"TS_Convert"
-#define AMF_TIME_CONVERT L"T_Convert"
-#define AMF_TIMESTAMP_SUBMIT L"TS_Submit"
-#define AMF_TIMESTAMP_QUERY L"TS_Query"
-#define AMF_TIME_MAIN L"T_Main" // Time between Submit and Query
-
+// The only per-frame property, everything else is tracked in FrameTelemetry.
 #define AMF_PRESENT_TIMESTAMP L"PTS"
 
 namespace Plugin {
@@ -104,6 +110,10 @@ namespace Plugin {
 			BT2020,
 			SRGB,
 		};
+		enum class ColorConversion : uint8_t {
+			AMF,  // AMF video converter, on the GPU.
+			Host, // HostColorConverter, straight into the encoder input surface. RGBA and BGRA only.
+		};
 
 		// Properties
 		enum class Usage : uint8_t { Transcoding, UltraLowLatency, LowLatency, Webcam };
@@ -165,12 +175,52 @@ namespace Plugin {
 			Unknown3,
 		};
 
+		class PropertyTransaction;
+
 		class Encoder {
+			friend class PropertyTransaction;
+
 			protected:
 			Encoder(Codec codec, std::shared_ptr<API::IAPI> videoAPI, const API::Adapter& videoAdapter,
 					bool useOpenCLSubmission, bool useOpenCLConversion, ColorFormat colorFormat, ColorSpace colorSpace,
 					bool fullRangeColor, bool multiThreaded, size_t queueSize);
 
+			/// Encoder property access, goes through the open PropertyTransaction if there is one. Values the runtime
+			/// describes as read-only, of the wrong type or out of range are rejected right away, even inside a
+			/// transaction. Outside of a transaction a value equal to the one last sent is not sent again. Getters
+			/// return the value the runtime reported after it was last sent, and only ask the runtime for properties
+			/// that were never set. Values the encoder produces, like the extra data, are read from m_AMFEncoder.
+			/// Not synchronized, the encoder belongs to one thread at a time like the rest of its settings.
+			AMF_RESULT SetEncoderProperty(const wchar_t* name, const amf::AMFVariant& value);
+			AMF_RESULT GetEncoderProperty(const wchar_t* name, amf::AMFVariant* value);
+			template<typename T>
+			AMF_RESULT SetEncoderProperty(const wchar_t* name, const T& value)
+			{
+				return SetEncoderProperty(name, amf::AMFVariant(value));
+			}
+			template<typename T>
+			AMF_RESULT GetEncoderProperty(const wchar_t* name, T* value)
+			{
+				amf::AMFVariant var;
+				AMF_RESULT      res = GetEncoderProperty(name, &var);
+				if (res == AMF_OK)
+					*value = static_cast<T>(var);
+				return res;
+			}
+
+			private:
+			struct EncoderProperty {
+				const wchar_t*  name;    // Usually one of the AMF constants, see FindEncoderProperty().
+				amf::AMFVariant applied; // Value reported by the runtime.
+			};
+
+			EncoderProperty* FindEncoderProperty(const wchar_t* name);
+			AMF_RESULT       ValidateEncoderProperty(const wchar_t* name, const amf::AMFVariant& value);
+			bool             IsEncoderPropertyApplied(const wchar_t* name, const amf::AMFVariant& value);
+			AMF_RESULT       ApplyEncoderProperty(const wchar_t* name, const amf::AMFVariant& value);
+			void             ReadBackEncoderProperty(EncoderProperty& prop);
+			void             ReadBackEncoderProperties();
+
 			public:
 			virtual ~Encoder();
 
@@ -208,6 +258,26 @@ namespace Plugin {
 			void SetDebug(bool v);
 			bool IsDebug();
 
+			void         SetWaitStrategy(WaitStrategy v);
+			WaitStrategy GetWaitStrategy();
+
+			/// Helper threads for splitting host uploads of large frames into bands, 0 keeps them on the OBS thread.
+			void   SetMaxHelperThreads(size_t v);
+			size_t GetMaxHelperThreads();
+
+			/// Falls back to the AMF converter for unsupported formats and OpenCL transfer. Only before Start().
+			void            SetColorConversion(ColorConversion v);
+			ColorConversion GetColorConversion();
+
+			/// Number of Encode() calls a returned packet stays valid for, at least 1. Only before Start().
+			void   SetPacketRetention(size_t v);
+			size_t GetPacketRetention();
+
+			/// Synthetic frames encoded and thrown away in Start(), so the hardware is awake for the first real
+			/// frame. 0 disables the pre-roll. Only before Start().
+			void     SetPreRollFrames(uint32_t v);
+			uint32_t GetPreRollFrames();
+
 //bool Initialize();
 #pragma endregion Initialization
 
@@ -349,11 +419,32 @@ namespace Plugin {
 			void Start();
 			void Restart();
 			void Stop();
+			/// Changes resolution and frame rate while running, without creating a new encoder. Packets still in
+			/// flight go to the callback, or without one are returned by the next Encode() calls ahead of the new
+			/// stream. The first frame of the new stream is an IDR frame with new extra data.
+			void Reconfigure(std::pair<uint32_t, uint32_t> resolution, std::pair<uint32_t, uint32_t> frameRate,
+							 std::function<void(struct encoder_packet*)> callback);
 
 			bool         IsStarted();
 			virtual void LogProperties() = 0;
 
+			/// Take frames converted by other encoders on the adapter that read the same video output, and share
+			/// the ones converted here. Also possible while running, but never during Encode().
+			void SetInputSource(video_t* v);
+
 			bool Encode(struct encoder_frame* f, struct encoder_packet* p, bool* b);
+			/// Ends the stream and hands every remaining packet to the callback (which may be empty).
+			/// Returns false if the encoder did not finish within the timeout. Must be followed by Stop() or Restart().
+			bool Drain(std::function<void(struct encoder_packet*)> callback, std::chrono::nanoseconds timeout);
+			/// Time spent waiting for the encoder during the last Encode() call.
+			std::chrono::nanoseconds GetFrameWaitTime();
+			/// Latency percentiles of a pipeline stage since Start().
+			LatencySummary GetLatencySummary(EncoderStage stage);
+			/// Frames that went to the encoder without passing through the AMF converter.
+			uint64_t GetConverterSkippedCount();
+			/// Frames dropped since Start() because the encoder could not keep up.
+			uint64_t GetDroppedFrameCount();
+
 			void GetVideoInfo(struct video_scale_info* info);
 			bool GetExtraData(uint8_t** extra_data, size_t* size);
 #pragma endregion Control
@@ -366,11 +457,28 @@ namespace Plugin {
 			virtual AMF_RESULT  GetExtraDataInternal(amf::AMFVariant* p)                                = 0;
 			virtual std::string HandleTypeOverride(amf::AMFSurfacePtr& d, uint64_t index)               = 0;
 
-			bool EncodeAllocate(OUT amf::AMFSurfacePtr& surface);
+			void LogStatistics();
+			void CreateConverter();
+			void CreateSurfacePool();
+			void SubscribeInput();
+			void PreRoll();
+
+			bool IsHostFrameWrappable(IN struct encoder_frame* frame, OUT int32_t& hPitch, OUT int32_t& vPitch);
+
+			void StoreHostFrame(IN amf::AMFSurfacePtr& surface, IN struct encoder_frame* frame);
+			/// Timestamps and picture type of the frame, returns the printable type.
+			std::string StampFrame(IN amf::AMFSurfacePtr& surface, IN struct encoder_frame* frame);
+
+			bool EncodeAllocate(OUT amf::AMFSurfacePtr& surface, IN struct encoder_frame* frame);
 			bool EncodeStore(OUT amf::AMFSurfacePtr& surface, IN struct encoder_frame* frame);
-			bool EncodeConvert(IN amf::AMFSurfacePtr& surface, OUT amf::AMFDataPtr& data);
+			bool EncodeConvert(IN amf::AMFSurfacePtr& surface, OUT amf::AMFDataPtr& data,
+							   IN struct encoder_frame* frame);
 			bool EncodeMain(IN amf::AMFDataPtr& data, OUT amf::AMFDataPtr& packet);
+			bool EncodeQueue(IN amf::AMFDataPtr& data, OUT amf::AMFDataPtr& packet);
+			/// Keeps the keyframe and parameter set requests of a frame that is dropped for the next frame.
+			void CarryRequests(IN amf::AMFDataPtr& data);
 			bool EncodeLoad(IN amf::AMFDataPtr& data, OUT struct encoder_packet* packet, OUT bool* received_packet);
+			void HoldPacket(IN struct encoder_packet* packet);
 
 			static int32_t AsyncSendMain(Encoder* obj);
 			int32_t        AsyncSendLocalMain();
@@ -390,30 +498,60 @@ namespace Plugin {
 			amf::AMF_MEMORY_TYPE    m_AMFMemoryType;
 			amf::AMF_SURFACE_FORMAT m_AMFSurfaceFormat;
 
+			/// Properties
+			std::vector<EncoderProperty> m_Properties; // Sent or read since the last (re-)initialization.
+			PropertyTransaction*         m_Transaction;
+
 			// API Related
+			std::shared_ptr<SharedContext> m_SharedContext; // Owns device and context of the adapter.
 			std::shared_ptr<API::IAPI>     m_API;
 			API::Adapter                   m_APIAdapter;
 			std::shared_ptr<API::Instance> m_APIDevice;
+			std::shared_ptr<SharedInput>   m_SharedInput; // Only while started with an input source.
+			const void*                    m_InputSource; // video_t
 
 			// Buffers
-			std::vector<uint8_t> m_PacketDataBuffer;
-			std::vector<uint8_t> m_ExtraDataBuffer;
+			std::vector<uint8_t>                m_PacketDataBuffer; // Only for packets not in host memory.
+			std::vector<amf::AMFBufferPtr>      m_PacketRetention;  // Buffers backing the last returned packets.
+			size_t                              m_PacketRetentionIndex;
+			std::vector<uint8_t>                m_ExtraDataBuffer;
+			std::shared_ptr<SurfacePool>        m_SurfacePool; // Host surfaces for non-OpenCL submission.
+			HostFrameObserver                   m_HostFrameObserver;
+			std::unique_ptr<HostColorConverter> m_HostConverter; // Only while converting on the CPU.
+#ifndef LITE_OBS
+			// Packets of the stream before a reconfiguration, with their own copy of the data.
+			std::deque<std::pair<struct encoder_packet, std::vector<uint8_t>>> m_HeldPackets;
+#endif
+			struct UploadBand {
+				uint8_t  plane;
+				uint32_t row, rows;
+				uint64_t time; // Nanoseconds
+			};
+			std::vector<UploadBand>   m_UploadBands;
+			std::shared_ptr<BandPool> m_BandPool; // Only for non-OpenCL submission.
+			BandPlanner               m_BandPlanner;
+			size_t                    m_MaxHelperThreads;
 
 			// Flags
 			bool m_Initialized;
 			bool m_Started;
 			bool m_OpenCL;
-			bool m_OpenCLSubmission; // Submit Frames using OpenCL
-			bool m_OpenCLConversion; // Convert Frames using OpenCL instead of DirectCompute
+			bool m_OpenCLSubmission;  // Submit Frames using OpenCL
+			bool m_OpenCLConversion;  // Convert Frames using OpenCL instead of DirectCompute
+			bool m_HostFrameWrapping; // Submit OBS frame memory directly if the layout allows it.
+			bool m_HostFrameWrapped;  // Current frame is submitted directly.
+			bool m_StreamingCopy;     // Frames exceed the last level cache, copy planes with non-temporal stores.
 			bool m_Debug;
 
 			// Properties
-			uint64_t    m_UniqueId;
-			Codec       m_Codec;
-			ColorFormat m_ColorFormat;
-			ColorSpace  m_ColorSpace;
-			bool        m_FullColorRange;
-			size_t      m_QueueSize;
+			uint64_t        m_UniqueId;
+			Codec           m_Codec;
+			ColorFormat     m_ColorFormat;
+			ColorSpace      m_ColorSpace;
+			bool            m_FullColorRange;
+			ColorConversion m_ColorConversion;
+			size_t          m_QueueSize;
+			uint32_t        m_PreRollFrames;
 
 			/// Resolution + Rate
 			std::pair<uint32_t, uint32_t> m_Resolution;
@@ -421,17 +559,34 @@ namespace Plugin {
 			double_t                      m_FrameRateFraction;
 
 			/// Timings
-			double_t                 m_TimestampStep;
-			uint64_t                 m_TimestampStepRounded;
-			uint64_t                 m_TimestampOffset;
-			std::chrono::nanoseconds m_SubmitQueryWaitTimer;
-			uint64_t                 m_SubmitQueryAttempts;
-			uint64_t                 m_InitialFrameLatency;
+			double_t                        m_TimestampStep;
+			uint64_t                        m_TimestampStepRounded;
+			uint64_t                        m_TimestampOffset;
+			std::chrono::nanoseconds        m_SubmitQueryWaitTimer;
+			uint64_t                        m_SubmitQueryAttempts;
+			uint64_t                        m_InitialFrameLatency;
+			WaitStrategy                    m_WaitStrategy;
+			WaitEvent                       m_WaitEvent; // Signaled by the workers when the OBS thread can progress.
+			std::chrono::nanoseconds        m_FrameWaitTime;
+			std::chrono::nanoseconds        m_TotalWaitTime;
+			uint64_t                        m_EncodedFrameCount;
+			EncoderStatistics               m_Statistics;
+			std::unique_ptr<FrameTelemetry> m_Telemetry;
 
 			/// Status
-			uint64_t m_SubmittedFrameCount;
-			bool     m_InitialFramesSent;
+			uint64_t m_WrappedFrameCount;
+			uint64_t m_CopiedFrameCount;
+			uint64_t m_ConverterSkippedCount; // Frames submitted without the AMF converter.
+			uint64_t m_SharedFrameCount;      // Frames converted by another encoder.
 			bool     m_InitialPacketRetrieved;
+			uint64_t m_QueuedFrameCount;  // Frames handed to the send worker.
+			uint64_t m_DroppedFrameCount; // Frames dropped because the send queue was full.
+			// Written by the submitting thread, read by the OBS thread.
+			alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_SubmittedFrameCount;
+			// Written by both the submitting and the OBS thread.
+			alignas(CACHE_LINE_SIZE) std::atomic<bool> m_InitialFramesSent;
+			// Keyframe and parameter set requests of dropped frames, applied to the next queued frame.
+			std::vector<std::pair<const wchar_t*, amf::AMFVariant>> m_CarriedRequests;
 
 			/// Periods
 			uint32_t m_PeriodIDR;
@@ -440,19 +595,21 @@ namespace Plugin {
 			uint32_t m_PeriodBFrame;
 			uint32_t m_FrameSkipPeriod;
 			bool     m_FrameSkipKeepOnlyNth; // false = drop every xth frame, true = drop all but every xth frame
+			bool     m_ForceIDR;             // Next frame starts a new stream and carries the parameter sets.
 
 			/// Multi-Threading
 			bool m_MultiThreading;
 			struct EncoderThreadingData {
+				EncoderThreadingData(size_t queueSize) : shutdown(false), queue(queueSize) {}
+
 				// Thread
-				std::thread worker;
-				bool        shutdown;
-				// Semaphore
-				size_t                  wakeupcount = 0;
-				std::condition_variable condvar;
-				std::mutex              mutex;
-				// Data
-				amf::AMFDataPtr data;
+				std::thread       worker;
+				std::atomic<bool> shutdown;
+				std::atomic<bool> eof = false; // Encoder reported the end of a drained stream.
+				// Signaled when the encoder may have made progress or the queue changed.
+				WaitEvent event;
+				// Data, OBS thread to send worker or retrieve worker to OBS thread.
+				SPSCQueue<amf::AMFDataPtr> queue;
 			} * m_AsyncSend, *m_AsyncRetrieve;
 		};
 	} // namespace AMD
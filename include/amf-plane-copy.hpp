@@ -0,0 +1,55 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#include <cinttypes>
+#include <cstddef>
+
+namespace Plugin {
+	namespace AMD {
+		enum class PlaneCopyKernel : uint8_t {
+			Scalar, // One memcpy per row.
+			SSE2,
+			AVX2,
+		};
+
+		/// Copies the visible part of an image plane between two buffers with different row pitch.
+		///
+		/// Only rowSize bytes of each row are touched, padding in either buffer is left alone. Small frames are
+		/// copied with memcpy so the destination stays in cache for the next stage. Frames larger than the last
+		/// level cache would only evict useful data on the way, so those use SIMD non-temporal stores that bypass
+		/// the cache instead. The best kernel supported by the CPU is picked once at runtime.
+		class PlaneCopy {
+			public:
+			static void Copy(uint8_t* dst, size_t dstPitch, const uint8_t* src, size_t srcPitch, size_t rowSize,
+							 size_t rows, bool streaming);
+			/// Same as Copy with a specific kernel, falls back to Scalar if the CPU does not support it.
+			static void Copy(PlaneCopyKernel kernel, uint8_t* dst, size_t dstPitch, const uint8_t* src,
+							 size_t srcPitch, size_t rowSize, size_t rows, bool streaming);
+
+			/// True if a frame of this many bytes should be copied with non-temporal stores.
+			static bool IsStreamingWorthwhile(size_t frameSize);
+
+			static size_t          GetLastLevelCacheSize();
+			static PlaneCopyKernel GetKernel();
+			static bool            IsKernelSupported(PlaneCopyKernel kernel);
+			static const char*     GetKernelName(PlaneCopyKernel kernel);
+		};
+	} // namespace AMD
+} // namespace Plugin
@@ -0,0 +1,59 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#include <cwchar>
+#include <utility>
+#include <vector>
+#include "amf-encoder.hpp"
+
+namespace Plugin {
+	namespace AMD {
+		/// Collects the encoder properties set while it is open, and sends only those that differ from the value
+		/// last applied once committed.
+		///
+		/// Getters of the encoder see the collected values right away, so setters that depend on other properties
+		/// keep working. Commit() sends properties that reset or constrain others (usage, preset, profile, level
+		/// and rate control method) first, and everything else in the order it was first set. Only one transaction
+		/// can be open per encoder. Commit() closes it, uncommitted values are discarded when it is destroyed.
+		class PropertyTransaction {
+			public:
+			explicit PropertyTransaction(Encoder* encoder);
+			~PropertyTransaction();
+
+			public: // Remove all Copy operators
+			PropertyTransaction(PropertyTransaction const&) = delete;
+			void operator=(PropertyTransaction const&) = delete;
+
+			/// Returns the number of properties that were sent to the encoder. Properties the runtime refuses do not
+			/// stop the others from being sent, but are reported with an exception afterwards.
+			size_t Commit();
+
+			private:
+			friend class Encoder;
+
+			void Detach();
+			void Record(const wchar_t* name, const amf::AMFVariant& value);
+			bool Find(const wchar_t* name, amf::AMFVariant* value);
+
+			Encoder*                                                m_Encoder;
+			std::vector<std::pair<const wchar_t*, amf::AMFVariant>> m_Values; // In the order first set.
+		};
+	} // namespace AMD
+} // namespace Plugin
@@ -0,0 +1,132 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#include <atomic>
+#include <cinttypes>
+#include <stdexcept>
+#include <vector>
+
+// Size used to keep data written by different threads on separate cache lines.
+#define CACHE_LINE_SIZE 64
+
+namespace Plugin {
+	namespace AMD {
+		/// Bounded lock-free ring for exactly one producer and one consumer thread.
+		///
+		/// The producer only writes the tail and the consumer only writes the head, each on its own cache line.
+		/// Both sides keep a cached copy of the other index, so the shared line is only read when the ring looks
+		/// full or empty. Capacity is rounded up to the next power of two.
+		template<typename T>
+		class SPSCQueue {
+			public:
+			explicit SPSCQueue(size_t capacity)
+			{
+				if (capacity == 0)
+					throw std::invalid_argument("capacity");
+
+				size_t size = 1;
+				while (size < capacity)
+					size <<= 1;
+
+				m_Buffer.resize(size);
+				m_Mask       = size - 1;
+				m_Head       = 0;
+				m_Tail       = 0;
+				m_CachedHead = 0;
+				m_CachedTail = 0;
+			}
+
+			public: // Remove all Copy operators
+			SPSCQueue(SPSCQueue const&) = delete;
+			void operator=(SPSCQueue const&) = delete;
+
+			/// Producer only. Returns false if the ring is full.
+			bool Push(const T& value)
+			{
+				size_t tail = m_Tail.load(std::memory_order_relaxed);
+				if ((tail - m_CachedHead) > m_Mask) {
+					m_CachedHead = m_Head.load(std::memory_order_acquire);
+					if ((tail - m_CachedHead) > m_Mask)
+						return false;
+				}
+
+				m_Buffer[tail & m_Mask] = value;
+				m_Tail.store(tail + 1, std::memory_order_release);
+				return true;
+			}
+
+			/// Consumer only. Returns false if the ring is empty.
+			bool Pop(T& value)
+			{
+				size_t head = m_Head.load(std::memory_order_relaxed);
+				if (head == m_CachedTail) {
+					m_CachedTail = m_Tail.load(std::memory_order_acquire);
+					if (head == m_CachedTail)
+						return false;
+				}
+
+				value                   = m_Buffer[head & m_Mask];
+				m_Buffer[head & m_Mask] = T();
+				m_Head.store(head + 1, std::memory_order_release);
+				return true;
+			}
+
+			/// Consumer only. Returns a pointer to the oldest element without removing it, or nullptr.
+			T* Peek()
+			{
+				size_t head = m_Head.load(std::memory_order_relaxed);
+				if (head == m_CachedTail) {
+					m_CachedTail = m_Tail.load(std::memory_order_acquire);
+					if (head == m_CachedTail)
+						return nullptr;
+				}
+				return &m_Buffer[head & m_Mask];
+			}
+
+			/// Approximate when called while either side is active.
+			size_t Size()
+			{
+				return m_Tail.load(std::memory_order_acquire) - m_Head.load(std::memory_order_acquire);
+			}
+
+			bool Empty()
+			{
+				return Size() == 0;
+			}
+
+			size_t Capacity()
+			{
+				return m_Buffer.size();
+			}
+
+			private:
+			std::vector<T> m_Buffer;
+			size_t         m_Mask;
+
+			// Consumer
+			alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_Head;
+			size_t m_CachedTail;
+
+			// Producer
+			alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_Tail;
+			size_t m_CachedHead;
+		};
+	} // namespace AMD
+} // namespace Plugin
@@ -0,0 +1,93 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#include <chrono>
+#include <cinttypes>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include "amf-context.hpp"
+#include "plugin.hpp"
+
+#include <core/Surface.h>
+
+namespace Plugin {
+	namespace AMD {
+		/// Everything that decides what the converted NV12 frames of an encoder look like.
+		struct SharedInputFormat {
+			const void*             source; // OBS video output the frames come from.
+			amf::AMF_SURFACE_FORMAT format; // Format before conversion.
+			uint32_t                colorSpace; // ColorSpace
+			bool                    fullRange;
+			uint32_t                width, height;
+
+			bool operator<(const SharedInputFormat& other) const;
+		};
+
+		/// Converted input frames of one video output, shared by every running encoder on the same adapter.
+		///
+		/// Whichever subscriber sees a frame first uploads and converts it and then publishes the NV12 surface.
+		/// Everyone else receives their own surface on top of the same memory, so timestamps and picture type
+		/// overrides stay per encoder while the surface is kept alive until the last one is done with it. A
+		/// published frame is dropped once all other subscribers took it, or once it falls out of the history.
+		class SharedInput {
+			public:
+			static std::shared_ptr<SharedInput> Acquire(std::shared_ptr<SharedContext> context,
+														 const SharedInputFormat&       format);
+
+			SharedInput(std::shared_ptr<SharedContext> context, const SharedInputFormat& format);
+			~SharedInput();
+
+			public: // Remove all Copy operators
+			SharedInput(SharedInput const&) = delete;
+			void operator=(SharedInput const&) = delete;
+
+			void   Subscribe();
+			void   Unsubscribe();
+			size_t GetSubscriberCount();
+
+			/// True with a surface for the frame if another subscriber converted it already. Otherwise the caller
+			/// is now converting it and must follow up with Publish() or Abandon().
+			bool Claim(uint64_t frame, amf::AMFDataPtr& data);
+			/// The owner of the surface memory, such as a SurfacePool, is kept alive while the frame is in use.
+			void Publish(uint64_t frame, amf::AMFDataPtr& data, std::shared_ptr<void> owner);
+			void Abandon(uint64_t frame);
+
+			private:
+			AMF_RESULT Reference(amf::AMFDataPtr& data, std::shared_ptr<void> owner, amf::AMFDataPtr& reference);
+
+			struct Frame {
+				amf::AMFDataPtr       data; // nullptr while the producer is still converting.
+				std::shared_ptr<void> owner;
+				size_t                remaining;
+			};
+
+			std::shared_ptr<SharedContext> m_Context;
+			SharedInputFormat              m_Format;
+
+			std::mutex                m_Lock;
+			std::condition_variable   m_Published;
+			std::map<uint64_t, Frame> m_Frames;
+			size_t                    m_Subscribers;
+		};
+	} // namespace AMD
+} // namespace Plugin
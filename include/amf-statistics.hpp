@@ -0,0 +1,98 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+
+namespace Plugin {
+	namespace AMD {
+		enum class EncoderStage : uint8_t {
+			Allocate,
+			Store,
+			Convert,
+			Main, // Between SubmitInput and QueryOutput.
+			Load,
+			Wait, // Time the OBS thread spent waiting for the encoder.
+
+			_Count,
+		};
+
+		struct LatencySummary {
+			uint64_t count;
+			uint64_t p50, p90, p99, max; // Nanoseconds
+		};
+
+		/// Log-linear latency histogram.
+		///
+		/// Each power of two is split into 16 linear buckets, so every value is recorded with at most 6.25% error
+		/// and the full 64-bit range fits into a fixed array. Recording is a couple of relaxed atomic increments and
+		/// safe from any thread; reading while recording gives a slightly inconsistent but usable snapshot.
+		class LatencyHistogram {
+			public:
+			LatencyHistogram();
+
+			void Record(uint64_t value);
+			void Reset();
+
+			uint64_t GetCount();
+			uint64_t GetMax();
+			/// Upper bound of the bucket containing the given percentile (0 - 100), or 0 without samples.
+			uint64_t GetPercentile(double_t percentile);
+
+			LatencySummary GetSummary();
+
+			private:
+			static size_t   BucketIndex(uint64_t value);
+			static uint64_t BucketUpperBound(size_t index);
+
+			static const size_t SubBucketBits  = 4;
+			static const size_t SubBucketCount = 1 << SubBucketBits;
+			static const size_t BucketCount    = (64 - SubBucketBits + 1) * SubBucketCount;
+
+			std::array<std::atomic<uint64_t>, BucketCount> m_Buckets;
+			std::atomic<uint64_t>                          m_Count;
+			std::atomic<uint64_t>                          m_Max;
+		};
+
+		/// Latency histograms for every encoder stage, plus a timer for the periodic summary.
+		class EncoderStatistics {
+			public:
+			EncoderStatistics();
+
+			void Record(EncoderStage stage, std::chrono::nanoseconds time);
+			void Reset();
+
+			LatencySummary GetSummary(EncoderStage stage);
+
+			/// True once per interval, for whichever caller gets there first.
+			bool IsSummaryDue();
+			void SetSummaryInterval(std::chrono::seconds interval);
+
+			private:
+			std::array<LatencyHistogram, (size_t)EncoderStage::_Count> m_Stages;
+
+			std::chrono::nanoseconds m_SummaryInterval;
+			std::atomic<int64_t>     m_NextSummary; // high_resolution_clock, nanoseconds since epoch
+		};
+	} // namespace AMD
+} // namespace Plugin
@@ -0,0 +1,122 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#include <atomic>
+#include <cinttypes>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "plugin.hpp"
+
+#include <core/Context.h>
+#include <core/Surface.h>
+
+namespace Plugin {
+	namespace AMD {
+		struct SurfacePoolStatistics {
+			uint64_t hits;        // Acquisitions served from a free slot.
+			uint64_t misses;      // Acquisitions that had to fall back to AllocSurface.
+			size_t   capacity;    // Number of slots in the pool.
+			size_t   outstanding; // Slots currently held by AMF.
+			size_t   highwater;   // Largest number of slots held at the same time.
+		};
+
+		/// Fixed-size ring of host memory surfaces.
+		///
+		/// Each slot owns a pitched host allocation large enough for one frame. Acquire() wraps a free slot with
+		/// CreateSurfaceFromHostNative and registers the slot as the surface observer, so it is handed back as soon
+		/// as AMF releases the surface data. If every slot is in use, Acquire() falls back to AllocSurface and counts
+		/// a miss. Only AMF_MEMORY_HOST is supported, which also keeps the pool independent of the API.
+		///
+		/// A slot in use holds a reference to the storage of the pool, so surfaces may outlive the pool itself.
+		class SurfacePool {
+			public:
+			SurfacePool(amf::AMFContext* context, amf::AMF_SURFACE_FORMAT format, uint32_t width, uint32_t height,
+						size_t capacity);
+			~SurfacePool();
+
+			public: // Remove all Copy operators
+			SurfacePool(SurfacePool const&) = delete;
+			void operator=(SurfacePool const&) = delete;
+
+			AMF_RESULT Acquire(amf::AMFSurface** surface);
+
+			SurfacePoolStatistics GetStatistics();
+
+			amf::AMF_SURFACE_FORMAT       GetFormat();
+			std::pair<uint32_t, uint32_t> GetResolution();
+			size_t                        GetCapacity();
+
+			/// Pitch and size of a single slot for the given layout.
+			static void CalculateLayout(amf::AMF_SURFACE_FORMAT format, uint32_t width, uint32_t height,
+										int32_t& hPitch, int32_t& vPitch, size_t& size);
+
+			private:
+			struct Storage;
+
+			struct Slot : public amf::AMFSurfaceObserver {
+				virtual void AMF_STD_CALL OnSurfaceDataRelease(amf::AMFSurface* pSurface) override;
+
+				Storage*                 storage;
+				std::shared_ptr<Storage> owner; // Set while AMF uses the slot.
+				std::vector<uint8_t>     memory;
+				uint8_t*                 data;
+			};
+
+			struct Storage {
+				std::mutex         lock;
+				std::vector<Slot>  slots;
+				std::vector<Slot*> free;
+
+				uint64_t hits;
+				uint64_t misses;
+				size_t   highwater;
+			};
+
+			amf::AMFContext*        m_Context;
+			amf::AMF_SURFACE_FORMAT m_Format;
+			uint32_t                m_Width;
+			uint32_t                m_Height;
+			int32_t                 m_HPitch;
+			int32_t                 m_VPitch;
+			size_t                  m_SlotSize;
+
+			std::shared_ptr<Storage> m_Storage;
+		};
+
+		/// Tracks whether a surface wrapping foreign host memory still references it.
+		///
+		/// Used for surfaces created directly on top of OBS frame memory, which is only valid for the duration of
+		/// a single encode call. Reset() before wrapping, then check IsReleased() before giving the memory back.
+		class HostFrameObserver : public amf::AMFSurfaceObserver {
+			public:
+			HostFrameObserver();
+
+			void Reset();
+			bool IsReleased();
+
+			protected:
+			virtual void AMF_STD_CALL OnSurfaceDataRelease(amf::AMFSurface* pSurface) override;
+
+			private:
+			std::atomic<bool> m_Released;
+		};
+	} // namespace AMD
+} // namespace Plugin
@@ -0,0 +1,75 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <memory>
+#include <vector>
+
+namespace Plugin {
+	namespace AMD {
+		enum class TelemetryField : uint8_t {
+			StartTimestamp,  // Encode() was called.
+			AllocateTime,    // Duration
+			StoreTime,       // Duration
+			ConvertTime,     // Duration
+			SubmitTimestamp, // SubmitInput succeeded.
+			QueryTimestamp,  // QueryOutput returned the packet.
+			LoadTime,        // Duration
+
+			_Count,
+		};
+
+		/// Per-frame bookkeeping for the encode pipeline.
+		///
+		/// A fixed-size ring with one column per field, indexed by the OBS presentation timestamp, which counts
+		/// frames and therefore doubles as the submit sequence number. Begin() claims the row of a frame, a row
+		/// that has since been claimed by a newer frame reads as missing instead of returning stale data.
+		///
+		/// Rows are written and read by different threads, but always in the order the frame travels through the
+		/// pipeline, so the queues between the stages provide the required ordering. Timestamps and durations are
+		/// in nanoseconds.
+		class FrameTelemetry {
+			public:
+			/// Capacity is rounded up to a power of two and must exceed the number of frames in flight.
+			explicit FrameTelemetry(size_t capacity);
+
+			public: // Remove all Copy operators
+			FrameTelemetry(FrameTelemetry const&) = delete;
+			void operator=(FrameTelemetry const&) = delete;
+
+			void Begin(int64_t pts);
+			bool Contains(int64_t pts);
+
+			void     Set(int64_t pts, TelemetryField field, uint64_t value);
+			uint64_t Get(int64_t pts, TelemetryField field); // 0 if the frame is no longer tracked.
+
+			size_t GetCapacity();
+
+			private:
+			size_t Row(int64_t pts);
+
+			size_t                                                            m_Mask;
+			std::unique_ptr<std::atomic<int64_t>[]>                           m_Pts;
+			std::array<std::vector<uint64_t>, (size_t)TelemetryField::_Count> m_Columns;
+		};
+	} // namespace AMD
+} // namespace Plugin
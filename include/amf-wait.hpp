@@ -0,0 +1,60 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <condition_variable>
+#include <mutex>
+
+namespace Plugin {
+	namespace AMD {
+		enum class WaitStrategy : uint8_t {
+			/// Sleep for the full wait interval between attempts.
+			Sleep,
+			/// Spin for a short while, then yield, then block on the event until notified or timed out.
+			Hybrid,
+		};
+
+		/// Wakeup event for the submit/query loops.
+		///
+		/// Polling loops call Wait() with an increasing attempt counter. Depending on the strategy and how long
+		/// the loop has been waiting, the call spins, yields or blocks until another thread calls Notify() or the
+		/// timeout expires. Notifications are counted, so a Notify() issued before Wait() is not lost.
+		class WaitEvent {
+			public:
+			WaitEvent();
+
+			void Notify();
+
+			/// Returns the time spent waiting.
+			std::chrono::nanoseconds Wait(WaitStrategy strategy, uint64_t attempt, std::chrono::nanoseconds timeout);
+			/// Wait() for loops that nobody notifies, sleeps where Wait() would block on the event.
+			std::chrono::nanoseconds Poll(WaitStrategy strategy, uint64_t attempt, std::chrono::nanoseconds timeout);
+
+			private:
+			bool Consume();
+
+			std::atomic<uint64_t>   m_Pending;
+			std::mutex              m_Lock;
+			std::condition_variable m_CondVar;
+		};
+	} // namespace AMD
+} // namespace Plugin
@@ -18,13 +18,16 @@
  */
 
 #pragma once
+#include <cstdlib>
 #include <memory>
+#include <mutex>
+#include <vector>
 #include "plugin.hpp"
 
-#include <components\Component.h>
-#include <components\ComponentCaps.h>
-#include <components\VideoEncoderVCE.h>
-#include <core\Factory.h>
+#include <components/Component.h>
+#include <components/ComponentCaps.h>
+#include <components/VideoEncoderVCE.h>
+#include <core/Factory.h>
 
 extern "C" {
 #if defined(WIN32) || defined(WIN64)
@@ -32,6 +35,9 @@ extern "C" {
 #endif
 }
 
+// Overrides the path of the AMF runtime library, for example to load the host-memory stand-in from amf-stub.
+#define AMF_RUNTIME_OVERRIDE_ENV "OBS_AMF_RUNTIME"
+
 namespace Plugin {
 	namespace AMD {
 		class AMF {
@@ -64,7 +70,7 @@ namespace Plugin {
 			uint32_t m_TimerPeriod; /// High-Precision Timer Accuracy (nanoseconds)
 
 			/// AMF Values
-			HMODULE  m_AMFModule;
+			void*    m_AMFModule;
 			uint64_t m_AMFVersion_Plugin;
 			uint64_t m_AMFVersion_Runtime;
 
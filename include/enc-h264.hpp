@@ -18,6 +18,8 @@
  */
 
 #pragma once
+#include <chrono>
+#include <string>
 #include "amf-encoder-h264.hpp"
 #include "plugin.hpp"
 
@@ -52,12 +54,26 @@ namespace Plugin {
 			void get_video_info(struct video_scale_info* info);
 			bool get_extra_data(uint8_t** extra_data, size_t* size);
 
+			private:
+			static std::unique_ptr<Plugin::AMD::EncoderH264>
+				CreateEncoder(obs_data_t* data, const struct video_output_info* voi, uint32_t width, uint32_t height);
+			static void ApplyDynamicProperties(Plugin::AMD::EncoderH264* encoder, obs_data_t* data);
+
+			/// Identifies encoders that a standby can replace, which requires identical static properties.
+			static std::string GetStandbySignature(obs_data_t* data, const struct video_output_info* voi,
+												   uint32_t width, uint32_t height);
+
 			//////////////////////////////////////////////////////////////////////////
 			// Storage
 			//////////////////////////////////////////////////////////////////////////
 			private:
 			std::unique_ptr<Plugin::AMD::EncoderH264> m_VideoEncoder;
 			obs_encoder_t*                            m_Encoder;
+
+			// Time to First Packet
+			std::chrono::high_resolution_clock::time_point m_CreateTime;
+			bool                                           m_WarmStart;
+			bool                                           m_FirstPacket;
 		};
 	} // namespace Interface
 } // namespace Plugin
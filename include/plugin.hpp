@@ -19,6 +19,7 @@
 
 #pragma once
 #include <inttypes.h>
+#include <stdexcept>
 #include "version.hpp"
 
 #ifndef LITE_OBS
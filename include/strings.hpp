@@ -132,6 +132,15 @@
 #define P_OPENCL_CONVERSION "OpenCL.Conversion"
 #define P_MULTITHREADING "MultiThreading"
 #define P_QUEUESIZE "QueueSize"
+#define P_WAITSTRATEGY "WaitStrategy"
+#define P_WAITSTRATEGY_SLEEP "WaitStrategy.Sleep"
+#define P_WAITSTRATEGY_HYBRID "WaitStrategy.Hybrid"
+#define P_COLORCONVERSION "ColorConversion"
+#define P_COLORCONVERSION_AMF "ColorConversion.AMF"
+#define P_COLORCONVERSION_HOST "ColorConversion.Host"
+#define P_HELPERTHREADS "HelperThreads"
+#define P_WARMSTANDBY "WarmStandby"
+#define P_PREROLL "PreRoll"
 #define P_DEBUG "Debug"
 
 #define P_VIEW "View"
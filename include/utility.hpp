@@ -109,6 +109,12 @@ namespace Utility {
 	const char* SliceModeToString(Plugin::AMD::H264::SliceMode v);
 	const char* SliceControlModeToString(Plugin::AMD::SliceControlMode v);
 
+	// Wait Strategy
+	const char* WaitStrategyToString(Plugin::AMD::WaitStrategy v);
+
+	// Color Conversion
+	const char* ColorConversionToString(Plugin::AMD::ColorConversion v);
+
 	Plugin::AMD::ProfileLevel H264ProfileLevel(std::pair<uint32_t, uint32_t> resolution,
 											   std::pair<uint32_t, uint32_t> frameRate);
 	Plugin::AMD::ProfileLevel H265ProfileLevel(std::pair<uint32_t, uint32_t> resolution,
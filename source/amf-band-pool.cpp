@@ -0,0 +1,172 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "amf-band-pool.hpp"
+#include <algorithm>
+
+// Work per band worth waking a helper for.
+#define BAND_TARGET_TIME std::chrono::microseconds(500)
+// Shortest band, shorter ones mostly add synchronization.
+#define BAND_MINIMUM_ROWS 64
+// Pixels per band assumed until the first frame was measured.
+#define BAND_INITIAL_PIXELS (1920 * 1080)
+
+using namespace Plugin;
+using namespace Plugin::AMD;
+
+std::shared_ptr<BandPool> Plugin::AMD::BandPool::Instance()
+{
+	static std::mutex              s_Lock;
+	static std::weak_ptr<BandPool> s_Instance;
+
+	const std::lock_guard<std::mutex> lock(s_Lock);
+	std::shared_ptr<BandPool>         pool = s_Instance.lock();
+	if (!pool) {
+		pool       = std::shared_ptr<BandPool>(new BandPool());
+		s_Instance = pool;
+	}
+	return pool;
+}
+
+Plugin::AMD::BandPool::BandPool()
+{
+	m_Shutdown      = false;
+	m_Generation    = 0;
+	m_Function      = nullptr;
+	m_Context       = nullptr;
+	m_Count         = 0;
+	m_HelpersWanted = 0;
+	m_Active        = 0;
+	m_Next          = 0;
+}
+
+Plugin::AMD::BandPool::~BandPool()
+{
+	{
+		const std::lock_guard<std::mutex> lock(m_Lock);
+		m_Shutdown = true;
+	}
+	m_Signal.notify_all();
+	for (std::thread& helper : m_Helpers)
+		helper.join();
+}
+
+size_t Plugin::AMD::BandPool::GetHelperLimit()
+{
+	unsigned int threads = std::thread::hardware_concurrency();
+	return (threads > 1) ? (size_t)threads - 1 : 0;
+}
+
+void Plugin::AMD::BandPool::RunJob(size_t count, size_t helpers, void (*function)(void*, size_t), void* context)
+{
+	if (count == 0)
+		return;
+	helpers = std::min({helpers, GetHelperLimit(), count - 1});
+
+	std::unique_lock<std::mutex> run(m_RunLock, std::defer_lock);
+	if ((count <= 1) || (helpers == 0) || !run.try_lock()) {
+		for (size_t index = 0; index < count; index++)
+			function(context, index);
+		return;
+	}
+
+	{
+		const std::lock_guard<std::mutex> lock(m_Lock);
+		while (m_Helpers.size() < helpers)
+			m_Helpers.emplace_back(&BandPool::HelperMain, this, m_Helpers.size());
+
+		m_Function      = function;
+		m_Context       = context;
+		m_Count         = count;
+		m_HelpersWanted = helpers;
+		m_Next.store(0, std::memory_order_relaxed);
+		m_Generation++;
+	}
+	m_Signal.notify_all();
+
+	Work();
+
+	// Helpers that picked up the job may still be inside a band.
+	std::unique_lock<std::mutex> lock(m_Lock);
+	m_Finished.wait(lock, [this] { return m_Active == 0; });
+	m_Function = nullptr;
+	m_Context  = nullptr;
+}
+
+void Plugin::AMD::BandPool::Work()
+{
+	for (size_t index = m_Next.fetch_add(1, std::memory_order_relaxed); index < m_Count;
+		 index        = m_Next.fetch_add(1, std::memory_order_relaxed)) {
+		m_Function(m_Context, index);
+	}
+}
+
+void Plugin::AMD::BandPool::HelperMain(size_t index)
+{
+	uint64_t                     generation = 0;
+	std::unique_lock<std::mutex> lock(m_Lock);
+	for (;;) {
+		m_Signal.wait(lock, [this, index, &generation] {
+			return m_Shutdown || ((m_Function != nullptr) && (m_Generation != generation) && (index < m_HelpersWanted));
+		});
+		if (m_Shutdown)
+			return;
+
+		generation = m_Generation;
+		m_Active++;
+		lock.unlock();
+		Work();
+		lock.lock();
+		if (--m_Active == 0)
+			m_Finished.notify_all();
+	}
+}
+
+Plugin::AMD::BandPlanner::BandPlanner()
+{
+	Reset(0, 0);
+}
+
+void Plugin::AMD::BandPlanner::Reset(uint32_t width, uint32_t height)
+{
+	m_Width       = width;
+	m_Height      = height;
+	m_AverageWork = 0;
+}
+
+size_t Plugin::AMD::BandPlanner::GetBandCount(size_t maxHelpers)
+{
+	size_t bands;
+	if (m_AverageWork == 0) {
+		bands = ((size_t)m_Width * (size_t)m_Height) / BAND_INITIAL_PIXELS;
+	} else {
+		uint64_t target = std::chrono::nanoseconds(BAND_TARGET_TIME).count();
+		bands           = (size_t)((m_AverageWork + target - 1) / target);
+	}
+
+	size_t limit = std::min(maxHelpers, BandPool::GetHelperLimit()) + 1;
+	bands        = std::min({bands, limit, (size_t)(m_Height / BAND_MINIMUM_ROWS)});
+	return std::max(bands, (size_t)1);
+}
+
+void Plugin::AMD::BandPlanner::Record(std::chrono::nanoseconds work)
+{
+	uint64_t value = work.count() > 0 ? (uint64_t)work.count() : 0;
+	m_AverageWork  = (m_AverageWork == 0) ? value : (m_AverageWork * 7 + value) / 8;
+}
@@ -18,8 +18,16 @@
  */
 
 #include "amf-capabilities.hpp"
+#include <thread>
 #include "utility.hpp"
 
+// Name of the cache file in the module configuration directory.
+#define CAPABILITY_CACHE_FILE "capabilities.json"
+// Time in milliseconds after which a codec test is considered hung and the codec unsupported.
+#define CAPABILITY_TEST_TIMEOUT 2000
+// Increase whenever the layout of the cache file changes.
+#define CAPABILITY_CACHE_VERSION 1
+
 using namespace Plugin;
 using namespace Plugin::AMD;
 
@@ -54,75 +62,327 @@ Plugin::AMD::CapabilityManager::CapabilityManager()
 	// Potential fix for unintended crashes by AMD including asserts in release builds.
 	AMD::AMF::Instance()->EnableDebugTrace(false);
 
-	// Key order: API, Adapter, Codec
+	// Nothing is tested here, only once something asks for it.
+	LoadCache();
+}
+
+Plugin::AMD::CapabilityManager::~CapabilityManager() {}
+
+bool Plugin::AMD::CapabilityManager::IsCodecSupported(AMD::Codec codec)
+{
 	for (auto api : API::EnumerateAPIs()) {
-		PLOG_DEBUG("[Capability Manager] Testing %s API...", api->GetName().c_str());
-		for (auto adapter : api->EnumerateAdapters()) {
-			std::pair<Codec, bool> test_codecs[] = {
-				std::make_pair(Codec::AVC, false),
-				std::make_pair(Codec::HEVC, false),
-			};
-
-			for (auto& codec : test_codecs) {
+		if (IsCodecSupportedByAPI(codec, api->GetType()))
+			return true;
+	}
+	return false;
+}
+
+bool Plugin::AMD::CapabilityManager::IsCodecSupportedByAPI(AMD::Codec codec, API::Type type)
+{
+	auto api = API::GetAPI(type);
+	for (bool supported : IsCodecSupportedByAPIAdapters(codec, type, api->EnumerateAdapters())) {
+		if (supported)
+			return true;
+	}
+	return false;
+}
+
+bool Plugin::AMD::CapabilityManager::IsCodecSupportedByAPIAdapter(AMD::Codec codec, API::Type api, API::Adapter adapter)
+{
+	return IsCodecSupportedByAPIAdapters(codec, api, {adapter})[0];
+}
+
+std::vector<bool> Plugin::AMD::CapabilityManager::IsCodecSupportedByAPIAdapters(
+	AMD::Codec codec, API::Type api, const std::vector<API::Adapter>& adapters)
+{
+	std::vector<bool>                                           supported(adapters.size(), false);
+	std::vector<std::shared_ptr<CapabilityTest>>                tests(adapters.size());
+	std::vector<std::chrono::high_resolution_clock::time_point> deadlines(adapters.size());
+
+	// Start every test before waiting for any, so that hung adapters time out together instead of one by one.
+	for (size_t idx = 0; idx < adapters.size(); idx++) {
+		bool result    = false;
+		tests[idx]     = StartTest(codec, api, adapters[idx], deadlines[idx], result);
+		supported[idx] = result;
+	}
+
+	bool changed = false;
+	for (size_t idx = 0; idx < adapters.size(); idx++) {
+		if (tests[idx])
+			supported[idx] = FinishTest(codec, api, adapters[idx], tests[idx], deadlines[idx], changed);
+	}
+
+	if (changed)
+		SaveCache();
+	return supported;
+}
+
+std::shared_ptr<CapabilityManager::CapabilityTest> Plugin::AMD::CapabilityManager::StartTest(
+	AMD::Codec codec, API::Type api, const API::Adapter& adapter,
+	std::chrono::high_resolution_clock::time_point& deadline, bool& supported)
+{
+	CapabilityKey key = {api, adapter.idLow, adapter.idHigh, codec};
+
+	std::unique_lock<std::mutex> lock(m_Lock);
+	Capability&                  cap = m_Capabilities[key];
+	if ((cap.state != CapabilityState::Untested) && (cap.state != CapabilityState::Testing)) {
+		if (cap.name == adapter.Name) {
+			supported = cap.supported;
+			return nullptr;
+		}
+		cap.state = CapabilityState::Untested;
+	}
+
+	// The first caller starts the test, everyone else waits for the same result. Creating an encoder creates a
+	// device and context, which may hang in the driver, so the test runs on its own thread with a deadline.
+	if (cap.state == CapabilityState::Untested) {
+		cap.name     = adapter.Name;
+		cap.state    = CapabilityState::Testing;
+		cap.test     = std::make_shared<CapabilityTest>();
+		cap.deadline = std::chrono::high_resolution_clock::now() + std::chrono::milliseconds(CAPABILITY_TEST_TIMEOUT);
+
+		std::thread thread(
+			[adapter, codec](std::shared_ptr<API::IAPI> api, std::shared_ptr<CapabilityTest> test) {
+				auto begin     = std::chrono::high_resolution_clock::now();
+				bool supported = false;
 				try {
 					std::unique_ptr<AMD::Encoder> enc;
 
-					if (codec.first == Codec::AVC || codec.first == Codec::SVC) {
+					if (codec == Codec::AVC || codec == Codec::SVC) {
 						enc = std::make_unique<AMD::EncoderH264>(api, adapter);
-					} else if (codec.first == Codec::HEVC) {
+					} else if (codec == Codec::HEVC) {
 						enc = std::make_unique<AMD::EncoderH265>(api, adapter);
 					}
 
 					if (enc != nullptr) {
-						codec.second = true;
+						supported = true;
 					}
 				} catch (const std::exception& e) {
 					PLOG_DEBUG("[Capability Manager] Testing %s Adapter '%s' with codec %s failed, reason: %s",
-							   api->GetName().c_str(), adapter.Name.c_str(), Utility::CodecToString(codec.first),
-							   e.what());
+							   api->GetName().c_str(), adapter.Name.c_str(), Utility::CodecToString(codec), e.what());
 #ifdef LITE_OBS
 					e;
 #endif
 				}
 
-				std::tuple<API::Type, API::Adapter, AMD::Codec> key =
-					std::make_tuple(api->GetType(), adapter, codec.first);
-				m_CapabilityMap[key] = codec.second;
-			}
+				std::unique_lock<std::mutex> lock(test->lock);
+				test->supported = supported;
+				test->time      = std::chrono::high_resolution_clock::now() - begin;
+				test->done      = true;
+				test->signal.notify_all();
+			},
+			API::GetAPI(api), cap.test);
+		thread.detach();
+	}
+	deadline = cap.deadline;
+	return cap.test;
+}
+
+bool Plugin::AMD::CapabilityManager::FinishTest(AMD::Codec codec, API::Type api, const API::Adapter& adapter,
+												std::shared_ptr<CapabilityTest>                test,
+												std::chrono::high_resolution_clock::time_point deadline, bool& changed)
+{
+	CapabilityKey key = {api, adapter.idLow, adapter.idHigh, codec};
 
-			PLOG_INFO(
-				"[Capability Manager] Testing %s Adapter '%s':\n"
-				"  %s: %s\n"
-				"  %s: %s\n",
-				api->GetName().c_str(), adapter.Name.c_str(), Utility::CodecToString(test_codecs[0].first),
-				test_codecs[0].second ? "Supported" : "Not Supported", Utility::CodecToString(test_codecs[1].first),
-				test_codecs[1].second ? "Supported" : "Not Supported");
+	{
+		std::unique_lock<std::mutex> lock(test->lock);
+		test->signal.wait_until(lock, deadline, [&test] { return test->done; });
+	}
+
+	std::unique_lock<std::mutex> lock(m_Lock);
+	Capability&                  cap = m_Capabilities[key];
+	if ((cap.state == CapabilityState::Testing) && (cap.test == test)) {
+		std::unique_lock<std::mutex> test_lock(test->lock);
+		if (test->done) {
+			cap.supported = test->supported;
+			cap.state     = CapabilityState::Tested;
+			cap.time      = test->time;
+		} else {
+			// The thread is left behind and finishes (or not) on its own, nobody waits for its result anymore.
+			cap.supported = false;
+			cap.state     = CapabilityState::TimedOut;
+			cap.time      = std::chrono::milliseconds(CAPABILITY_TEST_TIMEOUT);
 		}
+		cap.test.reset();
+		changed = true;
+
+		PLOG_INFO("[Capability Manager] Testing %s Adapter '%s' with codec %s: %s (%s%.1f ms)",
+				  API::GetAPI(api)->GetName().c_str(), adapter.Name.c_str(), Utility::CodecToString(codec),
+				  cap.supported ? "Supported" : "Not Supported",
+				  cap.state == CapabilityState::TimedOut ? "Timed out after " : "",
+				  std::chrono::duration<double_t, std::milli>(cap.time).count());
 	}
+	return cap.supported;
 }
 
-Plugin::AMD::CapabilityManager::~CapabilityManager() {}
+#ifndef LITE_OBS
+static std::shared_ptr<EncoderCaps> probe_encoder_caps(AMD::Codec codec, std::shared_ptr<API::IAPI> api,
+													  API::Adapter adapter)
+{
+	std::shared_ptr<EncoderCaps>  caps = std::make_shared<EncoderCaps>();
+	std::unique_ptr<AMD::Encoder> enc;
+	if (codec == Codec::AVC || codec == Codec::SVC) {
+		std::unique_ptr<AMD::EncoderH264> h264 = std::make_unique<AMD::EncoderH264>(api, adapter);
+		caps->bFramePattern                    = h264->CapsBFramePattern();
+		enc                                    = std::move(h264);
+	} else {
+		std::unique_ptr<AMD::EncoderH265> h265 = std::make_unique<AMD::EncoderH265>(api, adapter);
+		caps->bFramePattern                    = 0;
+		caps->tiers                            = h265->CapsTier();
+		enc                                    = std::move(h265);
+	}
 
-bool Plugin::AMD::CapabilityManager::IsCodecSupported(AMD::Codec codec)
+	caps->qualityPresets         = enc->CapsQualityPreset();
+	caps->profiles               = enc->CapsProfile();
+	caps->profileLevels          = enc->CapsProfileLevel();
+	caps->codingTypes            = enc->CapsCodingType();
+	caps->maximumReferenceFrames = enc->CapsMaximumReferenceFrames();
+	caps->rateControlMethods     = enc->CapsRateControlMethod();
+	try {
+		caps->prePassModes         = enc->CapsPrePassMode();
+		caps->prePassModeSupported = true;
+	} catch (...) {
+		caps->prePassModeSupported = false;
+	}
+	caps->targetBitrate = enc->CapsTargetBitrate();
+	caps->peakBitrate   = enc->CapsPeakBitrate();
+	caps->vbvBufferSize = enc->CapsVBVBufferSize();
+	return caps;
+}
+
+std::shared_ptr<EncoderCaps> Plugin::AMD::CapabilityManager::GetEncoderCaps(AMD::Codec codec,
+																	  std::shared_ptr<API::IAPI> api,
+																	  API::Adapter               adapter)
 {
-	for (auto api : API::EnumerateAPIs()) {
-		if (IsCodecSupportedByAPI(codec, api->GetType()))
-			return true;
+	CapabilityKey                     key = {api->GetType(), adapter.idLow, adapter.idHigh, codec};
+	std::shared_ptr<EncoderCapsEntry> entry;
+	{
+		std::unique_lock<std::mutex>       lock(m_Lock);
+		std::shared_ptr<EncoderCapsEntry>& found = m_EncoderCaps[key];
+		if (!found || (found->name != adapter.Name)) {
+			found       = std::make_shared<EncoderCapsEntry>();
+			found->name = adapter.Name;
+		}
+		entry = found;
 	}
-	return false;
+
+	// Filled without holding the lock by the first caller, concurrent callers wait for its table. If creating the
+	// encoder throws, the next call tries again.
+	std::call_once(entry->filled, [&entry, codec, api, adapter]() {
+		entry->caps = probe_encoder_caps(codec, api, adapter);
+	});
+	return entry->caps;
 }
+#endif
 
-bool Plugin::AMD::CapabilityManager::IsCodecSupportedByAPI(AMD::Codec codec, API::Type type)
+bool Plugin::AMD::CapabilityManager::CapabilityKey::operator==(const CapabilityKey& other) const
 {
-	auto api = API::GetAPI(type);
-	for (auto adapter : api->EnumerateAdapters()) {
-		if (IsCodecSupportedByAPIAdapter(codec, type, adapter) == true)
-			return true;
+	return (api == other.api) && (idLow == other.idLow) && (idHigh == other.idHigh) && (codec == other.codec);
+}
+
+size_t Plugin::AMD::CapabilityManager::CapabilityKeyHash::operator()(const CapabilityKey& key) const
+{
+	uint64_t id = (uint64_t)(uint32_t)key.idLow | ((uint64_t)(uint32_t)key.idHigh << 32);
+	return std::hash<uint64_t>()(id) ^ std::hash<uint16_t>()(((uint16_t)key.api << 8) | (uint16_t)key.codec);
+}
+
+void Plugin::AMD::CapabilityManager::LoadCache()
+{
+#ifndef LITE_OBS
+	char* path = obs_module_config_path(CAPABILITY_CACHE_FILE);
+	if (!path)
+		return;
+	obs_data_t* data = obs_data_create_from_json_file(path);
+	bfree(path);
+	if (!data)
+		return;
+
+	if ((obs_data_get_int(data, "version") == CAPABILITY_CACHE_VERSION)
+		&& ((uint64_t)obs_data_get_int(data, "runtime") == AMD::AMF::Instance()->GetRuntimeVersion())
+		&& ((uint64_t)obs_data_get_int(data, "plugin") == PLUGIN_VERSION_FULL)) {
+		std::unique_lock<std::mutex> lock(m_Lock);
+
+		obs_data_array_t* array = obs_data_get_array(data, "entries");
+		for (size_t idx = 0, cnt = obs_data_array_count(array); idx < cnt; idx++) {
+			obs_data_t*   item = obs_data_array_item(array, idx);
+			CapabilityKey key;
+			key.api    = (API::Type)obs_data_get_int(item, "api");
+			key.idLow  = (int32_t)obs_data_get_int(item, "idLow");
+			key.idHigh = (int32_t)obs_data_get_int(item, "idHigh");
+			key.codec  = (AMD::Codec)obs_data_get_int(item, "codec");
+			std::string name      = obs_data_get_string(item, "name");
+			bool        supported = obs_data_get_bool(item, "supported");
+			obs_data_release(item);
+
+			// Drop adapters that are gone, so that the cache does not grow forever.
+			bool present = false;
+			for (auto api : API::EnumerateAPIs()) {
+				if (api->GetType() != key.api)
+					continue;
+				for (auto adapter : api->EnumerateAdapters()) {
+					if ((adapter.idLow == key.idLow) && (adapter.idHigh == key.idHigh) && (adapter.Name == name))
+						present = true;
+				}
+			}
+			if (!present)
+				continue;
+
+			Capability& cap = m_Capabilities[key];
+			cap.name        = name;
+			cap.supported   = supported;
+			cap.state       = CapabilityState::Cached;
+		}
+		obs_data_array_release(array);
+
+		PLOG_DEBUG("[Capability Manager] Loaded %lld cached capabilities.", (int64_t)m_Capabilities.size());
+	} else {
+		PLOG_DEBUG("[Capability Manager] Cached capabilities are outdated, testing again.");
 	}
-	return false;
+	obs_data_release(data);
+#endif
 }
 
-bool Plugin::AMD::CapabilityManager::IsCodecSupportedByAPIAdapter(AMD::Codec codec, API::Type api, API::Adapter adapter)
+void Plugin::AMD::CapabilityManager::SaveCache()
 {
-	return m_CapabilityMap[std::make_tuple(api, adapter, codec)];
+#ifndef LITE_OBS
+	char* directory = obs_module_config_path("");
+	if (!directory)
+		return;
+	os_mkdirs(directory);
+	bfree(directory);
+
+	// Also held while writing, so that two tests finishing at the same time do not write the file at once.
+	std::unique_lock<std::mutex> lock(m_Lock);
+
+	obs_data_t*       data  = obs_data_create();
+	obs_data_array_t* array = obs_data_array_create();
+	for (auto& kv : m_Capabilities) {
+		// A test that timed out may succeed on the next start.
+		if ((kv.second.state != CapabilityState::Cached) && (kv.second.state != CapabilityState::Tested))
+			continue;
+
+		obs_data_t* item = obs_data_create();
+		obs_data_set_int(item, "api", (int64_t)kv.first.api);
+		obs_data_set_int(item, "idLow", kv.first.idLow);
+		obs_data_set_int(item, "idHigh", kv.first.idHigh);
+		obs_data_set_string(item, "name", kv.second.name.c_str());
+		obs_data_set_int(item, "codec", (int64_t)kv.first.codec);
+		obs_data_set_bool(item, "supported", kv.second.supported);
+		obs_data_array_push_back(array, item);
+		obs_data_release(item);
+	}
+	obs_data_set_int(data, "version", CAPABILITY_CACHE_VERSION);
+	obs_data_set_int(data, "runtime", (int64_t)AMD::AMF::Instance()->GetRuntimeVersion());
+	obs_data_set_int(data, "plugin", (int64_t)PLUGIN_VERSION_FULL);
+	obs_data_set_array(data, "entries", array);
+	obs_data_array_release(array);
+
+	char* path = obs_module_config_path(CAPABILITY_CACHE_FILE);
+	if (path) {
+		if (!obs_data_save_json_safe(data, path, "tmp", "bak"))
+			PLOG_WARNING("[Capability Manager] Failed to store capabilities in '%s'.", path);
+		bfree(path);
+	}
+	obs_data_release(data);
+#endif
 }
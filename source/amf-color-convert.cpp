@@ -0,0 +1,223 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "amf-color-convert.hpp"
+#include <cmath>
+#include <stdexcept>
+#include "amf-encoder.hpp"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define COLOR_CONVERT_SSE2
+#include <emmintrin.h>
+#endif
+
+// Fractional bits of the matrix coefficients.
+#define COLOR_CONVERT_SHIFT 14
+
+using namespace Plugin;
+using namespace Plugin::AMD;
+
+static inline uint8_t clamp_byte(int32_t v)
+{
+	return static_cast<uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+static inline uint8_t luma(const ColorMatrix& m, const uint8_t* p)
+{
+	return clamp_byte((m.y[0] * p[0] + m.y[1] * p[1] + m.y[2] * p[2] + m.yBias) >> COLOR_CONVERT_SHIFT);
+}
+
+// The sum of four pixels carries two more fractional bits.
+static inline uint8_t chroma(const int16_t* coeff, const int32_t* sum, int32_t bias)
+{
+	return clamp_byte((coeff[0] * sum[0] + coeff[1] * sum[1] + coeff[2] * sum[2] + bias) >> (COLOR_CONVERT_SHIFT + 2));
+}
+
+// Converts the columns [begin, width) of a pair of rows. s1 and y1 may point to the same row as s0 and y0.
+static void convert_rows_scalar(const ColorMatrix& m, const uint8_t* s0, const uint8_t* s1, uint8_t* y0, uint8_t* y1,
+								uint8_t* uv, size_t begin, size_t width)
+{
+	for (size_t x = begin; x < width; x += 2) {
+		// Odd widths repeat the last column.
+		size_t         x1   = (x + 1 < width) ? x + 1 : x;
+		const uint8_t* p[4] = {s0 + x * 4, s0 + x1 * 4, s1 + x * 4, s1 + x1 * 4};
+
+		y0[x]  = luma(m, p[0]);
+		y0[x1] = luma(m, p[1]);
+		y1[x]  = luma(m, p[2]);
+		y1[x1] = luma(m, p[3]);
+
+		int32_t sum[3];
+		for (size_t c = 0; c < 3; c++)
+			sum[c] = p[0][c] + p[1][c] + p[2][c] + p[3][c];
+		uv[x]     = chroma(m.u, sum, m.cBias);
+		uv[x + 1] = chroma(m.v, sum, m.cBias);
+	}
+}
+
+#ifdef COLOR_CONVERT_SSE2
+// Adds the two 32-bit halves of every pixel, packed by madd as [x0, y0, x1, y1] into a and b.
+static inline __m128i sum_pairs(__m128i a, __m128i b)
+{
+	__m128 fa = _mm_castsi128_ps(a), fb = _mm_castsi128_ps(b);
+	return _mm_add_epi32(_mm_castps_si128(_mm_shuffle_ps(fa, fb, _MM_SHUFFLE(2, 0, 2, 0))),
+						 _mm_castps_si128(_mm_shuffle_ps(fa, fb, _MM_SHUFFLE(3, 1, 3, 1))));
+}
+
+// Luma of four pixels as 32-bit integers.
+static inline __m128i luma4(__m128i px, __m128i coeff, __m128i bias)
+{
+	__m128i zero = _mm_setzero_si128();
+	__m128i lo   = _mm_madd_epi16(_mm_unpacklo_epi8(px, zero), coeff);
+	__m128i hi   = _mm_madd_epi16(_mm_unpackhi_epi8(px, zero), coeff);
+	return _mm_srai_epi32(_mm_add_epi32(sum_pairs(lo, hi), bias), COLOR_CONVERT_SHIFT);
+}
+
+// Chroma of two 2x2 blocks as [U0, V0, U1, V1], given the vertical sums of the two pixels of each block.
+static inline __m128i chroma2(__m128i cols0, __m128i cols1, __m128i coeff, __m128i bias)
+{
+	// Both halves of b0 and b1 hold the sum of the whole block, U is applied to the first and V to the second.
+	__m128i b0 = _mm_add_epi16(cols0, _mm_shuffle_epi32(cols0, _MM_SHUFFLE(1, 0, 3, 2)));
+	__m128i b1 = _mm_add_epi16(cols1, _mm_shuffle_epi32(cols1, _MM_SHUFFLE(1, 0, 3, 2)));
+	__m128i uv = sum_pairs(_mm_madd_epi16(b0, coeff), _mm_madd_epi16(b1, coeff));
+	return _mm_srai_epi32(_mm_add_epi32(uv, bias), COLOR_CONVERT_SHIFT + 2);
+}
+
+static void convert_rows_sse2(const ColorMatrix& m, const uint8_t* s0, const uint8_t* s1, uint8_t* y0, uint8_t* y1,
+							  uint8_t* uv, size_t width)
+{
+	const __m128i zero   = _mm_setzero_si128();
+	const __m128i coeffY = _mm_setr_epi16(m.y[0], m.y[1], m.y[2], 0, m.y[0], m.y[1], m.y[2], 0);
+	const __m128i coeffC = _mm_setr_epi16(m.u[0], m.u[1], m.u[2], 0, m.v[0], m.v[1], m.v[2], 0);
+	const __m128i biasY  = _mm_set1_epi32(m.yBias);
+	const __m128i biasC  = _mm_set1_epi32(m.cBias);
+
+	size_t x = 0;
+	for (; x + 8 <= width; x += 8) {
+		__m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s0 + x * 4));
+		__m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s0 + x * 4 + 16));
+		__m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s1 + x * 4));
+		__m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s1 + x * 4 + 16));
+
+		__m128i ya = _mm_packs_epi32(luma4(a0, coeffY, biasY), luma4(a1, coeffY, biasY));
+		__m128i yb = _mm_packs_epi32(luma4(b0, coeffY, biasY), luma4(b1, coeffY, biasY));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(y0 + x), _mm_packus_epi16(ya, zero));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(y1 + x), _mm_packus_epi16(yb, zero));
+
+		// Vertical sums, at most 510 per channel, so 16 bits are plenty.
+		__m128i c0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+		__m128i c1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+		__m128i c2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+		__m128i c3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+		__m128i c = _mm_packs_epi32(chroma2(c0, c1, coeffC, biasC), chroma2(c2, c3, coeffC, biasC));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(uv + x), _mm_packus_epi16(c, zero));
+	}
+	convert_rows_scalar(m, s0, s1, y0, y1, uv, x, width);
+}
+#endif
+
+Plugin::AMD::HostColorConverter::HostColorConverter(ColorFormat format, ColorSpace space, bool fullRange)
+{
+	if (!IsFormatSupported(format))
+		throw std::invalid_argument("format");
+
+	double_t kr, kb;
+	switch (space) {
+	case ColorSpace::BT601:
+		kr = 0.299, kb = 0.114;
+		break;
+	case ColorSpace::BT709:
+	case ColorSpace::SRGB:
+		kr = 0.2126, kb = 0.0722;
+		break;
+	case ColorSpace::BT2020:
+		kr = 0.2627, kb = 0.0593;
+		break;
+	default:
+		throw std::invalid_argument("space");
+	}
+
+	// Limited range scales luma to 16 - 235 and chroma to 16 - 240.
+	const double_t one    = (double_t)(1 << COLOR_CONVERT_SHIFT);
+	double_t       yScale = fullRange ? 1.0 : (219.0 / 255.0);
+	double_t       cScale = fullRange ? 1.0 : (224.0 / 255.0);
+	int32_t        yBase  = fullRange ? 0 : 16;
+
+	// Green takes the rounding error, so gray maps to exactly neutral chroma.
+	int32_t yr = (int32_t)lround(kr * yScale * one), yb = (int32_t)lround(kb * yScale * one);
+	int32_t yg = (int32_t)lround(yScale * one) - yr - yb;
+	int32_t ur = (int32_t)lround(-kr / (2.0 * (1.0 - kb)) * cScale * one), ub = (int32_t)lround(0.5 * cScale * one);
+	int32_t ug = -ur - ub;
+	int32_t vr = (int32_t)lround(0.5 * cScale * one), vb = (int32_t)lround(-kb / (2.0 * (1.0 - kr)) * cScale * one);
+	int32_t vg = -vr - vb;
+
+	// Match the byte order of the source pixels.
+	size_t r = (format == ColorFormat::RGBA) ? 0 : 2, g = 1, b = (format == ColorFormat::RGBA) ? 2 : 0;
+	m_Matrix.y[r] = (int16_t)yr, m_Matrix.y[g] = (int16_t)yg, m_Matrix.y[b] = (int16_t)yb, m_Matrix.y[3] = 0;
+	m_Matrix.u[r] = (int16_t)ur, m_Matrix.u[g] = (int16_t)ug, m_Matrix.u[b] = (int16_t)ub, m_Matrix.u[3] = 0;
+	m_Matrix.v[r] = (int16_t)vr, m_Matrix.v[g] = (int16_t)vg, m_Matrix.v[b] = (int16_t)vb, m_Matrix.v[3] = 0;
+	m_Matrix.yBias = (yBase << COLOR_CONVERT_SHIFT) + (1 << (COLOR_CONVERT_SHIFT - 1));
+	m_Matrix.cBias = (128 << (COLOR_CONVERT_SHIFT + 2)) + (1 << (COLOR_CONVERT_SHIFT + 1));
+}
+
+void Plugin::AMD::HostColorConverter::Convert(const uint8_t* src, size_t srcPitch, uint8_t* dstY, size_t dstYPitch,
+											  uint8_t* dstUV, size_t dstUVPitch, size_t width, size_t height)
+{
+#ifdef COLOR_CONVERT_SSE2
+	for (size_t y = 0; y < height; y += 2) {
+		// Odd heights repeat the last row.
+		size_t y1 = (y + 1 < height) ? y + 1 : y;
+		convert_rows_sse2(m_Matrix, src + y * srcPitch, src + y1 * srcPitch, dstY + y * dstYPitch,
+						  dstY + y1 * dstYPitch, dstUV + (y / 2) * dstUVPitch, width);
+	}
+#else
+	ConvertScalar(src, srcPitch, dstY, dstYPitch, dstUV, dstUVPitch, width, height);
+#endif
+}
+
+void Plugin::AMD::HostColorConverter::ConvertScalar(const uint8_t* src, size_t srcPitch, uint8_t* dstY,
+													size_t dstYPitch, uint8_t* dstUV, size_t dstUVPitch, size_t width,
+													size_t height)
+{
+	for (size_t y = 0; y < height; y += 2) {
+		size_t y1 = (y + 1 < height) ? y + 1 : y;
+		convert_rows_scalar(m_Matrix, src + y * srcPitch, src + y1 * srcPitch, dstY + y * dstYPitch,
+							dstY + y1 * dstYPitch, dstUV + (y / 2) * dstUVPitch, 0, width);
+	}
+}
+
+bool Plugin::AMD::HostColorConverter::IsFormatSupported(ColorFormat format)
+{
+	return (format == ColorFormat::BGRA) || (format == ColorFormat::RGBA);
+}
+
+bool Plugin::AMD::HostColorConverter::IsVectorized()
+{
+#ifdef COLOR_CONVERT_SSE2
+	return true;
+#else
+	return false;
+#endif
+}
+
+const char* Plugin::AMD::HostColorConverter::GetKernelName()
+{
+	return IsVectorized() ? "SSE2" : "Scalar";
+}
@@ -0,0 +1,176 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "amf-context.hpp"
+
+using namespace Plugin;
+using namespace Plugin::AMD;
+
+// One slot per adapter. The slot lock is held while creating the context, the registry lock only to find the slot.
+struct RegistrySlot {
+	std::mutex                   lock;
+	std::weak_ptr<SharedContext> context;
+};
+static std::map<std::tuple<API::Type, int32_t, int32_t>, std::shared_ptr<RegistrySlot>> __registry;
+static std::mutex                                                                      __registry_mutex;
+
+std::shared_ptr<SharedContext> Plugin::AMD::SharedContext::Acquire(std::shared_ptr<API::IAPI> api,
+																	API::Adapter               adapter)
+{
+	std::tuple<API::Type, int32_t, int32_t> key = std::make_tuple(api->GetType(), adapter.idLow, adapter.idHigh);
+	std::shared_ptr<RegistrySlot>           slot;
+	{
+		const std::lock_guard<std::mutex> lock(__registry_mutex);
+		std::shared_ptr<RegistrySlot>&    entry = __registry[key];
+		if (!entry)
+			entry = std::make_shared<RegistrySlot>();
+		slot = entry;
+	}
+
+	const std::lock_guard<std::mutex> lock(slot->lock);
+	std::shared_ptr<SharedContext>    context = slot->context.lock();
+	if (!context) {
+		context       = std::make_shared<SharedContext>(api, adapter);
+		slot->context = context;
+	}
+	return context;
+}
+
+Plugin::AMD::SharedContext::SharedContext(std::shared_ptr<API::IAPI> api, API::Adapter adapter)
+{
+	m_API               = api;
+	m_Adapter           = adapter;
+	m_Device            = nullptr;
+	m_Context           = nullptr;
+	m_MemoryType        = amf::AMF_MEMORY_UNKNOWN;
+	m_OpenCLInitialized = false;
+	m_OpenCLResult      = AMF_NOT_INITIALIZED;
+
+	// Initialize selected API on Video Adapter
+	m_Device = m_API->CreateInstance(m_Adapter);
+
+	// Create Context for Conversion and Encoding
+	AMD::AMF*  amf = AMD::AMF::Instance();
+	AMF_RESULT res = amf->GetFactory()->CreateContext(&m_Context);
+	if (res != AMF_OK) {
+		QUICK_FORMAT_MESSAGE(errMsg, "<%s> Creating a AMF Context failed, error %ls (code %d).", __FUNCTION_NAME__,
+							 amf->GetTrace()->GetResultText(res), res);
+		throw std::runtime_error(errMsg.c_str());
+	}
+	/// Initialize Context using selected API
+	switch (m_API->GetType()) {
+	case API::Type::Direct3D11:
+	case API::Type::Direct3D9:
+	case API::Type::Host:
+		break;
+	default:
+#pragma warning(push)
+#pragma warning(disable : 4062)
+		m_API = API::GetAPI(0);
+		switch (m_API->GetType()) {
+		case API::Type::Direct3D9:
+			m_Adapter = m_API->EnumerateAdapters()[0];
+			m_Device  = m_API->CreateInstance(m_Adapter);
+			break;
+		case API::Type::Direct3D11:
+			m_Adapter = m_API->EnumerateAdapters()[0];
+			m_Device  = m_API->CreateInstance(m_Adapter);
+			break;
+		case API::Type::Host:
+			m_Adapter = m_API->EnumerateAdapters()[0];
+			m_Device  = m_API->CreateInstance(m_Adapter);
+			break;
+		}
+	}
+	switch (m_API->GetType()) {
+	case API::Type::Direct3D9:
+		m_MemoryType = amf::AMF_MEMORY_DX9;
+		res          = m_Context->InitDX9(m_Device->GetContext());
+		break;
+	case API::Type::Direct3D11:
+		m_MemoryType = amf::AMF_MEMORY_DX11;
+		res          = m_Context->InitDX11(m_Device->GetContext());
+		break;
+	case API::Type::Host:
+		m_MemoryType = amf::AMF_MEMORY_HOST;
+		res          = AMF_OK;
+		break;
+	}
+#pragma warning(pop)
+	if (res != AMF_OK) {
+		QUICK_FORMAT_MESSAGE(errMsg, "<%s> Initializing %s API with Adapter '%s' failed, error %ls (code %d).",
+							 __FUNCTION_NAME__, m_API->GetName().c_str(), m_Adapter.Name.c_str(),
+							 amf->GetTrace()->GetResultText(res), res);
+		m_Context->Terminate();
+		throw std::runtime_error(errMsg.c_str());
+	}
+
+	PLOG_DEBUG("<%s> Created context for %s Adapter '%s'.", __FUNCTION_NAME__, m_API->GetName().c_str(),
+			   m_Adapter.Name.c_str());
+}
+
+Plugin::AMD::SharedContext::~SharedContext()
+{
+	if (m_Context) {
+		m_Context->Terminate();
+		m_Context = nullptr;
+	}
+	m_Device = nullptr;
+	m_API    = nullptr;
+}
+
+std::shared_ptr<API::IAPI> Plugin::AMD::SharedContext::GetAPI()
+{
+	return m_API;
+}
+
+API::Adapter Plugin::AMD::SharedContext::GetAdapter()
+{
+	return m_Adapter;
+}
+
+std::shared_ptr<API::Instance> Plugin::AMD::SharedContext::GetDevice()
+{
+	return m_Device;
+}
+
+amf::AMFContextPtr Plugin::AMD::SharedContext::GetContext()
+{
+	return m_Context;
+}
+
+amf::AMF_MEMORY_TYPE Plugin::AMD::SharedContext::GetMemoryType()
+{
+	return m_MemoryType;
+}
+
+AMF_RESULT Plugin::AMD::SharedContext::InitOpenCL()
+{
+	const std::lock_guard<std::mutex> lock(m_ComputeLock);
+	if (!m_OpenCLInitialized) {
+		m_OpenCLResult      = m_Context->InitOpenCL();
+		m_OpenCLInitialized = true;
+	}
+	return m_OpenCLResult;
+}
+
+std::mutex& Plugin::AMD::SharedContext::GetComputeLock()
+{
+	return m_ComputeLock;
+}
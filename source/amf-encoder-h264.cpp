@@ -38,13 +38,13 @@ Plugin::AMD::EncoderH264::EncoderH264(std::shared_ptr<API::IAPI> videoAPI, const
 
 	if (m_AMF->GetRuntimeVersion() < AMF_MAKE_FULL_VERSION(1, 4, 0, 0)) {
 		// Support for 1.3.x drivers.
-		AMF_RESULT res = res = m_AMFEncoder->SetProperty(L"NominalRange", m_FullColorRange);
+		AMF_RESULT res = res = SetEncoderProperty(L"NominalRange", m_FullColorRange);
 		if (res != AMF_OK) {
 			QUICK_FORMAT_MESSAGE(errMsg, PREFIX "Failed to set encoder color range, error %ls (code %d)", m_UniqueId,
 								 m_AMF->GetTrace()->GetResultText(res), res);
 		}
 	} else {
-		AMF_RESULT res = res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_FULL_RANGE_COLOR, m_FullColorRange);
+		AMF_RESULT res = res = SetEncoderProperty(AMF_VIDEO_ENCODER_FULL_RANGE_COLOR, m_FullColorRange);
 		if (res != AMF_OK) {
 			QUICK_FORMAT_MESSAGE(errMsg, PREFIX "Failed to set encoder color range, error %ls (code %d)", m_UniqueId,
 								 m_AMF->GetTrace()->GetResultText(res), res);
@@ -62,7 +62,7 @@ std::vector<Usage> Plugin::AMD::EncoderH264::CapsUsage()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	std::vector<Usage> ret;
@@ -79,11 +79,11 @@ std::vector<Usage> Plugin::AMD::EncoderH264::CapsUsage()
 
 void Plugin::AMD::EncoderH264::SetUsage(Usage v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_USAGE, Utility::UsageToAMFH264(v));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_USAGE, Utility::UsageToAMFH264(v));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, Utility::UsageToString(v), m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -91,11 +91,11 @@ Plugin::AMD::Usage Plugin::AMD::EncoderH264::GetUsage()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_USAGE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_USAGE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return Utility::UsageFromAMFH264((AMF_VIDEO_ENCODER_USAGE_ENUM)e);
 }
@@ -108,7 +108,7 @@ std::vector<QualityPreset> Plugin::AMD::EncoderH264::CapsQualityPreset()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	std::vector<QualityPreset> ret;
@@ -124,12 +124,12 @@ std::vector<QualityPreset> Plugin::AMD::EncoderH264::CapsQualityPreset()
 
 void Plugin::AMD::EncoderH264::SetQualityPreset(QualityPreset v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_QUALITY_PRESET, Utility::QualityPresetToAMFH264(v));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_QUALITY_PRESET, Utility::QualityPresetToAMFH264(v));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, Utility::QualityPresetToString(v),
 							 m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -137,11 +137,11 @@ Plugin::AMD::QualityPreset Plugin::AMD::EncoderH264::GetQualityPreset()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_QUALITY_PRESET, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_QUALITY_PRESET, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return Utility::QualityPresetFromAMFH264((AMF_VIDEO_ENCODER_QUALITY_PRESET_ENUM)e);
 }
@@ -154,7 +154,7 @@ std::vector<Profile> Plugin::AMD::EncoderH264::CapsProfile()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	std::vector<Profile> ret;
@@ -170,12 +170,12 @@ std::vector<Profile> Plugin::AMD::EncoderH264::CapsProfile()
 
 void Plugin::AMD::EncoderH264::SetProfile(Profile v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_PROFILE, Utility::ProfileToAMFH264(v));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_PROFILE, Utility::ProfileToAMFH264(v));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, Utility::ProfileToString(v), m_AMF->GetTrace()->GetResultText(res),
 							 res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -183,11 +183,11 @@ Plugin::AMD::Profile Plugin::AMD::EncoderH264::GetProfile()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_PROFILE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_PROFILE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return Utility::ProfileFromAMFH264((AMF_VIDEO_ENCODER_PROFILE_ENUM)e);
 }
@@ -199,7 +199,7 @@ std::vector<ProfileLevel> Plugin::AMD::EncoderH264::CapsProfileLevel()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	std::vector<ProfileLevel> ret;
@@ -237,11 +237,11 @@ void Plugin::AMD::EncoderH264::SetProfileLevel(ProfileLevel v, std::pair<uint32_
 		}
 	}
 
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_PROFILE_LEVEL, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_PROFILE_LEVEL, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %lld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, (int64_t)v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -249,11 +249,11 @@ Plugin::AMD::ProfileLevel Plugin::AMD::EncoderH264::GetProfileLevel()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_PROFILE_LEVEL, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_PROFILE_LEVEL, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (ProfileLevel)e;
 }
@@ -265,7 +265,7 @@ std::pair<uint64_t, uint64_t> Plugin::AMD::EncoderH264::CapsMaximumReferenceFram
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair(var->minValue.int64Value, var->maxValue.int64Value);
@@ -273,11 +273,11 @@ std::pair<uint64_t, uint64_t> Plugin::AMD::EncoderH264::CapsMaximumReferenceFram
 
 void Plugin::AMD::EncoderH264::SetMaximumReferenceFrames(uint64_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_MAX_NUM_REFRAMES, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_MAX_NUM_REFRAMES, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %lld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -285,11 +285,11 @@ uint64_t Plugin::AMD::EncoderH264::GetMaximumReferenceFrames()
 {
 	uint64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_MAX_NUM_REFRAMES, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_MAX_NUM_REFRAMES, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
@@ -301,7 +301,7 @@ std::pair<std::pair<uint32_t, uint32_t>, std::pair<uint32_t, uint32_t>> Plugin::
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair(std::make_pair(var->minValue.sizeValue.width, var->maxValue.sizeValue.width),
@@ -310,11 +310,11 @@ std::pair<std::pair<uint32_t, uint32_t>, std::pair<uint32_t, uint32_t>> Plugin::
 
 void Plugin::AMD::EncoderH264::SetResolution(std::pair<uint32_t, uint32_t> v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_FRAMESIZE, ::AMFConstructSize(v.first, v.second));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_FRAMESIZE, ::AMFConstructSize(v.first, v.second));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %ldx%ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v.first, v.second, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	m_Resolution.first  = v.first;
 	m_Resolution.second = v.second;
@@ -324,11 +324,11 @@ std::pair<uint32_t, uint32_t> Plugin::AMD::EncoderH264::GetResolution()
 {
 	AMFSize e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_FRAMESIZE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_FRAMESIZE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	m_Resolution.first  = e.width;
 	m_Resolution.second = e.height;
@@ -337,11 +337,11 @@ std::pair<uint32_t, uint32_t> Plugin::AMD::EncoderH264::GetResolution()
 
 void Plugin::AMD::EncoderH264::SetAspectRatio(std::pair<uint32_t, uint32_t> v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_ASPECT_RATIO, ::AMFConstructRatio(v.first, v.second));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_ASPECT_RATIO, ::AMFConstructRatio(v.first, v.second));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %ld:%ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v.first, v.second, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -349,22 +349,22 @@ std::pair<uint32_t, uint32_t> Plugin::AMD::EncoderH264::GetAspectRatio()
 {
 	AMFRatio e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_ASPECT_RATIO, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_ASPECT_RATIO, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return std::make_pair(e.num, e.den);
 }
 
 void Plugin::AMD::EncoderH264::SetFrameRate(std::pair<uint32_t, uint32_t> v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_FRAMERATE, ::AMFConstructRate(v.first, v.second));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_FRAMERATE, ::AMFConstructRate(v.first, v.second));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %ld/%ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v.first, v.second, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	m_FrameRate = std::make_pair(v.first, v.second);
 	UpdateFrameRateValues();
@@ -374,11 +374,11 @@ std::pair<uint32_t, uint32_t> Plugin::AMD::EncoderH264::GetFrameRate()
 {
 	AMFRate e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_FRAMERATE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_FRAMERATE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "Unable to retrieve value, error %ls (code %d)", m_UniqueId,
 							 m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	m_FrameRate = std::make_pair(e.num, e.den);
 	UpdateFrameRateValues();
@@ -392,7 +392,7 @@ std::vector<CodingType> Plugin::AMD::EncoderH264::CapsCodingType()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	std::vector<CodingType> ret;
@@ -408,12 +408,12 @@ std::vector<CodingType> Plugin::AMD::EncoderH264::CapsCodingType()
 
 void Plugin::AMD::EncoderH264::SetCodingType(CodingType v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_CABAC_ENABLE, Utility::CodingTypeToAMFH264(v));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_CABAC_ENABLE, Utility::CodingTypeToAMFH264(v));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, Utility::CodingTypeToString(v), m_AMF->GetTrace()->GetResultText(res),
 							 res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -421,11 +421,11 @@ Plugin::AMD::CodingType Plugin::AMD::EncoderH264::GetCodingType()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_CABAC_ENABLE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_CABAC_ENABLE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "Unable to retrieve value, error %ls (code %d)", m_UniqueId,
 							 m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return Utility::CodingTypeFromAMFH264((AMF_VIDEO_ENCODER_CODING_ENUM)e);
 }
@@ -437,7 +437,7 @@ std::pair<uint32_t, uint32_t> Plugin::AMD::EncoderH264::CapsMaximumLongTermRefer
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair((uint32_t)var->minValue.int64Value, (uint32_t)var->maxValue.int64Value);
@@ -445,44 +445,44 @@ std::pair<uint32_t, uint32_t> Plugin::AMD::EncoderH264::CapsMaximumLongTermRefer
 
 void Plugin::AMD::EncoderH264::SetMaximumLongTermReferenceFrames(uint32_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_MAX_LTR_FRAMES, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_MAX_LTR_FRAMES, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
 uint32_t Plugin::AMD::EncoderH264::GetMaximumLongTermReferenceFrames()
 {
 	int64_t    e;
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_MAX_LTR_FRAMES, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_MAX_LTR_FRAMES, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint32_t)e;
 }
 
 void Plugin::AMD::EncoderH264::SetHighMotionQualityBoost(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HIGH_MOTION_QUALITY_BOOST_ENABLE, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HIGH_MOTION_QUALITY_BOOST_ENABLE, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
 bool Plugin::AMD::EncoderH264::GetHighMotionQualityBoost()
 {
 	bool       e;
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HIGH_MOTION_QUALITY_BOOST_ENABLE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HIGH_MOTION_QUALITY_BOOST_ENABLE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
@@ -495,7 +495,7 @@ std::vector<RateControlMethod> Plugin::AMD::EncoderH264::CapsRateControlMethod()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	std::vector<RateControlMethod> ret;
@@ -511,13 +511,12 @@ std::vector<RateControlMethod> Plugin::AMD::EncoderH264::CapsRateControlMethod()
 
 void Plugin::AMD::EncoderH264::SetRateControlMethod(RateControlMethod v)
 {
-	AMF_RESULT res =
-		m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_RATE_CONTROL_METHOD, Utility::RateControlMethodToAMFH264(v));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_RATE_CONTROL_METHOD, Utility::RateControlMethodToAMFH264(v));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, Utility::RateControlMethodToString(v),
 							 m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -525,11 +524,11 @@ Plugin::AMD::RateControlMethod Plugin::AMD::EncoderH264::GetRateControlMethod()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_RATE_CONTROL_METHOD, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_RATE_CONTROL_METHOD, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return Utility::RateControlMethodFromAMFH264((AMF_VIDEO_ENCODER_RATE_CONTROL_METHOD_ENUM)e);
 }
@@ -541,7 +540,7 @@ std::vector<PrePassMode> Plugin::AMD::EncoderH264::CapsPrePassMode()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	std::vector<PrePassMode> ret;
@@ -558,12 +557,12 @@ std::vector<PrePassMode> Plugin::AMD::EncoderH264::CapsPrePassMode()
 void Plugin::AMD::EncoderH264::SetPrePassMode(PrePassMode v)
 {
 	AMF_RESULT res =
-		m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_RATE_CONTROL_PREANALYSIS_ENABLE, Utility::PrePassModeToAMFH264(v));
+		SetEncoderProperty(AMF_VIDEO_ENCODER_RATE_CONTROL_PREANALYSIS_ENABLE, Utility::PrePassModeToAMFH264(v));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, Utility::PrePassModeToString(v), m_AMF->GetTrace()->GetResultText(res),
 							 res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -571,22 +570,22 @@ Plugin::AMD::PrePassMode Plugin::AMD::EncoderH264::GetPrePassMode()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_RATE_CONTROL_PREANALYSIS_ENABLE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_RATE_CONTROL_PREANALYSIS_ENABLE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "Unable to retrieve value, error %ls (code %d)", m_UniqueId,
 							 m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return Utility::PrePassModeFromAMFH264((AMF_VIDEO_ENCODER_PREENCODE_MODE_ENUM)e);
 }
 
 void Plugin::AMD::EncoderH264::SetVarianceBasedAdaptiveQuantizationEnabled(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_ENABLE_VBAQ, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_ENABLE_VBAQ, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -594,22 +593,22 @@ bool Plugin::AMD::EncoderH264::IsVarianceBasedAdaptiveQuantizationEnabled()
 {
 	bool e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_ENABLE_VBAQ, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_ENABLE_VBAQ, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
 
 void Plugin::AMD::EncoderH264::SetFrameSkippingEnabled(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_RATE_CONTROL_SKIP_FRAME_ENABLE, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_RATE_CONTROL_SKIP_FRAME_ENABLE, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -617,22 +616,22 @@ bool Plugin::AMD::EncoderH264::IsFrameSkippingEnabled()
 {
 	bool e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_RATE_CONTROL_SKIP_FRAME_ENABLE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_RATE_CONTROL_SKIP_FRAME_ENABLE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
 
 void Plugin::AMD::EncoderH264::SetEnforceHRDEnabled(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_ENFORCE_HRD, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_ENFORCE_HRD, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -640,22 +639,22 @@ bool Plugin::AMD::EncoderH264::IsEnforceHRDEnabled()
 {
 	bool e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_ENFORCE_HRD, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_ENFORCE_HRD, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
 
 void Plugin::AMD::EncoderH264::SetFillerDataEnabled(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_FILLER_DATA_ENABLE, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_FILLER_DATA_ENABLE, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -663,11 +662,11 @@ bool Plugin::AMD::EncoderH264::IsFillerDataEnabled()
 {
 	bool e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_FILLER_DATA_ENABLE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_FILLER_DATA_ENABLE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
@@ -679,7 +678,7 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH264::CapsQPMinimum()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair((uint8_t)var->minValue.int64Value, (uint8_t)var->maxValue.int64Value);
@@ -687,11 +686,11 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH264::CapsQPMinimum()
 
 void Plugin::AMD::EncoderH264::SetQPMinimum(uint8_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_MIN_QP, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_MIN_QP, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %d, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -699,11 +698,11 @@ uint8_t Plugin::AMD::EncoderH264::GetQPMinimum()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_MIN_QP, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_MIN_QP, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint8_t)e;
 }
@@ -715,7 +714,7 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH264::CapsQPMaximum()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair((uint8_t)var->minValue.int64Value, (uint8_t)var->maxValue.int64Value);
@@ -723,11 +722,11 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH264::CapsQPMaximum()
 
 void Plugin::AMD::EncoderH264::SetQPMaximum(uint8_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_MAX_QP, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_MAX_QP, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %d, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -735,11 +734,11 @@ uint8_t Plugin::AMD::EncoderH264::GetQPMaximum()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_MAX_QP, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_MAX_QP, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint8_t)e;
 }
@@ -751,7 +750,7 @@ std::pair<uint64_t, uint64_t> Plugin::AMD::EncoderH264::CapsTargetBitrate()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair(var->minValue.int64Value, var->maxValue.int64Value);
@@ -759,11 +758,11 @@ std::pair<uint64_t, uint64_t> Plugin::AMD::EncoderH264::CapsTargetBitrate()
 
 void Plugin::AMD::EncoderH264::SetTargetBitrate(uint64_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_TARGET_BITRATE, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_TARGET_BITRATE, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %lld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -771,11 +770,11 @@ uint64_t Plugin::AMD::EncoderH264::GetTargetBitrate()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_TARGET_BITRATE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_TARGET_BITRATE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
@@ -787,7 +786,7 @@ std::pair<uint64_t, uint64_t> Plugin::AMD::EncoderH264::CapsPeakBitrate()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair(var->minValue.int64Value, var->maxValue.int64Value);
@@ -795,11 +794,11 @@ std::pair<uint64_t, uint64_t> Plugin::AMD::EncoderH264::CapsPeakBitrate()
 
 void Plugin::AMD::EncoderH264::SetPeakBitrate(uint64_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_PEAK_BITRATE, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_PEAK_BITRATE, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %lld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -807,11 +806,11 @@ uint64_t Plugin::AMD::EncoderH264::GetPeakBitrate()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_PEAK_BITRATE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_PEAK_BITRATE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
@@ -823,7 +822,7 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH264::CapsIFrameQP()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair((uint8_t)var->minValue.int64Value, (uint8_t)var->maxValue.int64Value);
@@ -831,11 +830,11 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH264::CapsIFrameQP()
 
 void Plugin::AMD::EncoderH264::SetIFrameQP(uint8_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_QP_I, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_QP_I, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %d, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -843,11 +842,11 @@ uint8_t Plugin::AMD::EncoderH264::GetIFrameQP()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_QP_I, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_QP_I, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint8_t)e;
 }
@@ -859,7 +858,7 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH264::CapsPFrameQP()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair((uint8_t)var->minValue.int64Value, (uint8_t)var->maxValue.int64Value);
@@ -867,11 +866,11 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH264::CapsPFrameQP()
 
 void Plugin::AMD::EncoderH264::SetPFrameQP(uint8_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_QP_P, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_QP_P, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %d, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -879,11 +878,11 @@ uint8_t Plugin::AMD::EncoderH264::GetPFrameQP()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_QP_P, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_QP_P, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint8_t)e;
 }
@@ -895,7 +894,7 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH264::CapsBFrameQP()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair((uint8_t)var->minValue.int64Value, (uint8_t)var->maxValue.int64Value);
@@ -903,11 +902,11 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH264::CapsBFrameQP()
 
 void Plugin::AMD::EncoderH264::SetBFrameQP(uint8_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_QP_B, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_QP_B, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %d, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -915,33 +914,33 @@ uint8_t Plugin::AMD::EncoderH264::GetBFrameQP()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_QP_B, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_QP_B, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint8_t)e;
 }
 
 void Plugin::AMD::EncoderH264::SetMaximumAccessUnitSize(uint32_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_MAX_AU_SIZE, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_MAX_AU_SIZE, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
 uint32_t Plugin::AMD::EncoderH264::GetMaximumAccessUnitSize()
 {
 	int64_t    e;
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_MAX_AU_SIZE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_MAX_AU_SIZE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint32_t)e;
 }
@@ -953,7 +952,7 @@ std::pair<uint64_t, uint64_t> Plugin::AMD::EncoderH264::CapsVBVBufferSize()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair(var->minValue.int64Value, var->maxValue.int64Value);
@@ -961,11 +960,11 @@ std::pair<uint64_t, uint64_t> Plugin::AMD::EncoderH264::CapsVBVBufferSize()
 
 void Plugin::AMD::EncoderH264::SetVBVBufferSize(uint64_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_VBV_BUFFER_SIZE, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_VBV_BUFFER_SIZE, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %lld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -973,22 +972,22 @@ uint64_t Plugin::AMD::EncoderH264::GetVBVBufferSize()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_VBV_BUFFER_SIZE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_VBV_BUFFER_SIZE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
 
 void Plugin::AMD::EncoderH264::SetVBVBufferInitialFullness(double v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_INITIAL_VBV_BUFFER_FULLNESS, (int64_t)(v * 64));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_INITIAL_VBV_BUFFER_FULLNESS, (int64_t)(v * 64));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %lf (%d), error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, (uint8_t)(v * 64), m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -996,11 +995,11 @@ float Plugin::AMD::EncoderH264::GetInitialVBVBufferFullness()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_INITIAL_VBV_BUFFER_FULLNESS, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_INITIAL_VBV_BUFFER_FULLNESS, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (e / 64.0f);
 }
@@ -1008,11 +1007,11 @@ float Plugin::AMD::EncoderH264::GetInitialVBVBufferFullness()
 // Properties - Picture Control
 void Plugin::AMD::EncoderH264::SetIDRPeriod(uint32_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_IDR_PERIOD, (int64_t)amf_clamp(v, 1, 1000000));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_IDR_PERIOD, (int64_t)amf_clamp(v, 1, 1000000));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	m_PeriodIDR = v;
 }
@@ -1021,11 +1020,11 @@ uint32_t Plugin::AMD::EncoderH264::GetIDRPeriod()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_IDR_PERIOD, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_IDR_PERIOD, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	m_PeriodIDR = (uint32_t)e;
 	return m_PeriodIDR;
@@ -1033,11 +1032,11 @@ uint32_t Plugin::AMD::EncoderH264::GetIDRPeriod()
 
 void Plugin::AMD::EncoderH264::SetHeaderInsertionSpacing(uint32_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEADER_INSERTION_SPACING, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEADER_INSERTION_SPACING, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -1045,44 +1044,44 @@ uint32_t Plugin::AMD::EncoderH264::GetHeaderInsertionSpacing()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEADER_INSERTION_SPACING, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEADER_INSERTION_SPACING, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint32_t)e;
 }
 
 void Plugin::AMD::EncoderH264::SetGOPAlignmentEnabled(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(L"EnableGOPAlignment", v);
+	AMF_RESULT res = SetEncoderProperty(L"EnableGOPAlignment", v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
 bool Plugin::AMD::EncoderH264::IsGOPAlignmentEnabled()
 {
 	bool       e;
-	AMF_RESULT res = m_AMFEncoder->GetProperty(L"EnableGOPAlignment", &e);
+	AMF_RESULT res = GetEncoderProperty(L"EnableGOPAlignment", &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
 
 void Plugin::AMD::EncoderH264::SetDeblockingFilterEnabled(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_DE_BLOCKING_FILTER, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_DE_BLOCKING_FILTER, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -1090,11 +1089,11 @@ bool Plugin::AMD::EncoderH264::IsDeblockingFilterEnabled()
 {
 	bool e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_DE_BLOCKING_FILTER, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_DE_BLOCKING_FILTER, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
@@ -1106,7 +1105,7 @@ uint8_t Plugin::AMD::EncoderH264::CapsBFramePattern()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return (uint8_t)var->maxValue.int64Value;
@@ -1114,11 +1113,11 @@ uint8_t Plugin::AMD::EncoderH264::CapsBFramePattern()
 
 void Plugin::AMD::EncoderH264::SetBFramePattern(uint8_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_B_PIC_PATTERN, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_B_PIC_PATTERN, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %d, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	m_TimestampOffset = v;
 }
@@ -1127,22 +1126,22 @@ uint8_t Plugin::AMD::EncoderH264::GetBFramePattern()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_B_PIC_PATTERN, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_B_PIC_PATTERN, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint8_t)e;
 }
 
 void Plugin::AMD::EncoderH264::SetBFrameDeltaQP(int8_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_QP_B, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_QP_B, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %d, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -1150,22 +1149,22 @@ int8_t Plugin::AMD::EncoderH264::GetBFrameDeltaQP()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_B_PIC_DELTA_QP, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_B_PIC_DELTA_QP, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (int8_t)e;
 }
 
 void Plugin::AMD::EncoderH264::SetBFrameReferenceEnabled(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_B_REFERENCE_ENABLE, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_B_REFERENCE_ENABLE, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -1173,22 +1172,22 @@ bool Plugin::AMD::EncoderH264::IsBFrameReferenceEnabled()
 {
 	bool e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_B_REFERENCE_ENABLE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_B_REFERENCE_ENABLE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
 
 void Plugin::AMD::EncoderH264::SetBFrameReferenceDeltaQP(int8_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_REF_B_PIC_DELTA_QP, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_REF_B_PIC_DELTA_QP, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %d, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -1196,11 +1195,11 @@ int8_t Plugin::AMD::EncoderH264::GetBFrameReferenceDeltaQP()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_REF_B_PIC_DELTA_QP, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_REF_B_PIC_DELTA_QP, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (int8_t)e;
 }
@@ -1208,11 +1207,11 @@ int8_t Plugin::AMD::EncoderH264::GetBFrameReferenceDeltaQP()
 // Properties - Motion Estimation
 void Plugin::AMD::EncoderH264::SetMotionEstimationQuarterPixelEnabled(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_MOTION_HALF_PIXEL, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_MOTION_HALF_PIXEL, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set mode to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -1220,22 +1219,22 @@ bool Plugin::AMD::EncoderH264::IsMotionEstimationQuarterPixelEnabled()
 {
 	bool e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_MOTION_HALF_PIXEL, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_MOTION_HALF_PIXEL, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
 
 void Plugin::AMD::EncoderH264::SetMotionEstimationHalfPixelEnabled(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_MOTION_QUARTERPIXEL, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_MOTION_QUARTERPIXEL, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set mode to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -1243,11 +1242,11 @@ bool Plugin::AMD::EncoderH264::IsMotionEstimationHalfPixelEnabled()
 {
 	bool e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_MOTION_QUARTERPIXEL, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_MOTION_QUARTERPIXEL, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
@@ -1260,7 +1259,7 @@ std::pair<uint32_t, uint32_t> Plugin::AMD::EncoderH264::CapsIntraRefreshNumMBsPe
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair((uint32_t)var->minValue.int64Value, (uint32_t)var->maxValue.int64Value);
@@ -1268,11 +1267,11 @@ std::pair<uint32_t, uint32_t> Plugin::AMD::EncoderH264::CapsIntraRefreshNumMBsPe
 
 void Plugin::AMD::EncoderH264::SetIntraRefreshNumMBsPerSlot(uint32_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_INTRA_REFRESH_NUM_MBS_PER_SLOT, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_INTRA_REFRESH_NUM_MBS_PER_SLOT, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -1280,33 +1279,33 @@ uint32_t Plugin::AMD::EncoderH264::GetIntraRefreshNumMBsPerSlot()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_INTRA_REFRESH_NUM_MBS_PER_SLOT, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_INTRA_REFRESH_NUM_MBS_PER_SLOT, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint32_t)e;
 }
 
 void Plugin::AMD::EncoderH264::SetIntraRefreshNumOfStripes(uint32_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(L"IntraRefreshNumOfStripes", (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(L"IntraRefreshNumOfStripes", (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to set to %ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
 uint32_t Plugin::AMD::EncoderH264::GetIntraRefreshNumOfStripes()
 {
 	int64_t    e;
-	AMF_RESULT res = m_AMFEncoder->GetProperty(L"IntraRefreshNumOfStripes", &e);
+	AMF_RESULT res = GetEncoderProperty(L"IntraRefreshNumOfStripes", &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "<%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint32_t)e;
 }
@@ -1364,6 +1363,12 @@ std::string Plugin::AMD::EncoderH264::HandleTypeOverride(amf::AMFSurfacePtr& d,
 			m_FrameSkipType = AMF_VIDEO_ENCODER_PICTURE_TYPE_NONE;
 		}
 	}
+	if (m_ForceIDR) { // New stream after a reconfiguration.
+		type       = AMF_VIDEO_ENCODER_PICTURE_TYPE_IDR;
+		m_ForceIDR = false;
+		d->SetProperty(AMF_VIDEO_ENCODER_INSERT_SPS, true);
+		d->SetProperty(AMF_VIDEO_ENCODER_INSERT_PPS, true);
+	}
 	if (type != AMF_VIDEO_ENCODER_PICTURE_TYPE_NONE)
 		d->SetProperty(AMF_VIDEO_ENCODER_FORCE_PICTURE_TYPE, type);
 
@@ -1402,6 +1407,11 @@ void Plugin::AMD::EncoderH264::LogProperties()
 	PLOG_INFO(PREFIX "      Conversion: %s", m_UniqueId, m_OpenCLConversion ? "Enabled" : "Disabled");
 	PLOG_INFO(PREFIX "    Multi-Threading: %s", m_UniqueId, m_MultiThreading ? "Enabled" : "Disabled");
 	PLOG_INFO(PREFIX "    Queue Size: %" PRIu32, m_UniqueId, (uint32_t)GetQueueSize());
+	PLOG_INFO(PREFIX "    Wait Strategy: %s", m_UniqueId, Utility::WaitStrategyToString(GetWaitStrategy()));
+	PLOG_INFO(PREFIX "    Helper Threads: %" PRIu32, m_UniqueId, (uint32_t)GetMaxHelperThreads());
+	bool hostFallback = m_Started && (GetColorConversion() == ColorConversion::Host) && !m_HostConverter;
+	PLOG_INFO(PREFIX "    Color Conversion: %s%s", m_UniqueId, Utility::ColorConversionToString(GetColorConversion()),
+			  hostFallback ? " (Unavailable, using AMF)" : "");
 #pragma endregion Backend
 #pragma region    Frame
     PLOG_INFO(PREFIX "  Frame:", m_UniqueId);
@@ -36,7 +36,7 @@ Plugin::AMD::EncoderH265::EncoderH265(std::shared_ptr<API::IAPI> videoAPI, const
 {
 	this->SetUsage(Usage::Transcoding);
 
-	AMF_RESULT res = res = m_AMFEncoder->SetProperty(L"NominalRange", m_FullColorRange);
+	AMF_RESULT res = res = SetEncoderProperty(L"NominalRange", m_FullColorRange);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, PREFIX "Failed to set encoder color range, error %ls (code %d)", m_UniqueId,
 							 m_AMF->GetTrace()->GetResultText(res), res);
@@ -53,7 +53,7 @@ std::vector<Usage> Plugin::AMD::EncoderH265::CapsUsage()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	std::vector<Usage> ret;
@@ -69,11 +69,11 @@ std::vector<Usage> Plugin::AMD::EncoderH265::CapsUsage()
 
 void Plugin::AMD::EncoderH265::SetUsage(Usage v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_USAGE, Utility::UsageToAMFH265(v));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_USAGE, Utility::UsageToAMFH265(v));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, Utility::UsageToString(v), m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -81,11 +81,11 @@ Plugin::AMD::Usage Plugin::AMD::EncoderH265::GetUsage()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_USAGE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_USAGE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return Utility::UsageFromAMFH265((AMF_VIDEO_ENCODER_HEVC_USAGE_ENUM)e);
 }
@@ -98,7 +98,7 @@ std::vector<QualityPreset> Plugin::AMD::EncoderH265::CapsQualityPreset()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	std::vector<QualityPreset> ret;
@@ -114,13 +114,12 @@ std::vector<QualityPreset> Plugin::AMD::EncoderH265::CapsQualityPreset()
 
 void Plugin::AMD::EncoderH265::SetQualityPreset(QualityPreset v)
 {
-	AMF_RESULT res =
-		m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_QUALITY_PRESET, Utility::QualityPresetToAMFH265(v));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_QUALITY_PRESET, Utility::QualityPresetToAMFH265(v));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, Utility::QualityPresetToString(v),
 							 m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -128,11 +127,11 @@ Plugin::AMD::QualityPreset Plugin::AMD::EncoderH265::GetQualityPreset()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_QUALITY_PRESET, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_QUALITY_PRESET, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return Utility::QualityPresetFromAMFH265((AMF_VIDEO_ENCODER_HEVC_QUALITY_PRESET_ENUM)e);
 }
@@ -145,7 +144,7 @@ std::pair<std::pair<uint32_t, uint32_t>, std::pair<uint32_t, uint32_t>> Plugin::
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair(std::make_pair(var->minValue.sizeValue.width, var->maxValue.sizeValue.width),
@@ -154,11 +153,11 @@ std::pair<std::pair<uint32_t, uint32_t>, std::pair<uint32_t, uint32_t>> Plugin::
 
 void Plugin::AMD::EncoderH265::SetResolution(std::pair<uint32_t, uint32_t> v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_FRAMESIZE, ::AMFConstructSize(v.first, v.second));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_FRAMESIZE, ::AMFConstructSize(v.first, v.second));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %ldx%ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v.first, v.second, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	m_Resolution.first  = v.first;
 	m_Resolution.second = v.second;
@@ -168,11 +167,11 @@ std::pair<uint32_t, uint32_t> Plugin::AMD::EncoderH265::GetResolution()
 {
 	AMFSize e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_FRAMESIZE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_FRAMESIZE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	m_Resolution.first  = e.width;
 	m_Resolution.second = e.height;
@@ -181,12 +180,11 @@ std::pair<uint32_t, uint32_t> Plugin::AMD::EncoderH265::GetResolution()
 
 void Plugin::AMD::EncoderH265::SetAspectRatio(std::pair<uint32_t, uint32_t> v)
 {
-	AMF_RESULT res =
-		m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_ASPECT_RATIO, ::AMFConstructRatio(v.first, v.second));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_ASPECT_RATIO, ::AMFConstructRatio(v.first, v.second));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %ld:%ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v.first, v.second, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -194,22 +192,22 @@ std::pair<uint32_t, uint32_t> Plugin::AMD::EncoderH265::GetAspectRatio()
 {
 	AMFRatio e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_ASPECT_RATIO, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_ASPECT_RATIO, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return std::make_pair(e.num, e.den);
 }
 
 void Plugin::AMD::EncoderH265::SetFrameRate(std::pair<uint32_t, uint32_t> v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_FRAMERATE, ::AMFConstructRate(v.first, v.second));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_FRAMERATE, ::AMFConstructRate(v.first, v.second));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %ld/%ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v.first, v.second, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	m_FrameRate = std::make_pair(v.first, v.second);
 	UpdateFrameRateValues();
@@ -219,11 +217,11 @@ std::pair<uint32_t, uint32_t> Plugin::AMD::EncoderH265::GetFrameRate()
 {
 	AMFRate e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_FRAMERATE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_FRAMERATE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> Unable to retrieve value, error %ls (code %d)", m_UniqueId,
 							 m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	m_FrameRate = std::make_pair(e.num, e.den);
 	UpdateFrameRateValues();
@@ -237,7 +235,7 @@ std::vector<Profile> Plugin::AMD::EncoderH265::CapsProfile()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	std::vector<Profile> ret;
@@ -253,12 +251,12 @@ std::vector<Profile> Plugin::AMD::EncoderH265::CapsProfile()
 
 void Plugin::AMD::EncoderH265::SetProfile(Profile v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_PROFILE, Utility::ProfileToAMFH265(v));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_PROFILE, Utility::ProfileToAMFH265(v));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, Utility::ProfileToString(v), m_AMF->GetTrace()->GetResultText(res),
 							 res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -266,11 +264,11 @@ Plugin::AMD::Profile Plugin::AMD::EncoderH265::GetProfile()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_PROFILE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_PROFILE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return Utility::ProfileFromAMFH265((AMF_VIDEO_ENCODER_HEVC_PROFILE_ENUM)e);
 }
@@ -282,7 +280,7 @@ std::vector<ProfileLevel> Plugin::AMD::EncoderH265::CapsProfileLevel()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	std::vector<ProfileLevel> ret;
@@ -320,11 +318,11 @@ void Plugin::AMD::EncoderH265::SetProfileLevel(ProfileLevel v, std::pair<uint32_
 		}
 	}
 
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_PROFILE_LEVEL, ((int64_t)v) * 3);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_PROFILE_LEVEL, ((int64_t)v) * 3);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %lld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, (int64_t)v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -332,11 +330,11 @@ Plugin::AMD::ProfileLevel Plugin::AMD::EncoderH265::GetProfileLevel()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_PROFILE_LEVEL, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_PROFILE_LEVEL, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (ProfileLevel)(e / 3);
 }
@@ -348,7 +346,7 @@ std::vector<H265::Tier> Plugin::AMD::EncoderH265::CapsTier()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	std::vector<H265::Tier> ret;
@@ -364,11 +362,11 @@ std::vector<H265::Tier> Plugin::AMD::EncoderH265::CapsTier()
 
 void Plugin::AMD::EncoderH265::SetTier(H265::Tier v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_TIER, Utility::TierToAMFH265(v));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_TIER, Utility::TierToAMFH265(v));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, Utility::TierToString(v), m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -376,11 +374,11 @@ Plugin::AMD::H265::Tier Plugin::AMD::EncoderH265::GetTier()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_TIER, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_TIER, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (H265::Tier)e;
 }
@@ -392,7 +390,7 @@ std::pair<uint64_t, uint64_t> Plugin::AMD::EncoderH265::CapsMaximumReferenceFram
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair(var->minValue.int64Value, var->maxValue.int64Value);
@@ -400,11 +398,11 @@ std::pair<uint64_t, uint64_t> Plugin::AMD::EncoderH265::CapsMaximumReferenceFram
 
 void Plugin::AMD::EncoderH265::SetMaximumReferenceFrames(uint64_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_MAX_NUM_REFRAMES, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MAX_NUM_REFRAMES, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %lld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -412,11 +410,11 @@ uint64_t Plugin::AMD::EncoderH265::GetMaximumReferenceFrames()
 {
 	uint64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_MAX_NUM_REFRAMES, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MAX_NUM_REFRAMES, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
@@ -428,7 +426,7 @@ std::vector<CodingType> Plugin::AMD::EncoderH265::CapsCodingType()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	std::vector<CodingType> ret;
@@ -444,12 +442,12 @@ std::vector<CodingType> Plugin::AMD::EncoderH265::CapsCodingType()
 
 void Plugin::AMD::EncoderH265::SetCodingType(CodingType v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_CABAC_ENABLE, Utility::CodingTypeToAMFH265(v));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_CABAC_ENABLE, Utility::CodingTypeToAMFH265(v));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, Utility::CodingTypeToString(v), m_AMF->GetTrace()->GetResultText(res),
 							 res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -457,11 +455,11 @@ Plugin::AMD::CodingType Plugin::AMD::EncoderH265::GetCodingType()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_CABAC_ENABLE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_CABAC_ENABLE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> Unable to retrieve value, error %ls (code %d)", m_UniqueId,
 							 m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return Utility::CodingTypeFromAMFH265((AMF_VIDEO_ENCODER_CODING_ENUM)e);
 }
@@ -473,7 +471,7 @@ std::pair<uint32_t, uint32_t> Plugin::AMD::EncoderH265::CapsMaximumLongTermRefer
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair((uint32_t)var->minValue.int64Value, (uint32_t)var->maxValue.int64Value);
@@ -481,22 +479,22 @@ std::pair<uint32_t, uint32_t> Plugin::AMD::EncoderH265::CapsMaximumLongTermRefer
 
 void Plugin::AMD::EncoderH265::SetMaximumLongTermReferenceFrames(uint32_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_MAX_LTR_FRAMES, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MAX_LTR_FRAMES, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
 uint32_t Plugin::AMD::EncoderH265::GetMaximumLongTermReferenceFrames()
 {
 	int64_t    e;
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_MAX_LTR_FRAMES, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MAX_LTR_FRAMES, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint32_t)e;
 }
@@ -509,7 +507,7 @@ std::vector<RateControlMethod> Plugin::AMD::EncoderH265::CapsRateControlMethod()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	std::vector<RateControlMethod> ret;
@@ -527,12 +525,12 @@ std::vector<RateControlMethod> Plugin::AMD::EncoderH265::CapsRateControlMethod()
 void Plugin::AMD::EncoderH265::SetRateControlMethod(RateControlMethod v)
 {
 	AMF_RESULT res =
-		m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_METHOD, Utility::RateControlMethodToAMFH265(v));
+		SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_METHOD, Utility::RateControlMethodToAMFH265(v));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, Utility::RateControlMethodToString(v),
 							 m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -540,11 +538,11 @@ Plugin::AMD::RateControlMethod Plugin::AMD::EncoderH265::GetRateControlMethod()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_METHOD, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_METHOD, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return Utility::RateControlMethodFromAMFH265((AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_METHOD_ENUM)e);
 }
@@ -556,7 +554,7 @@ std::vector<PrePassMode> Plugin::AMD::EncoderH265::CapsPrePassMode()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	if (var->type == amf::AMF_VARIANT_BOOL) {
 		return std::vector<PrePassMode>({PrePassMode::Disabled, PrePassMode::Enabled});
@@ -573,12 +571,12 @@ std::vector<PrePassMode> Plugin::AMD::EncoderH265::CapsPrePassMode()
 void Plugin::AMD::EncoderH265::SetPrePassMode(PrePassMode v)
 {
 	AMF_RESULT res =
-		m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_PREANALYSIS_ENABLE, v != PrePassMode::Disabled);
+		SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_PREANALYSIS_ENABLE, v != PrePassMode::Disabled);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, (v != PrePassMode::Disabled) ? "Enabled" : "Disabled",
 							 m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -586,11 +584,11 @@ Plugin::AMD::PrePassMode Plugin::AMD::EncoderH265::GetPrePassMode()
 {
 	bool e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_PREANALYSIS_ENABLE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_PREANALYSIS_ENABLE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> Unable to retrieve value, error %ls (code %d)", m_UniqueId,
 							 m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	if (e) {
 		return PrePassMode::Enabled;
@@ -601,11 +599,11 @@ Plugin::AMD::PrePassMode Plugin::AMD::EncoderH265::GetPrePassMode()
 
 void Plugin::AMD::EncoderH265::SetVarianceBasedAdaptiveQuantizationEnabled(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_ENABLE_VBAQ, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_ENABLE_VBAQ, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -613,22 +611,22 @@ bool Plugin::AMD::EncoderH265::IsVarianceBasedAdaptiveQuantizationEnabled()
 {
 	bool e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_ENABLE_VBAQ, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_ENABLE_VBAQ, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
 
 void Plugin::AMD::EncoderH265::SetHighMotionQualityBoost(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_HIGH_MOTION_QUALITY_BOOST_ENABLE, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_HIGH_MOTION_QUALITY_BOOST_ENABLE, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -636,11 +634,11 @@ bool Plugin::AMD::EncoderH265::GetHighMotionQualityBoost()
 {
 	bool e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_HIGH_MOTION_QUALITY_BOOST_ENABLE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_HIGH_MOTION_QUALITY_BOOST_ENABLE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
@@ -653,7 +651,7 @@ std::pair<uint64_t, uint64_t> Plugin::AMD::EncoderH265::CapsVBVBufferSize()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair(var->minValue.int64Value, var->maxValue.int64Value);
@@ -661,11 +659,11 @@ std::pair<uint64_t, uint64_t> Plugin::AMD::EncoderH265::CapsVBVBufferSize()
 
 void Plugin::AMD::EncoderH265::SetVBVBufferSize(uint64_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_VBV_BUFFER_SIZE, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_VBV_BUFFER_SIZE, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %lld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -673,22 +671,22 @@ uint64_t Plugin::AMD::EncoderH265::GetVBVBufferSize()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_VBV_BUFFER_SIZE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_VBV_BUFFER_SIZE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
 
 void Plugin::AMD::EncoderH265::SetVBVBufferInitialFullness(double v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_INITIAL_VBV_BUFFER_FULLNESS, (int64_t)(v * 64));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_INITIAL_VBV_BUFFER_FULLNESS, (int64_t)(v * 64));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %lf (%d), error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, (uint8_t)(v * 64), m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -696,11 +694,11 @@ float Plugin::AMD::EncoderH265::GetInitialVBVBufferFullness()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_INITIAL_VBV_BUFFER_FULLNESS, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_INITIAL_VBV_BUFFER_FULLNESS, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (e / 64.0f);
 }
@@ -713,7 +711,7 @@ std::vector<H265::GOPType> Plugin::AMD::EncoderH265::CapsGOPType()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	std::vector<H265::GOPType> ret;
@@ -729,122 +727,122 @@ std::vector<H265::GOPType> Plugin::AMD::EncoderH265::CapsGOPType()
 
 void Plugin::AMD::EncoderH265::SetGOPType(H265::GOPType v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(L"GOPType", Utility::GOPTypeToAMFH265(v));
+	AMF_RESULT res = SetEncoderProperty(L"GOPType", Utility::GOPTypeToAMFH265(v));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set mode to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, Utility::GOPTypeToString(v), m_AMF->GetTrace()->GetResultText(res),
 							 res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
 Plugin::AMD::H265::GOPType Plugin::AMD::EncoderH265::GetGOPType()
 {
 	int64_t    e;
-	AMF_RESULT res = m_AMFEncoder->GetProperty(L"GOPType", &e);
+	AMF_RESULT res = GetEncoderProperty(L"GOPType", &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return Utility::GOPTypeFromAMFH265(e);
 }
 
 void Plugin::AMD::EncoderH265::SetGOPSize(uint32_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_GOP_SIZE, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_GOP_SIZE, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
 uint32_t Plugin::AMD::EncoderH265::GetGOPSize()
 {
 	int64_t    e;
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_GOP_SIZE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_GOP_SIZE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint32_t)e;
 }
 
 void Plugin::AMD::EncoderH265::SetGOPSizeMin(uint32_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(L"GOPSizeMin", (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(L"GOPSizeMin", (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
 uint32_t Plugin::AMD::EncoderH265::GetGOPSizeMin()
 {
 	int64_t    e;
-	AMF_RESULT res = m_AMFEncoder->GetProperty(L"GOPSizeMin", &e);
+	AMF_RESULT res = GetEncoderProperty(L"GOPSizeMin", &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint32_t)e;
 }
 
 void Plugin::AMD::EncoderH265::SetGOPSizeMax(uint32_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(L"GOPSizeMax", (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(L"GOPSizeMax", (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
 uint32_t Plugin::AMD::EncoderH265::GetGOPSizeMax()
 {
 	int64_t    e;
-	AMF_RESULT res = m_AMFEncoder->GetProperty(L"GOPSizeMax", &e);
+	AMF_RESULT res = GetEncoderProperty(L"GOPSizeMax", &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint32_t)e;
 }
 
 void Plugin::AMD::EncoderH265::SetGOPAlignmentEnabled(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(L"EnableGOPAlignment", v);
+	AMF_RESULT res = SetEncoderProperty(L"EnableGOPAlignment", v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
 bool Plugin::AMD::EncoderH265::IsGOPAlignmentEnabled()
 {
 	bool       e;
-	AMF_RESULT res = m_AMFEncoder->GetProperty(L"EnableGOPAlignment", &e);
+	AMF_RESULT res = GetEncoderProperty(L"EnableGOPAlignment", &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
 
 void Plugin::AMD::EncoderH265::SetIDRPeriod(uint32_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_NUM_GOPS_PER_IDR, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_NUM_GOPS_PER_IDR, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	m_PeriodIDR = v;
 }
@@ -852,11 +850,11 @@ void Plugin::AMD::EncoderH265::SetIDRPeriod(uint32_t v)
 uint32_t Plugin::AMD::EncoderH265::GetIDRPeriod()
 {
 	int64_t    e;
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_NUM_GOPS_PER_IDR, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_NUM_GOPS_PER_IDR, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	m_PeriodIDR = (uint32_t)e;
 	return (uint32_t)e;
@@ -864,34 +862,34 @@ uint32_t Plugin::AMD::EncoderH265::GetIDRPeriod()
 
 void Plugin::AMD::EncoderH265::SetHeaderInsertionMode(H265::HeaderInsertionMode v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_HEADER_INSERTION_MODE,
-											   static_cast<AMF_VIDEO_ENCODER_HEVC_HEADER_INSERTION_MODE_ENUM>(v));
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_HEADER_INSERTION_MODE,
+										static_cast<AMF_VIDEO_ENCODER_HEVC_HEADER_INSERTION_MODE_ENUM>(v));
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
 Plugin::AMD::H265::HeaderInsertionMode Plugin::AMD::EncoderH265::GetHeaderInsertionMode()
 {
 	int64_t    e;
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_HEADER_INSERTION_MODE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_HEADER_INSERTION_MODE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return static_cast<H265::HeaderInsertionMode>(e);
 }
 
 void Plugin::AMD::EncoderH265::SetDeblockingFilterEnabled(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_DE_BLOCKING_FILTER_DISABLE, !v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_DE_BLOCKING_FILTER_DISABLE, !v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -899,23 +897,23 @@ bool Plugin::AMD::EncoderH265::IsDeblockingFilterEnabled()
 {
 	bool e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(L"HevcDeBlockingFilter", &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_DE_BLOCKING_FILTER_DISABLE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
-	return e;
+	return !e;
 }
 
 /// Motion Estimation
 void Plugin::AMD::EncoderH265::SetMotionEstimationQuarterPixelEnabled(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_MOTION_QUARTERPIXEL, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MOTION_QUARTERPIXEL, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set mode to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -923,22 +921,22 @@ bool Plugin::AMD::EncoderH265::IsMotionEstimationQuarterPixelEnabled()
 {
 	bool e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_MOTION_QUARTERPIXEL, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MOTION_QUARTERPIXEL, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
 
 void Plugin::AMD::EncoderH265::SetMotionEstimationHalfPixelEnabled(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_MOTION_HALF_PIXEL, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MOTION_HALF_PIXEL, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set mode to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -946,11 +944,11 @@ bool Plugin::AMD::EncoderH265::IsMotionEstimationHalfPixelEnabled()
 {
 	bool e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_MOTION_HALF_PIXEL, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MOTION_HALF_PIXEL, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
@@ -958,11 +956,11 @@ bool Plugin::AMD::EncoderH265::IsMotionEstimationHalfPixelEnabled()
 // Dynamic
 void Plugin::AMD::EncoderH265::SetFrameSkippingEnabled(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_SKIP_FRAME_ENABLE, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_SKIP_FRAME_ENABLE, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -970,22 +968,22 @@ bool Plugin::AMD::EncoderH265::IsFrameSkippingEnabled()
 {
 	bool e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_SKIP_FRAME_ENABLE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_SKIP_FRAME_ENABLE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
 
 void Plugin::AMD::EncoderH265::SetEnforceHRDEnabled(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_ENFORCE_HRD, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_ENFORCE_HRD, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -993,22 +991,22 @@ bool Plugin::AMD::EncoderH265::IsEnforceHRDEnabled()
 {
 	bool e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_ENFORCE_HRD, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_ENFORCE_HRD, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
 
 void Plugin::AMD::EncoderH265::SetFillerDataEnabled(bool v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_FILLER_DATA_ENABLE, v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_FILLER_DATA_ENABLE, v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %s, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v ? "Enabled" : "Disabled", m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -1016,11 +1014,11 @@ bool Plugin::AMD::EncoderH265::IsFillerDataEnabled()
 {
 	bool e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_FILLER_DATA_ENABLE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_FILLER_DATA_ENABLE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
@@ -1032,7 +1030,7 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH265::CapsIFrameQPMinimum()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair((uint8_t)var->minValue.int64Value, (uint8_t)var->maxValue.int64Value);
@@ -1040,11 +1038,11 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH265::CapsIFrameQPMinimum()
 
 void Plugin::AMD::EncoderH265::SetIFrameQPMinimum(uint8_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_MIN_QP_I, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MIN_QP_I, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %d, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -1052,11 +1050,11 @@ uint8_t Plugin::AMD::EncoderH265::GetIFrameQPMinimum()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_MIN_QP_I, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MIN_QP_I, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint8_t)e;
 }
@@ -1068,7 +1066,7 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH265::CapsIFrameQPMaximum()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair((uint8_t)var->minValue.int64Value, (uint8_t)var->maxValue.int64Value);
@@ -1076,11 +1074,11 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH265::CapsIFrameQPMaximum()
 
 void Plugin::AMD::EncoderH265::SetIFrameQPMaximum(uint8_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_MAX_QP_I, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MAX_QP_I, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %d, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -1088,11 +1086,11 @@ uint8_t Plugin::AMD::EncoderH265::GetIFrameQPMaximum()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_MAX_QP_I, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MAX_QP_I, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint8_t)e;
 }
@@ -1104,7 +1102,7 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH265::CapsPFrameQPMinimum()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair((uint8_t)var->minValue.int64Value, (uint8_t)var->maxValue.int64Value);
@@ -1112,11 +1110,11 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH265::CapsPFrameQPMinimum()
 
 void Plugin::AMD::EncoderH265::SetPFrameQPMinimum(uint8_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_MIN_QP_P, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MIN_QP_P, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %d, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -1124,11 +1122,11 @@ uint8_t Plugin::AMD::EncoderH265::GetPFrameQPMinimum()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_MIN_QP_P, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MIN_QP_P, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint8_t)e;
 }
@@ -1140,7 +1138,7 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH265::CapsPFrameQPMaximum()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair((uint8_t)var->minValue.int64Value, (uint8_t)var->maxValue.int64Value);
@@ -1148,11 +1146,11 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH265::CapsPFrameQPMaximum()
 
 void Plugin::AMD::EncoderH265::SetPFrameQPMaximum(uint8_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_MAX_QP_P, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MAX_QP_P, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %d, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -1160,11 +1158,11 @@ uint8_t Plugin::AMD::EncoderH265::GetPFrameQPMaximum()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_MAX_QP_P, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MAX_QP_P, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint8_t)e;
 }
@@ -1176,7 +1174,7 @@ std::pair<uint64_t, uint64_t> Plugin::AMD::EncoderH265::CapsTargetBitrate()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair(var->minValue.int64Value, var->maxValue.int64Value);
@@ -1184,11 +1182,11 @@ std::pair<uint64_t, uint64_t> Plugin::AMD::EncoderH265::CapsTargetBitrate()
 
 void Plugin::AMD::EncoderH265::SetTargetBitrate(uint64_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_TARGET_BITRATE, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_TARGET_BITRATE, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %lld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -1196,11 +1194,11 @@ uint64_t Plugin::AMD::EncoderH265::GetTargetBitrate()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_TARGET_BITRATE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_TARGET_BITRATE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
@@ -1212,7 +1210,7 @@ std::pair<uint64_t, uint64_t> Plugin::AMD::EncoderH265::CapsPeakBitrate()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair(var->minValue.int64Value, var->maxValue.int64Value);
@@ -1220,11 +1218,11 @@ std::pair<uint64_t, uint64_t> Plugin::AMD::EncoderH265::CapsPeakBitrate()
 
 void Plugin::AMD::EncoderH265::SetPeakBitrate(uint64_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_PEAK_BITRATE, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_PEAK_BITRATE, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %lld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -1232,11 +1230,11 @@ uint64_t Plugin::AMD::EncoderH265::GetPeakBitrate()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_PEAK_BITRATE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_PEAK_BITRATE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return e;
 }
@@ -1248,7 +1246,7 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH265::CapsIFrameQP()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair((uint8_t)var->minValue.int64Value, (uint8_t)var->maxValue.int64Value);
@@ -1256,11 +1254,11 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH265::CapsIFrameQP()
 
 void Plugin::AMD::EncoderH265::SetIFrameQP(uint8_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_QP_I, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_QP_I, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %d, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -1268,11 +1266,11 @@ uint8_t Plugin::AMD::EncoderH265::GetIFrameQP()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_QP_I, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_QP_I, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint8_t)e;
 }
@@ -1284,7 +1282,7 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH265::CapsPFrameQP()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair((uint8_t)var->minValue.int64Value, (uint8_t)var->maxValue.int64Value);
@@ -1292,11 +1290,11 @@ std::pair<uint8_t, uint8_t> Plugin::AMD::EncoderH265::CapsPFrameQP()
 
 void Plugin::AMD::EncoderH265::SetPFrameQP(uint8_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_QP_P, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_QP_P, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %d, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
@@ -1304,33 +1302,33 @@ uint8_t Plugin::AMD::EncoderH265::GetPFrameQP()
 {
 	int64_t e;
 
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_QP_P, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_QP_P, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint8_t)e;
 }
 
 void Plugin::AMD::EncoderH265::SetMaximumAccessUnitSize(uint32_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(AMF_VIDEO_ENCODER_HEVC_MAX_AU_SIZE, (int64_t)v);
+	AMF_RESULT res = SetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MAX_AU_SIZE, (int64_t)v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set to %ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
 uint32_t Plugin::AMD::EncoderH265::GetMaximumAccessUnitSize()
 {
 	int64_t    e;
-	AMF_RESULT res = m_AMFEncoder->GetProperty(AMF_VIDEO_ENCODER_HEVC_MAX_AU_SIZE, &e);
+	AMF_RESULT res = GetEncoderProperty(AMF_VIDEO_ENCODER_HEVC_MAX_AU_SIZE, &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint32_t)e;
 }
@@ -1342,7 +1340,7 @@ std::pair<uint32_t, uint32_t> Plugin::AMD::EncoderH265::CapsInputQueueSize()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Querying capabilities failed, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	return std::make_pair((uint32_t)var->minValue.int64Value, (uint32_t)var->maxValue.int64Value);
@@ -1350,22 +1348,22 @@ std::pair<uint32_t, uint32_t> Plugin::AMD::EncoderH265::CapsInputQueueSize()
 
 void Plugin::AMD::EncoderH265::SetInputQueueSize(uint32_t v)
 {
-	AMF_RESULT res = m_AMFEncoder->SetProperty(L"HevcInputQueueSize", v);
+	AMF_RESULT res = SetEncoderProperty(L"HevcInputQueueSize", v);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to set mode to %ld, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, v, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 }
 
 uint32_t Plugin::AMD::EncoderH265::GetInputQueueSize()
 {
 	int64_t    e;
-	AMF_RESULT res = m_AMFEncoder->GetProperty(L"HevcInputQueueSize", &e);
+	AMF_RESULT res = GetEncoderProperty(L"HevcInputQueueSize", &e);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %lld> <%s> Failed to retrieve value, error %ls (code %d)", m_UniqueId,
 							 __FUNCTION_NAME__, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 	return (uint32_t)e;
 }
@@ -1420,6 +1418,11 @@ std::string Plugin::AMD::EncoderH265::HandleTypeOverride(amf::AMFSurfacePtr& d,
 			m_FrameSkipType = AMF_VIDEO_ENCODER_HEVC_PICTURE_TYPE_NONE;
 		}
 	}
+	if (m_ForceIDR) { // New stream after a reconfiguration.
+		type       = AMF_VIDEO_ENCODER_HEVC_PICTURE_TYPE_IDR;
+		m_ForceIDR = false;
+		d->SetProperty(AMF_VIDEO_ENCODER_HEVC_INSERT_HEADER, true);
+	}
 	if (type != AMF_VIDEO_ENCODER_HEVC_PICTURE_TYPE_NONE)
 		d->SetProperty(AMF_VIDEO_ENCODER_FORCE_PICTURE_TYPE, type);
 
@@ -1458,6 +1461,11 @@ void Plugin::AMD::EncoderH265::LogProperties()
 	PLOG_INFO(PREFIX "      Conversion: %s", m_UniqueId, m_OpenCLConversion ? "Enabled" : "Disabled");
 	PLOG_INFO(PREFIX "    Multi-Threading: %s", m_UniqueId, m_MultiThreading ? "Enabled" : "Disabled");
 	PLOG_INFO(PREFIX "    Queue Size: %" PRIu32, m_UniqueId, (uint32_t)GetQueueSize());
+	PLOG_INFO(PREFIX "    Wait Strategy: %s", m_UniqueId, Utility::WaitStrategyToString(GetWaitStrategy()));
+	PLOG_INFO(PREFIX "    Helper Threads: %" PRIu32, m_UniqueId, (uint32_t)GetMaxHelperThreads());
+	bool hostFallback = m_Started && (GetColorConversion() == ColorConversion::Host) && !m_HostConverter;
+	PLOG_INFO(PREFIX "    Color Conversion: %s%s", m_UniqueId, Utility::ColorConversionToString(GetColorConversion()),
+			  hostFallback ? " (Unavailable, using AMF)" : "");
 #pragma endregion Backend
 #pragma region    Frame
     PLOG_INFO(PREFIX "  Frame:", m_UniqueId);
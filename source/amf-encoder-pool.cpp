@@ -0,0 +1,136 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "amf-encoder-pool.hpp"
+#include <thread>
+
+using namespace Plugin;
+using namespace Plugin::AMD;
+
+// Time in milliseconds Take() waits for a standby that is still being built, as long as a codec test may take.
+#define STANDBY_WAIT_TIMEOUT 2000
+
+static std::mutex               __lock;
+static std::condition_variable  __built;
+static std::string              __signature;
+static std::unique_ptr<Encoder> __standby;
+static uint64_t                 __generation = 0; // Changes whenever the standby is replaced or cleared.
+static size_t                   __builders   = 0;
+static bool                     __building   = false; // The standby for the current generation is being built.
+
+std::unique_ptr<Encoder> Plugin::AMD::EncoderPool::Take(const std::string& signature)
+{
+	std::unique_lock<std::mutex> lock(__lock);
+	if (__signature != signature)
+		return nullptr;
+
+	// Waiting for the rest of a build is still faster than starting from scratch, unless the build hangs.
+	uint64_t generation = __generation;
+	auto     deadline   = std::chrono::steady_clock::now() + std::chrono::milliseconds(STANDBY_WAIT_TIMEOUT);
+	if (!__built.wait_until(lock, deadline,
+							[generation] { return !__building || (__generation != generation); })) {
+		PLOG_WARNING("<EncoderPool> Standby encoder not ready after %d ms, creating a new one instead.",
+					 STANDBY_WAIT_TIMEOUT);
+		return nullptr;
+	}
+	if (__generation != generation)
+		return nullptr;
+
+	return std::move(__standby);
+}
+
+void Plugin::AMD::EncoderPool::Prepare(const std::string&                         signature,
+									   std::function<std::unique_ptr<Encoder>()> factory)
+{
+	std::unique_ptr<Encoder> old;
+	{
+		const std::lock_guard<std::mutex> lock(__lock);
+		if ((__signature == signature) && (__standby || __building))
+			return;
+
+		old         = std::move(__standby);
+		__signature = signature;
+		__generation++;
+		__building = true;
+		__builders++;
+		std::thread(Build, __generation, factory).detach();
+	}
+	Destroy(std::move(old));
+}
+
+void Plugin::AMD::EncoderPool::Clear()
+{
+	std::unique_ptr<Encoder> old;
+	{
+		std::unique_lock<std::mutex> lock(__lock);
+		old = std::move(__standby);
+		__signature.clear();
+		__generation++;
+		__building = false;
+		__built.notify_all();
+		__built.wait(lock, [] { return __builders == 0; });
+	}
+	Destroy(std::move(old));
+}
+
+void Plugin::AMD::EncoderPool::Build(uint64_t generation, std::function<std::unique_ptr<Encoder>()> factory)
+{
+	std::unique_ptr<Encoder> encoder;
+	auto                     clk_start = std::chrono::high_resolution_clock::now();
+	try {
+		encoder = factory();
+		PLOG_INFO("<EncoderPool> Standby encoder ready after %.1f ms.",
+				  std::chrono::duration<double_t, std::milli>(std::chrono::high_resolution_clock::now() - clk_start)
+					  .count());
+	} catch (const std::exception& ex) {
+		PLOG_WARNING("<EncoderPool> Unable to create standby encoder: %s", ex.what());
+	} catch (...) {
+		PLOG_WARNING("<EncoderPool> Unable to create standby encoder.");
+	}
+
+	{
+		const std::lock_guard<std::mutex> lock(__lock);
+		if (__generation == generation) {
+			__standby  = std::move(encoder);
+			__building = false;
+			__built.notify_all();
+		}
+	}
+
+	// Replaced or cleared while building, Clear() must not return before this is gone.
+	Destroy(std::move(encoder));
+
+	const std::lock_guard<std::mutex> lock(__lock);
+	__builders--;
+	__built.notify_all();
+}
+
+void Plugin::AMD::EncoderPool::Destroy(std::unique_ptr<Encoder> encoder)
+{
+	if (!encoder)
+		return;
+
+	try {
+		if (encoder->IsStarted())
+			encoder->Stop();
+	} catch (const std::exception& ex) {
+		PLOG_WARNING("<EncoderPool> Unable to stop standby encoder: %s", ex.what());
+	}
+	encoder = nullptr;
+}
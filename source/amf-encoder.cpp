@@ -19,13 +19,27 @@
 
 #include "amf-encoder.hpp"
 #include <cinttypes>
+#include <cstring>
+#include <cwchar>
 #include <thread>
+#include "amf-property-transaction.hpp"
 #include "utility.hpp"
 
 #include <components/VideoConverter.h>
 #include <components/VideoEncoderHEVC.h>
 #include <components/VideoEncoderVCE.h>
 
+// Upper limit for the memory used by the host surface pool of a single encoder.
+#define SURFACE_POOL_BUDGET (512ull * 1024ull * 1024ull)
+// Minimum alignment of OBS frame memory and row pitch for it to be submitted without a copy.
+#define HOST_FRAME_ALIGNMENT 32
+// Minimum number of frames tracked by the telemetry ring, must be well above the number of frames in flight.
+#define FRAME_TELEMETRY_CAPACITY 256
+// Default number of helper threads for host uploads.
+#define DEFAULT_HELPER_THREADS 2
+// Most planes of a surface, I420 has three.
+#define MAX_SURFACE_PLANES 3
+
 using namespace Plugin;
 using namespace Plugin::AMD;
 
@@ -44,6 +58,13 @@ Plugin::AMD::Encoder::Encoder(Codec codec, std::shared_ptr<API::IAPI> videoAPI,
 	m_AMFConverter     = nullptr;
 	m_AMFMemoryType    = amf::AMF_MEMORY_UNKNOWN;
 	m_AMFSurfaceFormat = Utility::ColorFormatToAMF(colorFormat);
+	m_SurfacePool      = nullptr;
+	m_HostConverter    = nullptr;
+	m_BandPool         = nullptr;
+	m_SharedContext    = nullptr;
+	m_SharedInput      = nullptr;
+	m_InputSource      = nullptr;
+	m_Transaction      = nullptr;
 
 	/// API Related
 	m_API              = nullptr;
@@ -51,7 +72,10 @@ Plugin::AMD::Encoder::Encoder(Codec codec, std::shared_ptr<API::IAPI> videoAPI,
 	m_OpenCLSubmission = false;
 
 	/// Properties
-	m_QueueSize = queueSize;
+	m_QueueSize        = queueSize;
+	m_PreRollFrames    = 0;
+	m_ColorConversion  = ColorConversion::AMF;
+	m_MaxHelperThreads = DEFAULT_HELPER_THREADS;
 
 	/// Resolution + Rate
 	m_Resolution        = std::make_pair<uint32_t, uint32_t>(0, 0);
@@ -61,8 +85,11 @@ Plugin::AMD::Encoder::Encoder(Codec codec, std::shared_ptr<API::IAPI> videoAPI,
 	/// Flags
 	m_Initialized = true;
 	m_Started     = false;
-	m_OpenCL      = false;
-	m_Debug       = false;
+	m_OpenCL            = false;
+	m_HostFrameWrapping = false;
+	m_HostFrameWrapped  = false;
+	m_StreamingCopy     = false;
+	m_Debug             = false;
 
 	/// Timings
 	m_TimestampStep        = 0;
@@ -71,11 +98,23 @@ Plugin::AMD::Encoder::Encoder(Codec codec, std::shared_ptr<API::IAPI> videoAPI,
 	m_SubmitQueryWaitTimer = std::chrono::milliseconds(1);
 	m_SubmitQueryAttempts  = 16;
 	m_InitialFrameLatency  = 0;
+	m_WaitStrategy         = WaitStrategy::Hybrid;
+	m_PacketRetention.resize(1);
+	m_PacketRetentionIndex = 0;
+	m_FrameWaitTime        = std::chrono::nanoseconds(0);
+	m_TotalWaitTime        = std::chrono::nanoseconds(0);
+	m_EncodedFrameCount    = 0;
 
 	/// Status
+	m_WrappedFrameCount      = 0;
+	m_CopiedFrameCount       = 0;
+	m_ConverterSkippedCount  = 0;
+	m_SharedFrameCount       = 0;
 	m_SubmittedFrameCount    = 0;
 	m_InitialFramesSent      = false;
 	m_InitialPacketRetrieved = false;
+	m_QueuedFrameCount       = 0;
+	m_DroppedFrameCount      = 0;
 
 	/// Periods
 	m_PeriodIDR            = 0;
@@ -84,6 +123,7 @@ Plugin::AMD::Encoder::Encoder(Codec codec, std::shared_ptr<API::IAPI> videoAPI,
 	m_PeriodBFrame         = 0;
 	m_FrameSkipPeriod      = 0;
 	m_FrameSkipKeepOnlyNth = false;
+	m_ForceIDR             = false;
 
 	/// Multi-Threading
 	m_MultiThreading = multiThreading;
@@ -99,64 +139,24 @@ Plugin::AMD::Encoder::Encoder(Codec codec, std::shared_ptr<API::IAPI> videoAPI,
 	m_OpenCLSubmission = useOpenCLSubmission;
 	m_OpenCLConversion = useOpenCLConversion;
 
-	// Initialize selected API on Video Adapter
-	m_API        = videoAPI;
-	m_APIAdapter = videoAdapter;
-	m_APIDevice  = m_API->CreateInstance(m_APIAdapter);
-
 	// Initialize Advanced Media Framework
 	m_AMF = AMF::Instance();
 	m_AMF->EnableDebugTrace(m_Debug);
 	m_AMFFactory = m_AMF->GetFactory();
 
-	// Create Context for Conversion and Encoding
-	AMF_RESULT res = m_AMFFactory->CreateContext(&m_AMFContext);
-	if (res != AMF_OK) {
-		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Creating a AMF Context failed, error %ls (code %d).", m_UniqueId,
-							 m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
-	}
-	/// Initialize Context using selected API
-	switch (m_API->GetType()) {
-	case API::Type::Direct3D11:
-	case API::Type::Direct3D9:
-		break;
-	default:
-#pragma warning(push)
-#pragma warning(disable : 4062)
-		m_API = API::GetAPI(0);
-		switch (m_API->GetType()) {
-		case API::Type::Direct3D9:
-			m_APIAdapter = m_API->EnumerateAdapters()[0];
-			m_APIDevice  = m_API->CreateInstance(m_APIAdapter);
-			break;
-		case API::Type::Direct3D11:
-			m_APIAdapter = m_API->EnumerateAdapters()[0];
-			m_APIDevice  = m_API->CreateInstance(m_APIAdapter);
-			break;
-		}
-	}
-	switch (m_API->GetType()) {
-	case API::Type::Direct3D9:
-		m_AMFMemoryType = amf::AMF_MEMORY_DX9;
-		res             = m_AMFContext->InitDX9(m_APIDevice->GetContext());
-		break;
-	case API::Type::Direct3D11:
-		m_AMFMemoryType = amf::AMF_MEMORY_DX11;
-		res             = m_AMFContext->InitDX11(m_APIDevice->GetContext());
-		break;
-	}
-#pragma warning(pop)
-	if (res != AMF_OK) {
-		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Initializing %s API with Adapter '%s' failed, error %ls (code %d).",
-							 m_UniqueId, m_API->GetName().c_str(), m_APIAdapter.Name.c_str(),
-							 m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
-	}
+	// Borrow Device and Context for Conversion and Encoding, other encoders on the same adapter may use them too.
+	m_SharedContext = SharedContext::Acquire(videoAPI, videoAdapter);
+	m_API           = m_SharedContext->GetAPI();
+	m_APIAdapter    = m_SharedContext->GetAdapter();
+	m_APIDevice     = m_SharedContext->GetDevice();
+	m_AMFContext    = m_SharedContext->GetContext();
+	m_AMFMemoryType = m_SharedContext->GetMemoryType();
+
+	AMF_RESULT res;
 
 	// Initialize OpenCL (if possible)
 	if (m_OpenCLSubmission || m_OpenCLConversion) {
-		res = m_AMFContext->InitOpenCL();
+		res = m_SharedContext->InitOpenCL();
 		if (res == AMF_OK) {
 			m_OpenCL = true;
 
@@ -180,46 +180,12 @@ Plugin::AMD::Encoder::Encoder(Codec codec, std::shared_ptr<API::IAPI> videoAPI,
 		}
 	}
 
-	// Create Converter
-	res = m_AMFFactory->CreateComponent(m_AMFContext, AMFVideoConverter, &m_AMFConverter);
-	if (res != AMF_OK) {
-		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Creating frame converter component failed, error %ls (code %d)",
-							 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
-	}
-	res = m_AMFConverter->SetProperty(AMF_VIDEO_CONVERTER_MEMORY_TYPE, amf::AMF_MEMORY_UNKNOWN);
-	if (res != AMF_OK) {
-		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Unable to set converter memory type, error %ls (code %d)", m_UniqueId,
-							 m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
-	}
-	res = m_AMFConverter->SetProperty(AMF_VIDEO_CONVERTER_OUTPUT_FORMAT, amf::AMF_SURFACE_NV12);
-	if (res != AMF_OK) {
-		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Unable to set converter output format, error %ls (code %d)",
-							 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
-	}
-	res =
-		m_AMFConverter->SetProperty(AMF_VIDEO_CONVERTER_COLOR_PROFILE, Utility::ColorSpaceToAMFConverter(m_ColorSpace));
-	if (res != AMF_OK) {
-		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Unable to set converter color profile, error %ls (code %d)",
-							 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
-	}
-	res = m_AMFConverter->SetProperty(AMF_VIDEO_CONVERTER_TRANSFER_CHARACTERISTIC,
-									  Utility::ColorSpaceToTransferCharacteristic(m_ColorSpace));
-	if (res != AMF_OK) {
-		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Unable to set converter transfer characteristic, error %ls (code %d)",
-							 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
-		PLOG_WARNING("%s", errMsg.c_str());
-	}
-
 	// Create Encoder
 	res = m_AMFFactory->CreateComponent(m_AMFContext, Utility::CodecToAMF(codec), &m_AMFEncoder);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Unable to create %s encoder, error %ls (code %d)", m_UniqueId,
 							 Utility::CodecToString(codec), m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
 
 	// Show complete initialization in log.
@@ -241,17 +207,21 @@ Plugin::AMD::Encoder::~Encoder()
 		m_AMFConverter = nullptr;
 	}
 
-	// Destroy AMF Context
-	if (m_AMFContext) {
-		m_AMFContext->Terminate();
-		m_AMFContext = nullptr;
+	// Leave the shared input, if the encoder was never stopped.
+	if (m_SharedInput) {
+		m_SharedInput->Unsubscribe();
+		m_SharedInput = nullptr;
 	}
 
-	// Destroy API
-	if (m_API) {
-		m_APIDevice = nullptr;
-		m_API       = nullptr;
-	}
+	// Destroy Surface Pool (after all components released their surfaces, shared frames keep it alive)
+	m_SurfacePool = nullptr;
+
+	// Release AMF Context and API, the last encoder on the adapter destroys them.
+	m_AMFCompute    = nullptr;
+	m_AMFContext    = nullptr;
+	m_APIDevice     = nullptr;
+	m_API           = nullptr;
+	m_SharedContext = nullptr;
 
 	m_AMF = nullptr;
 
@@ -316,11 +286,205 @@ void Plugin::AMD::Encoder::SetDebug(bool v)
 	m_AMF->EnableDebugTrace(m_Debug);
 }
 
+void Plugin::AMD::Encoder::SetWaitStrategy(WaitStrategy v)
+{
+	m_WaitStrategy = v;
+}
+
+WaitStrategy Plugin::AMD::Encoder::GetWaitStrategy()
+{
+	return m_WaitStrategy;
+}
+
+void Plugin::AMD::Encoder::SetMaxHelperThreads(size_t v)
+{
+	m_MaxHelperThreads = v;
+}
+
+size_t Plugin::AMD::Encoder::GetMaxHelperThreads()
+{
+	return m_MaxHelperThreads;
+}
+
+void Plugin::AMD::Encoder::SetColorConversion(ColorConversion v)
+{
+	if (m_Started)
+		throw std::logic_error("Color conversion can't be changed while the encoder is running!");
+
+	m_ColorConversion = v;
+}
+
+ColorConversion Plugin::AMD::Encoder::GetColorConversion()
+{
+	return m_ColorConversion;
+}
+
+void Plugin::AMD::Encoder::SetPacketRetention(size_t v)
+{
+	if (m_Started)
+		throw std::logic_error("Packet retention can't be changed while the encoder is running!");
+
+	m_PacketRetention.clear();
+	m_PacketRetention.resize(max(v, (size_t)1));
+	m_PacketRetentionIndex = 0;
+}
+
+size_t Plugin::AMD::Encoder::GetPacketRetention()
+{
+	return m_PacketRetention.size();
+}
+
+void Plugin::AMD::Encoder::SetPreRollFrames(uint32_t v)
+{
+	if (m_Started)
+		throw std::logic_error("Pre-roll can't be changed while the encoder is running!");
+
+	m_PreRollFrames = v;
+}
+
+uint32_t Plugin::AMD::Encoder::GetPreRollFrames()
+{
+	return m_PreRollFrames;
+}
+
 bool Plugin::AMD::Encoder::IsDebug()
 {
 	return m_Debug;
 }
 
+AMF_RESULT Plugin::AMD::Encoder::SetEncoderProperty(const wchar_t* name, const amf::AMFVariant& value)
+{
+	if (m_Transaction) {
+		// Sending is deferred to Commit(), so reject what the runtime would refuse now for the setter to report.
+		AMF_RESULT res = ValidateEncoderProperty(name, value);
+		if (res != AMF_OK)
+			return res;
+
+		m_Transaction->Record(name, value);
+		return AMF_OK;
+	}
+
+	if (IsEncoderPropertyApplied(name, value))
+		return AMF_OK;
+	AMF_RESULT res = ApplyEncoderProperty(name, value);
+	if (res == AMF_OK)
+		ReadBackEncoderProperty(*FindEncoderProperty(name));
+	return res;
+}
+
+AMF_RESULT Plugin::AMD::Encoder::GetEncoderProperty(const wchar_t* name, amf::AMFVariant* value)
+{
+	if (m_Transaction && m_Transaction->Find(name, value))
+		return AMF_OK;
+
+	EncoderProperty* prop = FindEncoderProperty(name);
+	if (prop != nullptr) {
+		*value = prop->applied;
+		return AMF_OK;
+	}
+
+	// Never set, so the runtime default is read once and kept.
+	AMF_RESULT res = m_AMFEncoder->GetProperty(name, value);
+	if (res == AMF_OK)
+		m_Properties.push_back({name, *value});
+	return res;
+}
+
+AMF_RESULT Plugin::AMD::Encoder::ValidateEncoderProperty(const wchar_t* name, const amf::AMFVariant& value)
+{
+	const amf::AMFPropertyInfo* info = nullptr;
+	if (m_AMFEncoder->GetPropertyInfo(name, &info) != AMF_OK || (info == nullptr))
+		return AMF_NOT_FOUND; // Not described, so the runtime would refuse it when committed.
+	if (!info->AllowedWrite())
+		return AMF_ACCESS_DENIED;
+	if (info->type == amf::AMF_VARIANT_INTERFACE)
+		return AMF_OK;
+
+	amf::AMFVariant converted;
+	if (amf::AMFVariantChangeType(&converted, &value, info->type) != AMF_OK)
+		return AMF_INVALID_DATA_TYPE;
+
+	if (info->type == amf::AMF_VARIANT_INT64) {
+		int64_t v = converted.ToInt64();
+		if (info->pEnumDescription != nullptr) {
+			for (const amf::AMFEnumDescriptionEntry* entry = info->pEnumDescription; entry->name != nullptr; entry++) {
+				if (entry->value == v)
+					return AMF_OK;
+			}
+			return AMF_OUT_OF_RANGE;
+		}
+		if ((info->minValue.int64Value < info->maxValue.int64Value)
+			&& ((v < info->minValue.int64Value) || (v > info->maxValue.int64Value)))
+			return AMF_OUT_OF_RANGE;
+	} else if (info->type == amf::AMF_VARIANT_DOUBLE) {
+		double_t v = converted.ToDouble();
+		if ((info->minValue.doubleValue < info->maxValue.doubleValue)
+			&& ((v < info->minValue.doubleValue) || (v > info->maxValue.doubleValue)))
+			return AMF_OUT_OF_RANGE;
+	}
+	return AMF_OK;
+}
+
+Plugin::AMD::Encoder::EncoderProperty* Plugin::AMD::Encoder::FindEncoderProperty(const wchar_t* name)
+{
+	// Callers pass the AMF constants, so comparing the address almost always finds it.
+	for (EncoderProperty& prop : m_Properties) {
+		if (prop.name == name)
+			return &prop;
+	}
+	for (EncoderProperty& prop : m_Properties) {
+		if (wcscmp(prop.name, name) == 0)
+			return &prop;
+	}
+	return nullptr;
+}
+
+bool Plugin::AMD::Encoder::IsEncoderPropertyApplied(const wchar_t* name, const amf::AMFVariant& value)
+{
+	// Compared against what the runtime reports, as setting another property may have changed it since.
+	EncoderProperty* prop = FindEncoderProperty(name);
+	if ((prop == nullptr) || (prop->applied.type == amf::AMF_VARIANT_EMPTY))
+		return false;
+
+	amf::AMFVariant converted;
+	if (amf::AMFVariantChangeType(&converted, &value, prop->applied.type) != AMF_OK)
+		return false;
+	return prop->applied == converted;
+}
+
+AMF_RESULT Plugin::AMD::Encoder::ApplyEncoderProperty(const wchar_t* name, const amf::AMFVariant& value)
+{
+	AMF_RESULT res = m_AMFEncoder->SetProperty(name, value);
+	if (res != AMF_OK)
+		return res;
+
+	// Usage resets every other property to its default.
+	if ((wcscmp(name, AMF_VIDEO_ENCODER_USAGE) == 0) || (wcscmp(name, AMF_VIDEO_ENCODER_HEVC_USAGE) == 0))
+		m_Properties.clear();
+
+	EncoderProperty* prop = FindEncoderProperty(name);
+	if (prop == nullptr) {
+		m_Properties.push_back({name, value});
+	} else {
+		prop->applied = value;
+	}
+	return AMF_OK;
+}
+
+void Plugin::AMD::Encoder::ReadBackEncoderProperty(EncoderProperty& prop)
+{
+	// The runtime may round, clamp or change the type, getters report what it actually uses.
+	amf::AMFVariant value;
+	if (m_AMFEncoder->GetProperty(prop.name, &value) == AMF_OK)
+		prop.applied = value;
+}
+
+void Plugin::AMD::Encoder::ReadBackEncoderProperties()
+{
+	for (EncoderProperty& prop : m_Properties)
+		ReadBackEncoderProperty(prop);
+}
+
 #ifndef LITE_OBS
 void Plugin::AMD::Encoder::UpdateFrameRateValues()
 {
@@ -429,32 +593,62 @@ void Plugin::AMD::Encoder::Start()
 {
 	AMF_RESULT res;
 
-	res = m_AMFConverter->Init(Utility::ColorFormatToAMF(m_ColorFormat), m_Resolution.first, m_Resolution.second);
-	if (res != AMF_OK) {
-		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Unable to initialize converter, error %ls (code %d)", m_UniqueId,
-							 m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+	// Host Conversion, needs the frame in host memory and an encoder input surface to write to.
+	if ((m_ColorConversion == ColorConversion::Host) && (m_ColorFormat != ColorFormat::NV12)) {
+		if (m_OpenCLSubmission || !HostColorConverter::IsFormatSupported(m_ColorFormat)) {
+			PLOG_WARNING("<Id: %llu> Color conversion on the CPU is not possible with %s%s, using AMF instead.",
+						 m_UniqueId, Utility::ColorFormatToString(m_ColorFormat),
+						 m_OpenCLSubmission ? " and OpenCL transfer" : "");
+		} else {
+			m_HostConverter = std::make_unique<HostColorConverter>(m_ColorFormat, m_ColorSpace, m_FullColorRange);
+			PLOG_DEBUG("<Id: %llu> Converting frames on the CPU with %s kernel.", m_UniqueId,
+					   HostColorConverter::GetKernelName());
+		}
+	}
+
+	// Converter, only if the surfaces don't already match the encoder input.
+	if ((m_ColorFormat != ColorFormat::NV12) && !m_HostConverter) {
+		if (!m_AMFConverter)
+			CreateConverter();
+
+		res = m_AMFConverter->Init(Utility::ColorFormatToAMF(m_ColorFormat), m_Resolution.first, m_Resolution.second);
+		if (res != AMF_OK) {
+			QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Unable to initialize converter, error %ls (code %d)", m_UniqueId,
+								 m_AMF->GetTrace()->GetResultText(res), res);
+			throw std::runtime_error(errMsg.c_str());
+		}
+	} else {
+		PLOG_DEBUG("<Id: %llu> Submitting NV12 surfaces to the encoder without a converter.", m_UniqueId);
 	}
 
 	res = m_AMFEncoder->Init(amf::AMF_SURFACE_NV12, m_Resolution.first, m_Resolution.second);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Failed to initialize encoder, error %ls (code %d)", m_UniqueId,
 							 m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
+	// Initialization may adjust properties, so the next update sends everything again.
+	m_Properties.clear();
+
+	// Surface Pool
+	if (!m_OpenCLSubmission)
+		CreateSurfacePool();
+
+	m_Statistics.Reset();
+	m_Telemetry = std::make_unique<FrameTelemetry>(max((size_t)FRAME_TELEMETRY_CAPACITY, m_QueueSize * 4));
+
+	if (m_PreRollFrames > 0)
+		PreRoll();
+
+	if (m_InputSource)
+		SubscribeInput();
 
 	// Threading
 	if (m_MultiThreading) {
-		m_AsyncSend                  = new EncoderThreadingData;
-		m_AsyncSend->shutdown        = false;
-		m_AsyncSend->wakeupcount     = 0; // 2 ^ 32;
-		m_AsyncSend->data            = nullptr;
-		m_AsyncSend->worker          = std::thread(AsyncSendMain, this);
-		m_AsyncRetrieve              = new EncoderThreadingData;
-		m_AsyncRetrieve->shutdown    = false;
-		m_AsyncRetrieve->wakeupcount = 0;
-		m_AsyncRetrieve->data        = nullptr;
-		m_AsyncRetrieve->worker      = std::thread(AsyncRetrieveMain, this);
+		m_AsyncSend             = new EncoderThreadingData(m_QueueSize);
+		m_AsyncRetrieve         = new EncoderThreadingData(m_QueueSize);
+		m_AsyncSend->worker     = std::thread(AsyncSendMain, this);
+		m_AsyncRetrieve->worker = std::thread(AsyncRetrieveMain, this);
 	}
 
 	m_Started = true;
@@ -466,8 +660,11 @@ void Plugin::AMD::Encoder::Restart()
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Could not re-initialize encoder, error %ls (code %d)", m_UniqueId,
 							 m_AMF->GetTrace()->GetResultText(res), res);
-		throw std::exception(errMsg.c_str());
+		throw std::runtime_error(errMsg.c_str());
 	}
+	m_Properties.clear();
+	if (m_MultiThreading)
+		m_AsyncRetrieve->eof = false;
 }
 
 void Plugin::AMD::Encoder::Stop()
@@ -475,41 +672,289 @@ void Plugin::AMD::Encoder::Stop()
 	if (!m_Started)
 		throw std::logic_error("Can't stop an encoder that isn't running!");
 
-	m_AMFConverter->Drain();
-	m_AMFConverter->Flush();
-	m_AMFEncoder->Drain();
+	// Nobody is interested in the remaining packets, but the workers must be idle before shutting down.
+	if (!Drain(nullptr, m_SubmitQueryWaitTimer * m_SubmitQueryAttempts * (m_QueueSize + 1))) {
+		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Encoder did not finish draining in time.", m_UniqueId);
+		PLOG_WARNING("%s", errMsg.data());
+	}
+
+	if (m_AMFConverter) {
+		m_AMFConverter->Drain();
+		m_AMFConverter->Flush();
+	}
 	m_AMFEncoder->Flush();
 
 	// Threading
 	if (m_MultiThreading) {
-		{
-			std::unique_lock<std::mutex> lock(m_AsyncRetrieve->mutex);
-			m_AsyncRetrieve->shutdown    = true;
-			m_AsyncRetrieve->wakeupcount = 2 ^ 32;
-			m_AsyncRetrieve->condvar.notify_all();
-			m_AsyncRetrieve->data = nullptr;
-		}
+		// Both workers signal each other, so neither may be destroyed before both have exited.
+		m_AsyncRetrieve->shutdown = true;
+		m_AsyncRetrieve->event.Notify();
+		m_AsyncSend->shutdown = true;
+		m_AsyncSend->event.Notify();
 		m_AsyncRetrieve->worker.join();
-		delete m_AsyncRetrieve;
-		{
-			std::unique_lock<std::mutex> lock(m_AsyncSend->mutex);
-			m_AsyncSend->shutdown    = true;
-			m_AsyncSend->wakeupcount = 2 ^ 32;
-			m_AsyncSend->condvar.notify_all();
-			m_AsyncSend->data = nullptr;
-		}
 		m_AsyncSend->worker.join();
+		delete m_AsyncRetrieve;
 		delete m_AsyncSend;
 	}
 
+	if (m_DroppedFrameCount > 0) {
+		PLOG_WARNING("<Id: %llu> Dropped %llu of %llu frames because the encoder was overloaded.", m_UniqueId,
+					 m_DroppedFrameCount, m_DroppedFrameCount + m_QueuedFrameCount);
+	}
+	if (m_EncodedFrameCount > 0) {
+		LogStatistics();
+		PLOG_INFO("<Id: %llu> Waited %.3f ms per frame on average for the encoder (%s).", m_UniqueId,
+				  (double_t)m_TotalWaitTime.count() / (double_t)m_EncodedFrameCount / 1000000.0,
+				  Utility::WaitStrategyToString(m_WaitStrategy));
+	}
+
+	// Surface Pool
+	if (m_SurfacePool) {
+		SurfacePoolStatistics stats = m_SurfacePool->GetStatistics();
+		PLOG_INFO("<Id: %llu> Surface pool: %llu hits, %llu misses, %llu of %llu surfaces used at most.", m_UniqueId,
+				  stats.hits, stats.misses, (unsigned long long)stats.highwater, (unsigned long long)stats.capacity);
+		PLOG_INFO("<Id: %llu> Host frames: %llu submitted directly, %llu copied.", m_UniqueId, m_WrappedFrameCount,
+				  m_CopiedFrameCount);
+		m_SurfacePool = nullptr;
+	}
+	if (m_ConverterSkippedCount > 0) {
+		PLOG_INFO("<Id: %llu> Converter skipped for %llu frames.", m_UniqueId, m_ConverterSkippedCount);
+	}
+	if (m_SharedInput) {
+		PLOG_INFO("<Id: %llu> Took %llu frames converted by another encoder.", m_UniqueId, m_SharedFrameCount);
+		m_SharedInput->Unsubscribe();
+		m_SharedInput = nullptr;
+	}
+	m_HostConverter = nullptr;
+	m_BandPool      = nullptr;
+
+	// Packets are no longer valid after stopping.
+	for (amf::AMFBufferPtr& buffer : m_PacketRetention)
+		buffer = nullptr;
+	m_PacketRetentionIndex = 0;
+	m_HeldPackets.clear();
+
 	m_Started = false;
 }
 
+void Plugin::AMD::Encoder::Reconfigure(std::pair<uint32_t, uint32_t>               resolution,
+									   std::pair<uint32_t, uint32_t>               frameRate,
+									   std::function<void(struct encoder_packet*)> callback)
+{
+	if (!m_Started)
+		throw std::logic_error("Can't reconfigure an encoder that isn't running!");
+
+	AMF_RESULT res;
+	auto       clk_start = std::chrono::high_resolution_clock::now();
+
+	// Finish the old stream, every frame submitted so far still belongs to it. Packets are loaded right away, the
+	// timestamps depend on the current frame rate.
+	if (!callback)
+		callback = [this](struct encoder_packet* packet) { HoldPacket(packet); };
+	if (!Drain(callback, m_SubmitQueryWaitTimer * m_SubmitQueryAttempts * (m_QueueSize + 1))) {
+		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Encoder did not finish draining in time, packets were lost.",
+							 m_UniqueId);
+		PLOG_WARNING("%s", errMsg.data());
+	}
+
+	// Frame rate is a dynamic property, the frame size is applied by re-initializing.
+	if (frameRate != m_FrameRate)
+		SetFrameRate(frameRate);
+	if (resolution != m_Resolution) {
+		m_Resolution = resolution;
+
+		if (m_AMFConverter) {
+			m_AMFConverter->Flush();
+			res = m_AMFConverter->ReInit(m_Resolution.first, m_Resolution.second);
+			if (res != AMF_OK) {
+				QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Could not re-initialize converter, error %ls (code %d)",
+									 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
+				throw std::runtime_error(errMsg.c_str());
+			}
+		}
+		if (m_SurfacePool)
+			CreateSurfacePool();
+
+		// Frames of the old size can't be shared anymore.
+		if (m_SharedInput) {
+			m_SharedInput->Unsubscribe();
+			m_SharedInput = nullptr;
+			SubscribeInput();
+		}
+	}
+	Restart();
+
+	// Same as a fresh start, except that the parameter sets have to be repeated in the stream.
+	m_InitialFramesSent      = false;
+	m_InitialPacketRetrieved = false;
+	m_ForceIDR               = true;
+
+	std::chrono::duration<double_t, std::milli> elapsed = std::chrono::high_resolution_clock::now() - clk_start;
+	PLOG_INFO("<Id: %llu> Reconfigured to %" PRIu32 "x%" PRIu32 " at %" PRIu32 "/%" PRIu32 " fps in %.1f ms.",
+			  m_UniqueId, m_Resolution.first, m_Resolution.second, m_FrameRate.first, m_FrameRate.second,
+			  elapsed.count());
+}
+
 bool Plugin::AMD::Encoder::IsStarted()
 {
 	return m_Started;
 }
 
+void Plugin::AMD::Encoder::SetInputSource(video_t* v)
+{
+	if (m_SharedInput) {
+		m_SharedInput->Unsubscribe();
+		m_SharedInput = nullptr;
+	}
+
+	m_InputSource = v;
+	if (m_Started && m_InputSource)
+		SubscribeInput();
+}
+
+void Plugin::AMD::Encoder::SubscribeInput()
+{
+	// Keyed by everything that affects the converted frame.
+	SharedInputFormat format;
+	format.source     = m_InputSource;
+	format.format     = m_AMFSurfaceFormat;
+	format.colorSpace = (uint32_t)m_ColorSpace;
+	format.fullRange  = m_FullColorRange;
+	format.width      = m_Resolution.first;
+	format.height     = m_Resolution.second;
+
+	m_SharedInput = SharedInput::Acquire(m_SharedContext, format);
+	m_SharedInput->Subscribe();
+}
+
+// A black frame with the plane layout OBS uses for the format.
+static void make_black_frame(ColorFormat format, bool fullRange, uint32_t width, uint32_t height,
+							 std::vector<uint8_t>& buffer, struct encoder_frame& frame)
+{
+	uint8_t black = fullRange ? 0 : 16;
+	size_t  w = width, h = height, cw = (w + 1) / 2, ch = (h + 1) / 2;
+
+	frame = {};
+	switch (format) {
+	case ColorFormat::NV12:
+	case ColorFormat::I420:
+		buffer.assign(w * h + cw * ch * 2, 128);
+		std::memset(buffer.data(), black, w * h);
+		frame.data[0]     = buffer.data();
+		frame.linesize[0] = (uint32_t)w;
+		frame.data[1]     = buffer.data() + w * h;
+		if (format == ColorFormat::NV12) {
+			frame.linesize[1] = (uint32_t)(cw * 2);
+		} else {
+			frame.linesize[1] = (uint32_t)cw;
+			frame.data[2]     = frame.data[1] + cw * ch;
+			frame.linesize[2] = (uint32_t)cw;
+		}
+		break;
+	case ColorFormat::YUY2:
+		buffer.assign(cw * 4 * h, 128);
+		for (size_t idx = 0; idx < buffer.size(); idx += 2)
+			buffer[idx] = black;
+		frame.data[0]     = buffer.data();
+		frame.linesize[0] = (uint32_t)(cw * 4);
+		break;
+	case ColorFormat::RGBA:
+	case ColorFormat::BGRA:
+		buffer.assign(w * 4 * h, 0);
+		frame.data[0]     = buffer.data();
+		frame.linesize[0] = (uint32_t)(w * 4);
+		break;
+	case ColorFormat::GRAY:
+		buffer.assign(w * h, black);
+		frame.data[0]     = buffer.data();
+		frame.linesize[0] = (uint32_t)w;
+		break;
+	}
+}
+
+void Plugin::AMD::Encoder::PreRoll()
+{
+	auto clk_start = std::chrono::high_resolution_clock::now();
+	auto deadline  = clk_start + m_SubmitQueryWaitTimer * m_SubmitQueryAttempts * (m_PreRollFrames + m_QueueSize + 1);
+
+	std::vector<uint8_t> buffer;
+	struct encoder_frame frame;
+	make_black_frame(m_ColorFormat, m_FullColorRange, m_Resolution.first, m_Resolution.second, buffer, frame);
+
+	// The frames take the same path as real ones, but the telemetry has no rows for them.
+	uint64_t packets  = 0;
+	bool     complete = true;
+	for (uint32_t index = 0; (index < m_PreRollFrames) && complete; index++) {
+		amf::AMFSurfacePtr surface = nullptr;
+		amf::AMFDataPtr    data    = nullptr;
+		frame.pts                  = index;
+		if (!EncodeAllocate(surface, &frame) || !EncodeStore(surface, &frame)
+			|| !EncodeConvert(surface, data, &frame)) {
+			complete = false;
+			break;
+		}
+
+		for (uint64_t attempt = 0;; attempt++) {
+			AMF_RESULT res = m_AMFEncoder->SubmitInput(data);
+			if (res == AMF_OK)
+				break;
+			if ((res != AMF_INPUT_FULL) || (std::chrono::high_resolution_clock::now() >= deadline)) {
+				complete = false;
+				break;
+			}
+
+			// Make room by throwing away a packet.
+			amf::AMFDataPtr packet;
+			if (m_AMFEncoder->QueryOutput(&packet) == AMF_OK) {
+				packets++;
+			} else {
+				m_WaitEvent.Poll(m_WaitStrategy, attempt, m_SubmitQueryWaitTimer);
+			}
+		}
+	}
+
+	// Every frame has to come out again, otherwise the hardware never did the work.
+	if (complete && (m_AMFEncoder->Drain() == AMF_OK)) {
+		for (uint64_t attempt = 0;; attempt++) {
+			amf::AMFDataPtr packet;
+			AMF_RESULT      res = m_AMFEncoder->QueryOutput(&packet);
+			if (res == AMF_OK) {
+				packets++;
+				continue;
+			}
+			if (res == AMF_EOF)
+				break;
+			if ((res != AMF_REPEAT) || (std::chrono::high_resolution_clock::now() >= deadline)) {
+				complete = false;
+				break;
+			}
+			m_WaitEvent.Poll(m_WaitStrategy, attempt, m_SubmitQueryWaitTimer);
+		}
+	} else {
+		complete = false;
+	}
+
+	// Start over, the first real frame begins a new stream with an IDR frame.
+	if (m_AMFConverter) {
+		m_AMFConverter->Drain();
+		m_AMFConverter->Flush();
+	}
+	m_AMFEncoder->Flush();
+	m_WrappedFrameCount     = 0;
+	m_CopiedFrameCount      = 0;
+	m_ConverterSkippedCount = 0;
+
+	std::chrono::duration<double_t, std::milli> elapsed = std::chrono::high_resolution_clock::now() - clk_start;
+	if (complete) {
+		PLOG_INFO("<Id: %llu> Pre-roll of %" PRIu32 " frames took %.1f ms, %llu packets discarded.", m_UniqueId,
+				  m_PreRollFrames, elapsed.count(), packets);
+	} else {
+		PLOG_WARNING("<Id: %llu> Pre-roll of %" PRIu32 " frames did not complete after %.1f ms, %llu packets "
+					 "discarded.",
+					 m_UniqueId, m_PreRollFrames, elapsed.count(), packets);
+	}
+}
+
 bool Plugin::AMD::Encoder::Encode(struct encoder_frame* frame, struct encoder_packet* packet, bool* received_packet)
 {
 	if (!m_Started)
@@ -519,25 +964,267 @@ bool Plugin::AMD::Encoder::Encode(struct encoder_frame* frame, struct encoder_pa
 	amf::AMFDataPtr    surface_data = nullptr;
 	amf::AMFDataPtr    packet_data  = nullptr;
 
-	// Encoding Steps
-	if (!EncodeAllocate(surface))
-		return false;
-	if (!EncodeStore(surface, frame))
-		return false;
-	if (!EncodeConvert(surface, surface_data))
-		return false;
-	if (!EncodeMain(surface_data, packet_data))
-		return false;
+	m_FrameWaitTime = std::chrono::nanoseconds(0);
+
+	m_Telemetry->Begin(frame->pts);
+	m_Telemetry->Set(frame->pts, TelemetryField::StartTimestamp,
+					 std::chrono::nanoseconds(std::chrono::high_resolution_clock::now().time_since_epoch()).count());
+
+	// Encoding Steps, a frame that another encoder converted already only needs its own timestamps.
+	uint64_t sharedFrame = 0;
+	if (m_SharedInput) {
+		// Encoders start counting PTS at zero, but the frame counter of the video output is the same for all of them.
+		sharedFrame = video_output_get_total_frames(static_cast<const video_t*>(m_InputSource));
+	}
+	if (m_SharedInput && m_SharedInput->Claim(sharedFrame, surface_data)) {
+		surface = amf::AMFSurfacePtr(surface_data);
+		StampFrame(surface, frame);
+		m_SharedFrameCount++;
+	} else {
+		bool converted = EncodeAllocate(surface, frame) && EncodeStore(surface, frame)
+						 && EncodeConvert(surface, surface_data, frame);
+		if (m_SharedInput) {
+			if (converted) {
+				m_SharedInput->Publish(sharedFrame, surface_data, m_SurfacePool);
+			} else {
+				m_SharedInput->Abandon(sharedFrame);
+			}
+		}
+		if (!converted)
+			return false;
+	}
+	if (m_MultiThreading) {
+		if (!EncodeQueue(surface_data, packet_data))
+			return false;
+	} else {
+		if (!EncodeMain(surface_data, packet_data))
+			return false;
+	}
 	if (!EncodeLoad(packet_data, packet, received_packet))
 		return false;
 
+	// Held packets go out first, one per call. The data stays valid until the next call, like any other packet.
+	if (!m_HeldPackets.empty()) {
+		if (*received_packet)
+			HoldPacket(packet);
+		std::pair<struct encoder_packet, std::vector<uint8_t>>& held = m_HeldPackets.front();
+		m_PacketDataBuffer.swap(held.second);
+		*packet          = held.first;
+		packet->data     = m_PacketDataBuffer.data();
+		*received_packet = true;
+		m_HeldPackets.pop_front();
+	}
+
+	m_TotalWaitTime += m_FrameWaitTime;
+	m_EncodedFrameCount++;
+	m_Statistics.Record(EncoderStage::Wait, m_FrameWaitTime);
+	if (m_Statistics.IsSummaryDue())
+		LogStatistics();
+
 	return true;
 }
 
+std::chrono::nanoseconds Plugin::AMD::Encoder::GetFrameWaitTime()
+{
+	return m_FrameWaitTime;
+}
+
+Plugin::AMD::LatencySummary Plugin::AMD::Encoder::GetLatencySummary(EncoderStage stage)
+{
+	return m_Statistics.GetSummary(stage);
+}
+
+void Plugin::AMD::Encoder::LogStatistics()
+{
+	const std::pair<EncoderStage, const char*> stages[] = {
+		{EncoderStage::Allocate, "Allocate"}, {EncoderStage::Store, "Store"}, {EncoderStage::Convert, "Convert"},
+		{EncoderStage::Main, "Main"},         {EncoderStage::Load, "Load"},   {EncoderStage::Wait, "Wait"},
+	};
+
+	// One line for all stages, in microseconds: p50/p90/p99/max.
+	std::string line;
+	for (auto& stage : stages) {
+		LatencySummary summary = m_Statistics.GetSummary(stage.first);
+		QUICK_FORMAT_MESSAGE(part, " %s(%.0f/%.0f/%.0f/%.0f)", stage.second, summary.p50 / 1000.0,
+							 summary.p90 / 1000.0, summary.p99 / 1000.0, summary.max / 1000.0);
+		line += part;
+	}
+	PLOG_INFO("<Id: %llu> Latency in us (p50/p90/p99/max):%s", m_UniqueId, line.c_str());
+}
+
+void Plugin::AMD::Encoder::CreateConverter()
+{
+	AMF_RESULT res = m_AMFFactory->CreateComponent(m_AMFContext, AMFVideoConverter, &m_AMFConverter);
+	if (res != AMF_OK) {
+		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Creating frame converter component failed, error %ls (code %d)",
+							 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
+		throw std::runtime_error(errMsg.c_str());
+	}
+	res = m_AMFConverter->SetProperty(AMF_VIDEO_CONVERTER_MEMORY_TYPE, amf::AMF_MEMORY_UNKNOWN);
+	if (res != AMF_OK) {
+		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Unable to set converter memory type, error %ls (code %d)", m_UniqueId,
+							 m_AMF->GetTrace()->GetResultText(res), res);
+		throw std::runtime_error(errMsg.c_str());
+	}
+	res = m_AMFConverter->SetProperty(AMF_VIDEO_CONVERTER_OUTPUT_FORMAT, amf::AMF_SURFACE_NV12);
+	if (res != AMF_OK) {
+		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Unable to set converter output format, error %ls (code %d)",
+							 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
+		throw std::runtime_error(errMsg.c_str());
+	}
+	res =
+		m_AMFConverter->SetProperty(AMF_VIDEO_CONVERTER_COLOR_PROFILE, Utility::ColorSpaceToAMFConverter(m_ColorSpace));
+	if (res != AMF_OK) {
+		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Unable to set converter color profile, error %ls (code %d)",
+							 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
+		throw std::runtime_error(errMsg.c_str());
+	}
+	res = m_AMFConverter->SetProperty(AMF_VIDEO_CONVERTER_TRANSFER_CHARACTERISTIC,
+									  Utility::ColorSpaceToTransferCharacteristic(m_ColorSpace));
+	if (res != AMF_OK) {
+		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Unable to set converter transfer characteristic, error %ls (code %d)",
+							 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
+		PLOG_WARNING("%s", errMsg.c_str());
+	}
+}
+
+void Plugin::AMD::Encoder::CreateSurfacePool()
+{
+	// Enough surfaces for a full queue, the one in the converter (or encoder) and the one being filled.
+	amf::AMF_SURFACE_FORMAT format = m_HostConverter ? amf::AMF_SURFACE_NV12 : m_AMFSurfaceFormat;
+	int32_t                 hPitch, vPitch;
+	size_t                  slotSize;
+	SurfacePool::CalculateLayout(format, m_Resolution.first, m_Resolution.second, hPitch, vPitch, slotSize);
+	size_t maxCapacity = max((size_t)(SURFACE_POOL_BUDGET / slotSize), (size_t)2);
+	size_t capacity    = min(m_QueueSize + 2, maxCapacity);
+
+	m_SurfacePool =
+		std::make_shared<SurfacePool>(m_AMFContext, format, m_Resolution.first, m_Resolution.second, capacity);
+	PLOG_DEBUG("<Id: %llu> Surface pool with %llu surfaces of %llu bytes created.", m_UniqueId,
+			   (unsigned long long)capacity, (unsigned long long)slotSize);
+
+	// OBS frames can only be wrapped if a conversion to GPU memory detaches the surface from them. Frames
+	// converted on the CPU never match the encoder input format.
+	m_HostFrameWrapping = (m_AMFMemoryType != amf::AMF_MEMORY_HOST) && !m_HostConverter;
+
+	m_StreamingCopy = PlaneCopy::IsStreamingWorthwhile(slotSize);
+	PLOG_DEBUG("<Id: %llu> Copying planes with %s kernel, %s stores (last level cache is %llu bytes).", m_UniqueId,
+			   PlaneCopy::GetKernelName(PlaneCopy::GetKernel()), m_StreamingCopy ? "non-temporal" : "regular",
+			   (unsigned long long)PlaneCopy::GetLastLevelCacheSize());
+
+	// Bands for uploads on multiple threads, every plane may be split into as many bands as there are threads.
+	m_BandPool = BandPool::Instance();
+	m_BandPlanner.Reset(m_Resolution.first, m_Resolution.second);
+	m_UploadBands.reserve(MAX_SURFACE_PLANES * (BandPool::GetHelperLimit() + 1));
+}
+
+uint64_t Plugin::AMD::Encoder::GetConverterSkippedCount()
+{
+	return m_ConverterSkippedCount;
+}
+
+uint64_t Plugin::AMD::Encoder::GetDroppedFrameCount()
+{
+	return m_DroppedFrameCount;
+}
+
+bool Plugin::AMD::Encoder::Drain(std::function<void(struct encoder_packet*)> callback,
+								 std::chrono::nanoseconds                   timeout)
+{
+	if (!m_Started)
+		throw std::logic_error("Can't drain an encoder that isn't running!");
+
+	auto     deadline = std::chrono::high_resolution_clock::now() + timeout;
+	uint64_t attempt  = 0;
+
+	// Packets held back by a reconfiguration are older than anything still in the encoder.
+	std::deque<std::pair<struct encoder_packet, std::vector<uint8_t>>> held;
+	held.swap(m_HeldPackets);
+	if (callback) {
+		for (std::pair<struct encoder_packet, std::vector<uint8_t>>& kv : held)
+			callback(&kv.first);
+	}
+
+	auto deliver = [&](amf::AMFDataPtr& packet_data) {
+		if (!callback)
+			return;
+		struct encoder_packet packet          = {};
+		bool                  received_packet = false;
+		if (EncodeLoad(packet_data, &packet, &received_packet) && received_packet)
+			callback(&packet);
+	};
+
+	// Everything queued must reach the encoder before the end of the stream is signaled. Packets are picked up
+	// meanwhile, or a full retrieve queue keeps the encoder from accepting the rest.
+	if (m_MultiThreading) {
+		while (m_SubmittedFrameCount < m_QueuedFrameCount) {
+			amf::AMFDataPtr packet_data;
+			if (m_AsyncRetrieve->queue.Pop(packet_data)) {
+				m_AsyncRetrieve->event.Notify();
+				deliver(packet_data);
+				attempt = 0;
+				continue;
+			}
+
+			if (std::chrono::high_resolution_clock::now() >= deadline)
+				return false;
+			m_AsyncSend->event.Notify();
+			m_WaitEvent.Wait(m_WaitStrategy, attempt++, m_SubmitQueryWaitTimer);
+		}
+	}
+
+	AMF_RESULT res = m_AMFEncoder->Drain();
+	if (res != AMF_OK) {
+		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> [Drain] Unable to drain encoder, error %ls (code %d)", m_UniqueId,
+							 m_AMF->GetTrace()->GetResultText(res), res);
+		PLOG_WARNING("%s", errMsg.data());
+		return false;
+	}
+
+	for (attempt = 0;; attempt++) {
+		amf::AMFDataPtr packet_data;
+		bool            eof = false;
+
+		if (m_MultiThreading) {
+			m_AsyncRetrieve->event.Notify();
+			if (m_AsyncRetrieve->queue.Pop(packet_data)) {
+				m_AsyncRetrieve->event.Notify();
+			} else {
+				eof = m_AsyncRetrieve->eof && m_AsyncRetrieve->queue.Empty();
+			}
+		} else {
+			res = m_AMFEncoder->QueryOutput(&packet_data);
+			if (res == AMF_EOF) {
+				eof = true;
+			} else if ((res != AMF_OK) && (res != AMF_REPEAT)) {
+				QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> [Drain] Retrieving Packet failed, error %ls (code %d)",
+									 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
+				PLOG_WARNING("%s", errMsg.data());
+				return false;
+			}
+		}
+
+		if (packet_data != nullptr) {
+			attempt = 0;
+			deliver(packet_data);
+			continue;
+		}
+
+		if (eof)
+			return true;
+		if (std::chrono::high_resolution_clock::now() >= deadline)
+			return false;
+		if (m_MultiThreading)
+			m_WaitEvent.Wait(m_WaitStrategy, attempt, m_SubmitQueryWaitTimer);
+		else
+			m_WaitEvent.Poll(m_WaitStrategy, attempt, m_SubmitQueryWaitTimer);
+	}
+}
+
 void Plugin::AMD::Encoder::GetVideoInfo(struct video_scale_info* info)
 {
 	if (!m_AMFContext || !m_AMFEncoder)
-		throw std::exception("Called while not initialized.");
+		throw std::runtime_error("Called while not initialized.");
 
 	switch (m_ColorFormat) {
 	// 4:2:0 Formats
@@ -574,7 +1261,7 @@ void Plugin::AMD::Encoder::GetVideoInfo(struct video_scale_info* info)
 bool Plugin::AMD::Encoder::GetExtraData(uint8_t** extra_data, size_t* size)
 {
 	if (!m_AMFContext || !m_AMFEncoder)
-		throw std::exception("Called while not initialized.");
+		throw std::runtime_error("Called while not initialized.");
 
 	amf::AMFVariant var;
 	AMF_RESULT      res = GetExtraDataInternal(&var);
@@ -591,19 +1278,168 @@ bool Plugin::AMD::Encoder::GetExtraData(uint8_t** extra_data, size_t* size)
 	return false;
 }
 
-bool Plugin::AMD::Encoder::EncodeAllocate(OUT amf::AMFSurfacePtr& surface)
+bool Plugin::AMD::Encoder::IsHostFrameWrappable(IN struct encoder_frame* frame, OUT int32_t& hPitch,
+												OUT int32_t& vPitch)
+{
+	// A host surface is a single allocation, described by the pitch of the first plane and the number of rows
+	// between the start of the first and the second plane. OBS frames only qualify if they match that layout.
+	uint32_t pitch = frame->linesize[0];
+	if ((pitch == 0) || (pitch % HOST_FRAME_ALIGNMENT) != 0)
+		return false;
+	if ((reinterpret_cast<uintptr_t>(frame->data[0]) % HOST_FRAME_ALIGNMENT) != 0)
+		return false;
+
+	hPitch = static_cast<int32_t>(pitch);
+	vPitch = static_cast<int32_t>(m_Resolution.second);
+
+	switch (m_ColorFormat) {
+	case ColorFormat::NV12:
+	case ColorFormat::I420: {
+		if (frame->data[1] <= frame->data[0])
+			return false;
+		size_t offset = static_cast<size_t>(frame->data[1] - frame->data[0]);
+		if ((offset % pitch) != 0)
+			return false;
+		vPitch = static_cast<int32_t>(offset / pitch);
+		if ((vPitch < static_cast<int32_t>(m_Resolution.second)) || (vPitch % 2) != 0)
+			return false;
+
+		if (m_ColorFormat == ColorFormat::NV12) {
+			return (frame->linesize[1] == pitch);
+		} else {
+			return (frame->linesize[1] == pitch / 2) && (frame->linesize[2] == pitch / 2)
+				   && (frame->data[2] == frame->data[1] + static_cast<size_t>(pitch / 2) * (vPitch / 2));
+		}
+	}
+	case ColorFormat::YUY2:
+	case ColorFormat::BGRA:
+	case ColorFormat::RGBA:
+	case ColorFormat::GRAY:
+		return true;
+	}
+	return false;
+}
+
+void Plugin::AMD::Encoder::StoreHostFrame(IN amf::AMFSurfacePtr& surface, IN struct encoder_frame* frame)
+{
+	struct Plane {
+		uint8_t*       dst;
+		size_t         dstPitch;
+		const uint8_t* src;
+		size_t         srcPitch;
+		size_t         rowSize;
+		uint32_t       rows;
+	} planes[MAX_SURFACE_PLANES];
+
+	size_t planeCount = min(surface->GetPlanesCount(), (size_t)MAX_SURFACE_PLANES);
+	for (uint8_t i = 0; i < planeCount; i++) {
+		amf::AMFPlanePtr plane = surface->GetPlaneAt(i);
+		planes[i].dst          = static_cast<uint8_t*>(plane->GetNative());
+		planes[i].dstPitch     = (size_t)plane->GetHPitch();
+		planes[i].src          = frame->data[i];
+		planes[i].srcPitch     = (size_t)frame->linesize[i];
+		// Only the visible part of each row, the padding on either side is of no interest to the encoder.
+		planes[i].rowSize = min((size_t)plane->GetWidth() * (size_t)plane->GetPixelSizeInBytes(),
+								(size_t)frame->linesize[i]);
+		planes[i].rows    = (uint32_t)plane->GetHeight();
+	}
+
+	// Every plane is split into the same number of bands, so the planes of a frame are uploaded side by side.
+	size_t bands = m_BandPlanner.GetBandCount(m_MaxHelperThreads);
+	m_UploadBands.clear();
+	if (m_HostConverter) {
+		// Bands of whole row pairs, so each one covers complete chroma rows.
+		uint32_t pairs = (m_Resolution.second + 1) / 2;
+		for (size_t band = 0; band < bands; band++) {
+			uint32_t first = (uint32_t)(pairs * band / bands) * 2;
+			uint32_t last  = min((uint32_t)(pairs * (band + 1) / bands) * 2, m_Resolution.second);
+			if (last > first)
+				m_UploadBands.push_back({0, first, last - first, 0});
+		}
+	} else {
+		for (uint8_t i = 0; i < planeCount; i++) {
+			for (size_t band = 0; band < bands; band++) {
+				uint32_t first = (uint32_t)(planes[i].rows * band / bands);
+				uint32_t last  = (uint32_t)(planes[i].rows * (band + 1) / bands);
+				if (last > first)
+					m_UploadBands.push_back({i, first, last - first, 0});
+			}
+		}
+	}
+
+	auto upload = [this, &planes, frame](size_t index) {
+		UploadBand& band  = m_UploadBands[index];
+		auto        start = std::chrono::high_resolution_clock::now();
+		if (m_HostConverter) {
+			Plane& luma = planes[0];
+			Plane& chroma = planes[1];
+			m_HostConverter->Convert(frame->data[0] + (size_t)band.row * frame->linesize[0],
+									 (size_t)frame->linesize[0], luma.dst + band.row * luma.dstPitch, luma.dstPitch,
+									 chroma.dst + (band.row / 2) * chroma.dstPitch, chroma.dstPitch,
+									 m_Resolution.first, band.rows);
+		} else {
+			Plane& plane = planes[band.plane];
+			PlaneCopy::Copy(plane.dst + band.row * plane.dstPitch, plane.dstPitch,
+							plane.src + band.row * plane.srcPitch, plane.srcPitch, plane.rowSize, band.rows,
+							m_StreamingCopy);
+		}
+		band.time = std::chrono::nanoseconds(std::chrono::high_resolution_clock::now() - start).count();
+	};
+	m_BandPool->Run(m_UploadBands.size(), bands - 1, upload);
+
+	// The planner wants the time a single thread would have needed.
+	std::chrono::nanoseconds work(0);
+	for (UploadBand& band : m_UploadBands)
+		work += std::chrono::nanoseconds(band.time);
+	m_BandPlanner.Record(work);
+}
+
+std::string Plugin::AMD::Encoder::StampFrame(IN amf::AMFSurfacePtr& surface, IN struct encoder_frame* frame)
+{
+	int64_t tsLast = (int64_t)round((frame->pts - 1) * m_TimestampStep);
+	int64_t tsNow  = (int64_t)round(frame->pts * m_TimestampStep);
+
+	/// Decode Timestamp
+	surface->SetPts(tsNow);
+	/// Presentation Timestamp
+	surface->SetProperty(AMF_PRESENT_TIMESTAMP, frame->pts);
+	/// Duration
+	surface->SetDuration(tsNow - tsLast);
+	/// Type override
+	return HandleTypeOverride(surface, frame->pts);
+}
+
+bool Plugin::AMD::Encoder::EncodeAllocate(OUT amf::AMFSurfacePtr& surface, IN struct encoder_frame* frame)
 {
 	AMF_RESULT res;
 	auto       clk_start = std::chrono::high_resolution_clock::now();
 
+	// Wrap the frame memory if possible, EncodeStore verifies that it is no longer referenced afterwards.
+	m_HostFrameWrapped = false;
+	int32_t hPitch, vPitch;
+	if (m_HostFrameWrapping && IsHostFrameWrappable(frame, hPitch, vPitch)) {
+		m_HostFrameObserver.Reset();
+		res = m_AMFContext->CreateSurfaceFromHostNative(m_AMFSurfaceFormat, m_Resolution.first, m_Resolution.second,
+														hPitch, vPitch, frame->data[0], &surface,
+														&m_HostFrameObserver);
+		if (res == AMF_OK) {
+			m_HostFrameWrapped = true;
+		} else {
+			QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Unable to wrap frame memory, error %ls (code %d)", m_UniqueId,
+								 m_AMF->GetTrace()->GetResultText(res), res);
+			PLOG_DEBUG("%s", errMsg.data());
+		}
+	}
+
 	// Allocate
-	if (m_OpenCLSubmission) {
+	if (m_HostFrameWrapped) {
+		res = AMF_OK;
+	} else if (m_OpenCLSubmission) {
 		res = m_AMFContext->AllocSurface(m_AMFMemoryType, m_AMFSurfaceFormat, m_Resolution.first, m_Resolution.second,
 										 &surface);
 	} else {
 		// Required when not using OpenCL, can't directly write to GPU memory with memcpy.
-		res = m_AMFContext->AllocSurface(amf::AMF_MEMORY_HOST, m_AMFSurfaceFormat, m_Resolution.first,
-										 m_Resolution.second, &surface);
+		res = m_SurfacePool->Acquire(&surface);
 	}
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Unable to allocate Surface, error %ls (code %d)", m_UniqueId,
@@ -613,12 +1449,9 @@ bool Plugin::AMD::Encoder::EncodeAllocate(OUT amf::AMFSurfacePtr& surface)
 	}
 
 	// Performance Tracking
-	auto     clk_end      = std::chrono::high_resolution_clock::now();
-	uint64_t pf_timestamp = std::chrono::nanoseconds(clk_end.time_since_epoch()).count();
-	uint64_t pf_time      = std::chrono::nanoseconds(clk_end - clk_start).count();
-
-	surface->SetProperty(AMF_TIMESTAMP_ALLOCATE, pf_timestamp);
-	surface->SetProperty(AMF_TIME_ALLOCATE, pf_time);
+	auto clk_end = std::chrono::high_resolution_clock::now();
+	m_Telemetry->Set(frame->pts, TelemetryField::AllocateTime,
+					 std::chrono::nanoseconds(clk_end - clk_start).count());
 
 	return true;
 }
@@ -627,9 +1460,13 @@ bool Plugin::AMD::Encoder::EncodeStore(OUT amf::AMFSurfacePtr& surface, IN struc
 {
 	AMF_RESULT                  res;
 	amf::AMFComputeSyncPointPtr pSyncPoint;
-	auto                        clk_start = std::chrono::high_resolution_clock::now();
+	auto                        clk_start    = std::chrono::high_resolution_clock::now();
+	std::chrono::nanoseconds    convert_time = std::chrono::nanoseconds(0);
 
+	// The OpenCL queue belongs to the shared context.
+	std::unique_lock<std::mutex> compute_lock(m_SharedContext->GetComputeLock(), std::defer_lock);
 	if (m_OpenCLSubmission) {
+		compute_lock.lock();
 		m_AMFCompute->PutSyncPoint(&pSyncPoint);
 		res = surface->Convert(amf::AMF_MEMORY_OPENCL);
 		if (res != AMF_OK) {
@@ -641,18 +1478,12 @@ bool Plugin::AMD::Encoder::EncodeStore(OUT amf::AMFSurfacePtr& surface, IN struc
 		}
 	}
 
-	size_t planeCount = surface->GetPlanesCount();
-	for (uint8_t i = 0; i < planeCount; i++) {
-		amf::AMFPlanePtr plane  = surface->GetPlaneAt(i);
-		int32_t          width  = plane->GetWidth();
-		int32_t          height = plane->GetHeight();
-		int32_t          hpitch = plane->GetHPitch();
-
-		if (m_OpenCLSubmission) {
+	if (m_OpenCLSubmission) {
+		for (uint8_t i = 0; i < surface->GetPlanesCount(); i++) {
+			amf::AMFPlanePtr      plane      = surface->GetPlaneAt(i);
 			static const amf_size l_origin[] = {0, 0, 0};
-			const amf_size        l_size[]   = {(amf_size)width, (amf_size)height, 1};
-			res = m_AMFCompute->CopyPlaneFromHost(frame->data[i], l_origin, l_size, frame->linesize[i],
-												  surface->GetPlaneAt(i), false);
+			const amf_size        l_size[]   = {(amf_size)plane->GetWidth(), (amf_size)plane->GetHeight(), 1};
+			res = m_AMFCompute->CopyPlaneFromHost(frame->data[i], l_origin, l_size, frame->linesize[i], plane, false);
 			if (res != AMF_OK) {
 				QUICK_FORMAT_MESSAGE(errMsg,
 									 "<Id: %llu> [Store] Unable to copy plane %d with OpenCL, error %ls (code %d)",
@@ -660,15 +1491,13 @@ bool Plugin::AMD::Encoder::EncodeStore(OUT amf::AMFSurfacePtr& surface, IN struc
 				PLOG_WARNING("%s", errMsg.data());
 				return false;
 			}
-		} else {
-			void* plane_nat = plane->GetNative();
-			for (int32_t py = 0; py < height; py++) {
-				int32_t plane_off = py * hpitch;
-				int32_t frame_off = py * frame->linesize[i];
-				std::memcpy(static_cast<void*>(static_cast<uint8_t*>(plane_nat) + plane_off),
-							static_cast<void*>(frame->data[i] + frame_off), frame->linesize[i]);
-			}
 		}
+	} else if (!m_HostFrameWrapped) {
+		// With host conversion the surface is NV12 already, which replaces both the plane copy and EncodeConvert.
+		auto clk_upload = std::chrono::high_resolution_clock::now();
+		StoreHostFrame(surface, frame);
+		if (m_HostConverter)
+			convert_time = std::chrono::high_resolution_clock::now() - clk_upload;
 	}
 
 	if (m_OpenCLSubmission) {
@@ -680,34 +1509,48 @@ bool Plugin::AMD::Encoder::EncodeStore(OUT amf::AMFSurfacePtr& surface, IN struc
 			return false;
 		}
 		pSyncPoint->Wait();
+		compute_lock.unlock();
 	}
 	res = surface->Convert(m_AMFMemoryType);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> [Store] Conversion of Surface failed, error %ls (code %d)", m_UniqueId,
 							 m_AMF->GetTrace()->GetResultText(res), res);
 		PLOG_WARNING("%s", errMsg.data());
+		if (m_HostFrameWrapped)
+			surface = nullptr;
 		return false;
 	}
 
-	// Data Stuff
-	int64_t tsLast = (int64_t)round((frame->pts - 1) * m_TimestampStep);
-	int64_t tsNow  = (int64_t)round(frame->pts * m_TimestampStep);
+	if (m_HostFrameWrapped) {
+		if (!m_HostFrameObserver.IsReleased()) {
+			// The runtime still holds on to the OBS frame, which becomes invalid once we return. Give up on the
+			// wrapped surface and copy from now on.
+			QUICK_FORMAT_MESSAGE(notice,
+								 "<Id: %llu> [Store] Runtime keeps host memory referenced after upload, submitting "
+								 "frames without a copy is not possible.",
+								 m_UniqueId);
+			PLOG_INFO("%s", notice.data());
+			m_HostFrameWrapping = false;
+
+			surface = nullptr;
+			if (!EncodeAllocate(surface, frame))
+				return false;
+			return EncodeStore(surface, frame);
+		}
+		m_WrappedFrameCount++;
+	} else {
+		m_CopiedFrameCount++;
+	}
 
-	/// Decode Timestamp
-	surface->SetPts(tsNow);
-	/// Presentation Timestamp
-	surface->SetProperty(AMF_PRESENT_TIMESTAMP, frame->pts);
-	/// Duration
-	surface->SetDuration(tsNow - tsLast);
-	/// Type override
-	std::string printableType = HandleTypeOverride(surface, frame->pts);
+	// Data Stuff
+	std::string printableType = StampFrame(surface, frame);
 
-	// Performance Tracking
-	auto     clk_end      = std::chrono::high_resolution_clock::now();
-	uint64_t pf_timestamp = std::chrono::nanoseconds(clk_end.time_since_epoch()).count();
-	uint64_t pf_time      = std::chrono::nanoseconds(clk_end - clk_start).count();
-	surface->SetProperty(AMF_TIMESTAMP_STORE, pf_timestamp);
-	surface->SetProperty(AMF_TIME_STORE, pf_time);
+	// Performance Tracking, the conversion on the CPU counts as Convert to keep both converters comparable.
+	auto clk_end = std::chrono::high_resolution_clock::now();
+	m_Telemetry->Set(frame->pts, TelemetryField::StoreTime,
+					 std::chrono::nanoseconds(clk_end - clk_start - convert_time).count());
+	if (m_HostConverter)
+		m_Telemetry->Set(frame->pts, TelemetryField::ConvertTime, convert_time.count());
 
 	if (m_Debug) {
 		PLOG_DEBUG("<Id: %llu> EncodeStore: PTS(%8lld) DTS(%8lld) TS(%16lld) Duration(%16lld) Type(%s)", m_UniqueId,
@@ -717,11 +1560,19 @@ bool Plugin::AMD::Encoder::EncodeStore(OUT amf::AMFSurfacePtr& surface, IN struc
 	return true;
 }
 
-bool Plugin::AMD::Encoder::EncodeConvert(IN amf::AMFSurfacePtr& surface, OUT amf::AMFDataPtr& data)
+bool Plugin::AMD::Encoder::EncodeConvert(IN amf::AMFSurfacePtr& surface, OUT amf::AMFDataPtr& data,
+										 IN struct encoder_frame* frame)
 {
 	AMF_RESULT res;
 	auto       clk_start = std::chrono::high_resolution_clock::now();
 
+	// Surface is NV12 already, either from OBS or converted in EncodeStore.
+	if (!m_AMFConverter) {
+		data = amf::AMFDataPtr(surface);
+		m_ConverterSkippedCount++;
+		return true;
+	}
+
 	if (m_OpenCLConversion) {
 		res = surface->Convert(amf::AMF_MEMORY_OPENCL);
 		if (res != AMF_OK) {
@@ -757,11 +1608,8 @@ bool Plugin::AMD::Encoder::EncodeConvert(IN amf::AMFSurfacePtr& surface, OUT amf
 	}
 
 	// Performance Tracking
-	auto     clk_end      = std::chrono::high_resolution_clock::now();
-	uint64_t pf_timestamp = std::chrono::nanoseconds(clk_end.time_since_epoch()).count();
-	uint64_t pf_time      = std::chrono::nanoseconds(clk_end - clk_start).count();
-	surface->SetProperty(AMF_TIMESTAMP_CONVERT, pf_timestamp);
-	surface->SetProperty(AMF_TIME_CONVERT, pf_time);
+	auto clk_end = std::chrono::high_resolution_clock::now();
+	m_Telemetry->Set(frame->pts, TelemetryField::ConvertTime, std::chrono::nanoseconds(clk_end - clk_start).count());
 
 	return true;
 }
@@ -770,14 +1618,18 @@ bool Plugin::AMD::Encoder::EncodeMain(IN amf::AMFDataPtr& data, OUT amf::AMFData
 {
 	bool frameSubmitted = false, packetRetrieved = false;
 
+	// Depending on the wait strategy, attempts can be a lot shorter than the wait timer. Limit by time instead.
+	std::chrono::nanoseconds waitLimit = m_SubmitQueryWaitTimer * m_SubmitQueryAttempts;
+	std::chrono::nanoseconds waited    = std::chrono::nanoseconds(0);
+
 	bool keepLooping = true;
-	for (uint64_t attempt = 1; keepLooping; attempt++) {
+	for (uint64_t attempt = 0; keepLooping; attempt++) {
 		// Lets just change the stupid huge bitwise and/or into proper ifs.
 		// Since this is rather small and can be kept in L1 we should not see
 		// any differences in performance.
 		if (m_InitialFramesSent) {
 			if (m_InitialPacketRetrieved) {
-				if (attempt <= m_SubmitQueryAttempts) {
+				if (waited < waitLimit) {
 					keepLooping = (!frameSubmitted || !packetRetrieved);
 				} else {
 					keepLooping = false;
@@ -791,95 +1643,75 @@ bool Plugin::AMD::Encoder::EncodeMain(IN amf::AMFDataPtr& data, OUT amf::AMFData
 
 		// Submit
 		if (!frameSubmitted) {
-			if (m_MultiThreading) { // Asynchronous
-				std::unique_lock<std::mutex> slock(m_AsyncSend->mutex);
-				if (m_AsyncSend->data == nullptr) {
-					m_AsyncSend->data = data;
-					m_AsyncSend->condvar.notify_all();
-					frameSubmitted = true;
-				} else {
-					m_AsyncSend->condvar.notify_all();
-				}
-			} else {
-				// Performance Tracking
-				auto     clk   = std::chrono::high_resolution_clock::now();
-				uint64_t pf_ts = std::chrono::nanoseconds(clk.time_since_epoch()).count();
-				data->SetProperty(AMF_TIMESTAMP_SUBMIT, pf_ts);
-
-				AMF_RESULT res = m_AMFEncoder->SubmitInput(data);
-				if (m_Debug) {
-					QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> [Main/Submit] SubmitInput returned %ls (code %d).",
-										 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
-					PLOG_WARNING("%s", errMsg.c_str());
-				}
+			// Performance Tracking
+			int64_t pts = 0;
+			data->GetProperty(AMF_PRESENT_TIMESTAMP, &pts);
+			m_Telemetry->Set(pts, TelemetryField::SubmitTimestamp,
+							 std::chrono::nanoseconds(std::chrono::high_resolution_clock::now().time_since_epoch())
+								 .count());
+
+			AMF_RESULT res = m_AMFEncoder->SubmitInput(data);
+			if (m_Debug) {
+				QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> [Main/Submit] SubmitInput returned %ls (code %d).",
+									 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
+				PLOG_WARNING("%s", errMsg.c_str());
+			}
 
-				if (res == AMF_OK) {
-					frameSubmitted = true;
-					m_SubmittedFrameCount++;
-				} else if (res == AMF_INPUT_FULL) {
-					if (m_InitialFramesSent == false) {
-						QUICK_FORMAT_MESSAGE(
-							errMsg, "<Id: %llu> Queue Size is too large, starting to query for packets...", m_UniqueId);
-						PLOG_ERROR("%s", errMsg.data());
-						m_InitialFramesSent = true;
-					}
-				} else {
-					QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> [Main] Submitting Surface failed, error %ls (code %d)",
-										 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
+			if (res == AMF_OK) {
+				frameSubmitted = true;
+				m_SubmittedFrameCount++;
+			} else if (res == AMF_INPUT_FULL) {
+				if (m_InitialFramesSent == false) {
+					QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Queue Size is too large, starting to query for packets...",
+										 m_UniqueId);
 					PLOG_ERROR("%s", errMsg.data());
-					return false;
+					m_InitialFramesSent = true;
 				}
+			} else {
+				QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> [Main] Submitting Surface failed, error %ls (code %d)",
+									 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
+				PLOG_ERROR("%s", errMsg.data());
+				return false;
 			}
 		}
 
 		// Retrieve
 		if (m_InitialFramesSent && !packetRetrieved) {
-			if (m_MultiThreading) {
-				std::unique_lock<std::mutex> rlock(m_AsyncRetrieve->mutex);
-				if (m_AsyncRetrieve->data != nullptr) {
-					packet                   = m_AsyncRetrieve->data;
-					m_AsyncRetrieve->data    = nullptr;
-					packetRetrieved          = true;
-					m_InitialPacketRetrieved = true;
-				} else {
-					m_AsyncRetrieve->condvar.notify_all();
-					if (m_AsyncRetrieve->wakeupcount == 0)
-						m_AsyncRetrieve->wakeupcount = 1;
-				}
-			} else {
-				AMF_RESULT res = m_AMFEncoder->QueryOutput(&packet);
-				if (m_Debug) {
-					QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> [Main/Query] QueryOutput returned %ls (code %d).",
-										 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
-					PLOG_WARNING("%s", errMsg.c_str());
-				}
+			AMF_RESULT res = m_AMFEncoder->QueryOutput(&packet);
+			if (m_Debug) {
+				QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> [Main/Query] QueryOutput returned %ls (code %d).",
+									 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
+				PLOG_WARNING("%s", errMsg.c_str());
+			}
 
-				if (res == AMF_OK) {
-					m_InitialPacketRetrieved = true;
-					packetRetrieved          = true;
-
-					// Performance Tracking
-					auto     clk      = std::chrono::high_resolution_clock::now();
-					uint64_t pf_query = std::chrono::nanoseconds(clk.time_since_epoch()).count(), pf_submit, pf_main;
-					packet->GetProperty(AMF_TIMESTAMP_SUBMIT, &pf_submit);
-					packet->SetProperty(AMF_TIMESTAMP_QUERY, pf_query);
-					pf_main = (pf_query - pf_submit);
-					packet->SetProperty(AMF_TIME_MAIN, pf_main);
-				} else if (res == AMF_NEED_MORE_INPUT) {
-					// Returned with B-Frames, means that we need more frames.
-					if (!m_InitialPacketRetrieved)
-						packetRetrieved = true;
-				} else if (res != AMF_REPEAT) {
-					QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> [Main] Retrieving Packet failed, error %ls (code %d)",
-										 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
-					PLOG_ERROR("%s", errMsg.data());
-					return false;
-				}
+			if (res == AMF_OK) {
+				m_InitialPacketRetrieved = true;
+				packetRetrieved          = true;
+
+				// Performance Tracking
+				auto    clk = std::chrono::high_resolution_clock::now();
+				int64_t pts = 0;
+				packet->GetProperty(AMF_PRESENT_TIMESTAMP, &pts);
+				m_Telemetry->Set(pts, TelemetryField::QueryTimestamp,
+								 std::chrono::nanoseconds(clk.time_since_epoch()).count());
+			} else if (res == AMF_NEED_MORE_INPUT) {
+				// Returned with B-Frames, means that we need more frames.
+				if (!m_InitialPacketRetrieved)
+					packetRetrieved = true;
+			} else if (res != AMF_REPEAT) {
+				QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> [Main] Retrieving Packet failed, error %ls (code %d)",
+									 m_UniqueId, m_AMF->GetTrace()->GetResultText(res), res);
+				PLOG_ERROR("%s", errMsg.data());
+				return false;
 			}
 		}
 
-		if (!packetRetrieved || !frameSubmitted)
-			std::this_thread::sleep_for(m_SubmitQueryWaitTimer);
+		if (keepLooping && (!packetRetrieved || !frameSubmitted))
+			waited += m_WaitEvent.Poll(m_WaitStrategy, attempt, m_SubmitQueryWaitTimer);
+	}
+	m_FrameWaitTime += waited;
+	if (m_Debug) {
+		PLOG_DEBUG("<Id: %llu> EncodeMain: Waited %lld ns.", m_UniqueId, (long long)waited.count());
 	}
 	if (!frameSubmitted) {
 		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Input Queue is full, encoder is overloaded!", m_UniqueId);
@@ -898,6 +1730,69 @@ bool Plugin::AMD::Encoder::EncodeMain(IN amf::AMFDataPtr& data, OUT amf::AMFData
 	return true;
 }
 
+bool Plugin::AMD::Encoder::EncodeQueue(IN amf::AMFDataPtr& data, OUT amf::AMFDataPtr& packet)
+{
+	// Requests a dropped frame carried go to the next frame instead, or the stream would lose its keyframe.
+	for (std::pair<const wchar_t*, amf::AMFVariant>& kv : m_CarriedRequests)
+		data->SetProperty(kv.first, kv.second);
+	m_CarriedRequests.clear();
+
+	// A full queue is often only a hiccup of the send worker, so give it up to a frame to catch up.
+	auto deadline = std::chrono::high_resolution_clock::now()
+					+ std::chrono::nanoseconds((int64_t)(m_FrameRateFraction * 1000000000.0));
+	uint64_t attempt = 0;
+	bool     queued  = m_AsyncSend->queue.Push(data);
+	while (!queued && (std::chrono::high_resolution_clock::now() < deadline)) {
+		m_AsyncSend->event.Notify();
+		m_FrameWaitTime += m_WaitEvent.Wait(m_WaitStrategy, attempt++, m_SubmitQueryWaitTimer);
+		queued = m_AsyncSend->queue.Push(data);
+	}
+
+	if (queued) {
+		m_QueuedFrameCount++;
+	} else {
+		CarryRequests(data);
+		if (m_DroppedFrameCount++ == 0) {
+			QUICK_FORMAT_MESSAGE(errMsg,
+								 "<Id: %llu> Input Queue is full, encoder is overloaded! Dropping frames, the total is "
+								 "reported when stopping.",
+								 m_UniqueId);
+			PLOG_WARNING("%s", errMsg.data());
+		}
+	}
+	m_AsyncSend->event.Notify();
+
+	if (m_AsyncRetrieve->queue.Pop(packet)) {
+		m_InitialPacketRetrieved = true;
+		m_AsyncRetrieve->event.Notify();
+	} else if (!m_InitialPacketRetrieved) {
+		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Waiting for initial frame...", m_UniqueId);
+		PLOG_DEBUG("%s", errMsg.data());
+	}
+
+	return true;
+}
+
+void Plugin::AMD::Encoder::CarryRequests(IN amf::AMFDataPtr& data)
+{
+	static const wchar_t* pictureTypes[] = {AMF_VIDEO_ENCODER_FORCE_PICTURE_TYPE,
+											 AMF_VIDEO_ENCODER_HEVC_FORCE_PICTURE_TYPE};
+	static const wchar_t* headers[]      = {AMF_VIDEO_ENCODER_INSERT_SPS, AMF_VIDEO_ENCODER_INSERT_PPS,
+										AMF_VIDEO_ENCODER_HEVC_INSERT_HEADER};
+
+	// Both codecs number their picture types the same way up to IDR.
+	for (const wchar_t* name : pictureTypes) {
+		int64_t type = 0;
+		if ((data->GetProperty(name, &type) == AMF_OK) && (type == AMF_VIDEO_ENCODER_PICTURE_TYPE_IDR))
+			m_CarriedRequests.emplace_back(name, amf::AMFVariant(type));
+	}
+	for (const wchar_t* name : headers) {
+		bool insert = false;
+		if ((data->GetProperty(name, &insert) == AMF_OK) && insert)
+			m_CarriedRequests.emplace_back(name, amf::AMFVariant(insert));
+	}
+}
+
 bool Plugin::AMD::Encoder::EncodeLoad(IN amf::AMFDataPtr& data, OUT struct encoder_packet* packet,
 									  OUT bool* received_packet)
 {
@@ -916,30 +1811,42 @@ bool Plugin::AMD::Encoder::EncodeLoad(IN amf::AMFDataPtr& data, OUT struct encod
 	/// Data
 	PacketPriorityAndKeyframe(data, packet);
 	packet->size = pBuffer->GetSize();
-	if (m_PacketDataBuffer.size() < packet->size) {
-		size_t newBufferSize = (size_t)exp2(ceil(log2((double)packet->size)));
-		//AMF_LOG_DEBUG("Packet Buffer was resized to %d byte from %d byte.", newBufferSize, m_PacketDataBuffer.size());
-		m_PacketDataBuffer.resize(newBufferSize);
+	if (pBuffer->GetMemoryType() == amf::AMF_MEMORY_HOST) {
+		// Hand out the encoder's own memory and hold a reference until the packet slot is reused.
+		packet->data = static_cast<uint8_t*>(pBuffer->GetNative());
+		m_PacketRetention[m_PacketRetentionIndex] = pBuffer;
+		m_PacketRetentionIndex                    = (m_PacketRetentionIndex + 1) % m_PacketRetention.size();
+	} else {
+		if (m_PacketDataBuffer.size() < packet->size) {
+			size_t newBufferSize = (size_t)exp2(ceil(log2((double)packet->size)));
+			//AMF_LOG_DEBUG("Packet Buffer was resized to %d byte from %d byte.", newBufferSize, m_PacketDataBuffer.size());
+			m_PacketDataBuffer.resize(newBufferSize);
+		}
+		packet->data = m_PacketDataBuffer.data();
+		std::memcpy(packet->data, pBuffer->GetNative(), packet->size);
 	}
-	packet->data = m_PacketDataBuffer.data();
-	std::memcpy(packet->data, pBuffer->GetNative(), packet->size);
 
 	// Performance Tracking
-	auto     clk_end = std::chrono::high_resolution_clock::now();
-	uint64_t pf_allocate_ts, pf_allocate_t, pf_store_ts, pf_store_t, pf_convert_ts, pf_convert_t, pf_submit_ts,
-		pf_query_ts, pf_main_t, pf_load_ts, pf_load_t;
-
-	data->GetProperty(AMF_TIMESTAMP_ALLOCATE, &pf_allocate_ts);
-	data->GetProperty(AMF_TIME_ALLOCATE, &pf_allocate_t);
-	data->GetProperty(AMF_TIMESTAMP_STORE, &pf_store_ts);
-	data->GetProperty(AMF_TIME_STORE, &pf_store_t);
-	data->GetProperty(AMF_TIMESTAMP_CONVERT, &pf_convert_ts);
-	data->GetProperty(AMF_TIME_CONVERT, &pf_convert_t);
-	data->GetProperty(AMF_TIMESTAMP_SUBMIT, &pf_submit_ts);
-	data->GetProperty(AMF_TIMESTAMP_QUERY, &pf_query_ts);
-	data->GetProperty(AMF_TIME_MAIN, &pf_main_t);
-	pf_load_ts = std::chrono::nanoseconds(clk_end.time_since_epoch()).count();
-	pf_load_t  = std::chrono::nanoseconds(clk_end - clk_start).count();
+	auto     clk_end       = std::chrono::high_resolution_clock::now();
+	uint64_t pf_load_t     = std::chrono::nanoseconds(clk_end - clk_start).count();
+	uint64_t pf_allocate_t = 0, pf_store_t = 0, pf_convert_t = 0, pf_main_t = 0;
+	bool     tracked       = m_Telemetry->Contains(packet->pts);
+	if (tracked) {
+		uint64_t pf_submit_ts = m_Telemetry->Get(packet->pts, TelemetryField::SubmitTimestamp);
+		uint64_t pf_query_ts  = m_Telemetry->Get(packet->pts, TelemetryField::QueryTimestamp);
+
+		m_Telemetry->Set(packet->pts, TelemetryField::LoadTime, pf_load_t);
+		pf_allocate_t = m_Telemetry->Get(packet->pts, TelemetryField::AllocateTime);
+		pf_store_t    = m_Telemetry->Get(packet->pts, TelemetryField::StoreTime);
+		pf_convert_t  = m_Telemetry->Get(packet->pts, TelemetryField::ConvertTime);
+		pf_main_t     = (pf_query_ts > pf_submit_ts) ? (pf_query_ts - pf_submit_ts) : 0;
+
+		m_Statistics.Record(EncoderStage::Allocate, std::chrono::nanoseconds(pf_allocate_t));
+		m_Statistics.Record(EncoderStage::Store, std::chrono::nanoseconds(pf_store_t));
+		m_Statistics.Record(EncoderStage::Convert, std::chrono::nanoseconds(pf_convert_t));
+		m_Statistics.Record(EncoderStage::Main, std::chrono::nanoseconds(pf_main_t));
+		m_Statistics.Record(EncoderStage::Load, std::chrono::nanoseconds(pf_load_t));
+	}
 
 	if (m_Debug) {
 		std::string printableType = "Unknown";
@@ -985,7 +1892,7 @@ bool Plugin::AMD::Encoder::EncodeLoad(IN amf::AMFDataPtr& data, OUT struct encod
 				   " ns) Main(%8" PRIu64 " ns) Load(%8" PRIu64 " ns)",
 				   m_UniqueId, pf_allocate_t, pf_store_t, pf_convert_t, pf_main_t, pf_load_t);
 	}
-	if (m_InitialFrameLatency == 0) {
+	if (tracked && (m_InitialFrameLatency == 0)) {
 		m_InitialFrameLatency = pf_main_t;
 		PLOG_INFO("<Id: %" PRIu64 "> Initial Frame Latency is %" PRIu64 " nanoseconds.", m_UniqueId,
 				  m_InitialFrameLatency);
@@ -996,6 +1903,12 @@ bool Plugin::AMD::Encoder::EncodeLoad(IN amf::AMFDataPtr& data, OUT struct encod
 	return true;
 }
 
+void Plugin::AMD::Encoder::HoldPacket(IN struct encoder_packet* packet)
+{
+	m_HeldPackets.emplace_back(*packet, std::vector<uint8_t>(packet->data, packet->data + packet->size));
+	m_HeldPackets.back().first.data = m_HeldPackets.back().second.data();
+}
+
 int32_t Plugin::AMD::Encoder::AsyncSendMain(Encoder* obj)
 {
 	return obj->AsyncSendLocalMain();
@@ -1005,21 +1918,24 @@ int32_t Plugin::AMD::Encoder::AsyncSendLocalMain()
 {
 	EncoderThreadingData* own = m_AsyncSend;
 
-	std::unique_lock<std::mutex> lock(own->mutex);
-	while (!own->shutdown) {
-		own->condvar.wait(lock, [&own] { return own->shutdown || (own->data != nullptr); });
-
-		if (own->data == nullptr)
+	amf::AMFDataPtr data;
+	for (uint64_t attempt = 0; !own->shutdown; attempt++) {
+		if ((data == nullptr) && !own->queue.Pop(data)) {
+			// Wait for the OBS thread to queue a frame.
+			own->event.Wait(m_WaitStrategy, attempt, m_SubmitQueryWaitTimer);
 			continue;
+		}
 
+		// Performance Tracking
 		{
-			// Performance Tracking
-			auto     clk   = std::chrono::high_resolution_clock::now();
-			uint64_t pf_ts = std::chrono::nanoseconds(clk.time_since_epoch()).count();
-			own->data->SetProperty(AMF_TIMESTAMP_SUBMIT, pf_ts);
+			int64_t pts = 0;
+			data->GetProperty(AMF_PRESENT_TIMESTAMP, &pts);
+			m_Telemetry->Set(pts, TelemetryField::SubmitTimestamp,
+							 std::chrono::nanoseconds(std::chrono::high_resolution_clock::now().time_since_epoch())
+								 .count());
 		}
 
-		AMF_RESULT res = m_AMFEncoder->SubmitInput(own->data);
+		AMF_RESULT res = m_AMFEncoder->SubmitInput(data);
 		if (m_Debug) {
 			QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> [Main/Submit] SubmitInput returned %ls (code %d).", m_UniqueId,
 								 m_AMF->GetTrace()->GetResultText(res), res);
@@ -1027,8 +1943,14 @@ int32_t Plugin::AMD::Encoder::AsyncSendLocalMain()
 		}
 
 		if (res == AMF_OK) {
-			own->data = nullptr;
+			data = nullptr;
 			m_SubmittedFrameCount++;
+			attempt = 0;
+
+			// New input may produce output, and the OBS thread can queue the next frame.
+			m_AsyncRetrieve->event.Notify();
+			m_WaitEvent.Notify();
+			continue;
 		} else if (res == AMF_INPUT_FULL) {
 			if (m_InitialFramesSent == false) {
 				QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Queue Size is too large, starting to query for packets...",
@@ -1043,7 +1965,8 @@ int32_t Plugin::AMD::Encoder::AsyncSendLocalMain()
 			return -1;
 		}
 
-		std::this_thread::sleep_for(m_SubmitQueryWaitTimer);
+		// Wait for the retrieve worker to free up space in the encoder.
+		own->event.Wait(m_WaitStrategy, attempt, m_SubmitQueryWaitTimer);
 	}
 	return 0;
 }
@@ -1057,18 +1980,21 @@ int32_t Plugin::AMD::Encoder::AsyncRetrieveLocalMain()
 {
 	EncoderThreadingData* own = m_AsyncRetrieve;
 
-	std::unique_lock<std::mutex> lock(own->mutex);
-	while (!own->shutdown) {
-		own->condvar.wait(lock, [&own] { return own->shutdown || (own->wakeupcount > 0); });
-
-		if (own->wakeupcount == 0)
-			continue;
-
-		if (own->data != nullptr)
+	amf::AMFDataPtr packet;
+	for (uint64_t attempt = 0; !own->shutdown; attempt++) {
+		if (packet != nullptr) {
+			if (own->queue.Push(packet)) {
+				packet  = nullptr;
+				attempt = 0;
+				m_WaitEvent.Notify();
+			} else {
+				// Wait for the OBS thread to pick up a packet.
+				own->event.Wait(m_WaitStrategy, attempt, m_SubmitQueryWaitTimer);
+			}
 			continue;
+		}
 
-		amf::AMFDataPtr packet;
-		AMF_RESULT      res = m_AMFEncoder->QueryOutput(&packet);
+		AMF_RESULT res = m_AMFEncoder->QueryOutput(&packet);
 		if (m_Debug) {
 			QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> [Main/Query] QueryOutput returned %ls (code %d).", m_UniqueId,
 								 m_AMF->GetTrace()->GetResultText(res), res);
@@ -1076,34 +2002,33 @@ int32_t Plugin::AMD::Encoder::AsyncRetrieveLocalMain()
 		}
 
 		if (res == AMF_OK) {
-			own->data = packet;
-			own->wakeupcount--;
-
 			// Performance Tracking
 			{
-				auto     clk      = std::chrono::high_resolution_clock::now();
-				uint64_t pf_query = std::chrono::nanoseconds(clk.time_since_epoch()).count(), pf_submit, pf_main;
-				packet->GetProperty(AMF_TIMESTAMP_SUBMIT, &pf_submit);
-				packet->SetProperty(AMF_TIMESTAMP_QUERY, pf_query);
-				pf_main = (pf_query - pf_submit);
-				packet->SetProperty(AMF_TIME_MAIN, pf_main);
+				auto    clk = std::chrono::high_resolution_clock::now();
+				int64_t pts = 0;
+				packet->GetProperty(AMF_PRESENT_TIMESTAMP, &pts);
+				m_Telemetry->Set(pts, TelemetryField::QueryTimestamp,
+								 std::chrono::nanoseconds(clk.time_since_epoch()).count());
 			}
-		} else if (res == AMF_REPEAT) {
-			m_AsyncRetrieve->condvar.notify_all();
-		} else if (res == AMF_NEED_MORE_INPUT) {
-			{
-				std::unique_lock<std::mutex> slock(m_AsyncSend->mutex);
-				if (m_AsyncSend->data != nullptr)
-					m_AsyncSend->condvar.notify_all();
+
+			// The encoder has room for more input.
+			m_AsyncSend->event.Notify();
+			continue;
+		} else if (res == AMF_EOF) {
+			if (!own->eof) {
+				own->eof = true;
+				m_WaitEvent.Notify();
 			}
-		} else {
+		} else if ((res != AMF_REPEAT) && (res != AMF_NEED_MORE_INPUT)) {
 			QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Retrieving Packet failed, error %ls (code %d)", m_UniqueId,
 								 m_AMF->GetTrace()->GetResultText(res), res);
 			PLOG_ERROR("%s", errMsg.data());
 			return -1;
 		}
+		packet = nullptr;
 
-		std::this_thread::sleep_for(m_SubmitQueryWaitTimer);
+		// Wait for the send worker to submit more input.
+		own->event.Wait(m_WaitStrategy, attempt, m_SubmitQueryWaitTimer);
 	}
 	return 0;
 }
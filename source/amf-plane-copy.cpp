@@ -0,0 +1,283 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "amf-plane-copy.hpp"
+#include <cstring>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PLANE_COPY_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(_WIN32) || defined(_WIN64)
+extern "C" {
+#include <windows.h>
+}
+#else
+#include <unistd.h>
+#endif
+
+#if defined(PLANE_COPY_X86) && !defined(_MSC_VER)
+#define PLANE_COPY_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PLANE_COPY_TARGET(isa)
+#endif
+
+// Used if the cache size can't be queried.
+#define PLANE_COPY_DEFAULT_CACHE_SIZE (8ull * 1024ull * 1024ull)
+
+using namespace Plugin;
+using namespace Plugin::AMD;
+
+static void copy_rows_scalar(uint8_t* dst, size_t dstPitch, const uint8_t* src, size_t srcPitch, size_t rowSize,
+							 size_t rows)
+{
+	if ((dstPitch == rowSize) && (srcPitch == rowSize)) {
+		std::memcpy(dst, src, rowSize * rows);
+		return;
+	}
+	for (size_t y = 0; y < rows; y++)
+		std::memcpy(dst + y * dstPitch, src + y * srcPitch, rowSize);
+}
+
+#ifdef PLANE_COPY_X86
+PLANE_COPY_TARGET("sse2")
+static void copy_rows_stream_sse2(uint8_t* dst, size_t dstPitch, const uint8_t* src, size_t srcPitch,
+								  size_t rowSize, size_t rows)
+{
+	for (size_t y = 0; y < rows; y++) {
+		uint8_t*       d = dst + y * dstPitch;
+		const uint8_t* s = src + y * srcPitch;
+		size_t         n = rowSize;
+
+		// Streaming stores need an aligned destination.
+		size_t head = (16 - (reinterpret_cast<uintptr_t>(d) & 15)) & 15;
+		if (head > n)
+			head = n;
+		std::memcpy(d, s, head);
+		d += head, s += head, n -= head;
+
+		for (; n >= 64; n -= 64, d += 64, s += 64) {
+			__m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+			__m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+			__m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+			__m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+			_mm_stream_si128(reinterpret_cast<__m128i*>(d), v0);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), v1);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), v2);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), v3);
+		}
+		for (; n >= 16; n -= 16, d += 16, s += 16)
+			_mm_stream_si128(reinterpret_cast<__m128i*>(d), _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+		std::memcpy(d, s, n);
+	}
+
+	// Make the streaming stores visible before the surface is handed to another thread.
+	_mm_sfence();
+}
+
+PLANE_COPY_TARGET("avx2")
+static void copy_rows_stream_avx2(uint8_t* dst, size_t dstPitch, const uint8_t* src, size_t srcPitch,
+								  size_t rowSize, size_t rows)
+{
+	for (size_t y = 0; y < rows; y++) {
+		uint8_t*       d = dst + y * dstPitch;
+		const uint8_t* s = src + y * srcPitch;
+		size_t         n = rowSize;
+
+		size_t head = (32 - (reinterpret_cast<uintptr_t>(d) & 31)) & 31;
+		if (head > n)
+			head = n;
+		std::memcpy(d, s, head);
+		d += head, s += head, n -= head;
+
+		for (; n >= 128; n -= 128, d += 128, s += 128) {
+			__m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+			__m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 32));
+			__m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 64));
+			__m256i v3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 96));
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(d), v0);
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(d + 32), v1);
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(d + 64), v2);
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(d + 96), v3);
+		}
+		for (; n >= 32; n -= 32, d += 32, s += 32)
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(d),
+								_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)));
+		std::memcpy(d, s, n);
+	}
+
+	_mm_sfence();
+	_mm256_zeroupper();
+}
+
+static bool cpu_supports_avx2()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx     = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx || ((_xgetbv(0) & 0x6) != 0x6))
+		return false;
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif
+
+static size_t query_last_level_cache_size()
+{
+#if defined(_WIN32) || defined(_WIN64)
+	DWORD length = 0;
+	GetLogicalProcessorInformation(nullptr, &length);
+	if (length == 0)
+		return PLANE_COPY_DEFAULT_CACHE_SIZE;
+
+	std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+	if (!GetLogicalProcessorInformation(info.data(), &length))
+		return PLANE_COPY_DEFAULT_CACHE_SIZE;
+
+	BYTE   level = 0;
+	size_t size  = 0;
+	for (auto& entry : info) {
+		if ((entry.Relationship != RelationCache) || (entry.Cache.Level < level))
+			continue;
+		if (entry.Cache.Level > level)
+			size = 0;
+		level = entry.Cache.Level;
+		size  = (entry.Cache.Size > size) ? entry.Cache.Size : size;
+	}
+	return size ? size : PLANE_COPY_DEFAULT_CACHE_SIZE;
+#else
+	long size = -1;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+	size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+#ifdef _SC_LEVEL2_CACHE_SIZE
+	if (size <= 0)
+		size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+	return (size > 0) ? (size_t)size : PLANE_COPY_DEFAULT_CACHE_SIZE;
+#endif
+}
+
+void Plugin::AMD::PlaneCopy::Copy(uint8_t* dst, size_t dstPitch, const uint8_t* src, size_t srcPitch,
+								  size_t rowSize, size_t rows, bool streaming)
+{
+	Copy(GetKernel(), dst, dstPitch, src, srcPitch, rowSize, rows, streaming);
+}
+
+void Plugin::AMD::PlaneCopy::Copy(PlaneCopyKernel kernel, uint8_t* dst, size_t dstPitch, const uint8_t* src,
+								  size_t srcPitch, size_t rowSize, size_t rows, bool streaming)
+{
+	if ((rowSize == 0) || (rows == 0))
+		return;
+
+#ifdef PLANE_COPY_X86
+	if (streaming) {
+		if ((kernel == PlaneCopyKernel::AVX2) && IsKernelSupported(PlaneCopyKernel::AVX2)) {
+			copy_rows_stream_avx2(dst, dstPitch, src, srcPitch, rowSize, rows);
+			return;
+		} else if ((kernel != PlaneCopyKernel::Scalar) && IsKernelSupported(PlaneCopyKernel::SSE2)) {
+			copy_rows_stream_sse2(dst, dstPitch, src, srcPitch, rowSize, rows);
+			return;
+		}
+	}
+#else
+	kernel;
+	streaming;
+#endif
+
+	// Regular stores through the cache are what memcpy already does best.
+	copy_rows_scalar(dst, dstPitch, src, srcPitch, rowSize, rows);
+}
+
+bool Plugin::AMD::PlaneCopy::IsStreamingWorthwhile(size_t frameSize)
+{
+	return (GetKernel() != PlaneCopyKernel::Scalar) && (frameSize > GetLastLevelCacheSize());
+}
+
+size_t Plugin::AMD::PlaneCopy::GetLastLevelCacheSize()
+{
+	static const size_t size = query_last_level_cache_size();
+	return size;
+}
+
+Plugin::AMD::PlaneCopyKernel Plugin::AMD::PlaneCopy::GetKernel()
+{
+	if (IsKernelSupported(PlaneCopyKernel::AVX2))
+		return PlaneCopyKernel::AVX2;
+	if (IsKernelSupported(PlaneCopyKernel::SSE2))
+		return PlaneCopyKernel::SSE2;
+	return PlaneCopyKernel::Scalar;
+}
+
+bool Plugin::AMD::PlaneCopy::IsKernelSupported(PlaneCopyKernel kernel)
+{
+	switch (kernel) {
+	case PlaneCopyKernel::Scalar:
+		return true;
+#ifdef PLANE_COPY_X86
+	case PlaneCopyKernel::SSE2:
+#if defined(_M_X64) || defined(__x86_64__)
+		return true;
+#elif defined(_WIN32)
+	{
+		static const bool sse2 = IsProcessorFeaturePresent(PF_XMMI64_INSTRUCTIONS_AVAILABLE) != 0;
+		return sse2;
+	}
+#else
+	{
+		static const bool sse2 = __builtin_cpu_supports("sse2") != 0;
+		return sse2;
+	}
+#endif
+	case PlaneCopyKernel::AVX2: {
+		static const bool avx2 = cpu_supports_avx2();
+		return avx2;
+	}
+#endif
+	default:
+		return false;
+	}
+}
+
+const char* Plugin::AMD::PlaneCopy::GetKernelName(PlaneCopyKernel kernel)
+{
+	switch (kernel) {
+	case PlaneCopyKernel::Scalar:
+		return "Scalar";
+	case PlaneCopyKernel::SSE2:
+		return "SSE2";
+	case PlaneCopyKernel::AVX2:
+		return "AVX2";
+	}
+	return "Unknown";
+}
@@ -0,0 +1,148 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "amf-property-transaction.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+#include <components/VideoEncoderHEVC.h>
+#include <components/VideoEncoderVCE.h>
+
+using namespace Plugin;
+using namespace Plugin::AMD;
+
+// Properties that reset or constrain others, in the order they have to be sent.
+static const wchar_t* __dependencies[] = {
+	AMF_VIDEO_ENCODER_USAGE,
+	AMF_VIDEO_ENCODER_HEVC_USAGE,
+	AMF_VIDEO_ENCODER_QUALITY_PRESET,
+	AMF_VIDEO_ENCODER_HEVC_QUALITY_PRESET,
+	AMF_VIDEO_ENCODER_PROFILE,
+	AMF_VIDEO_ENCODER_HEVC_PROFILE,
+	AMF_VIDEO_ENCODER_PROFILE_LEVEL,
+	AMF_VIDEO_ENCODER_HEVC_PROFILE_LEVEL,
+	AMF_VIDEO_ENCODER_RATE_CONTROL_METHOD,
+	AMF_VIDEO_ENCODER_HEVC_RATE_CONTROL_METHOD,
+};
+
+static const size_t __dependency_count = sizeof(__dependencies) / sizeof(__dependencies[0]);
+
+static size_t dependency_rank(const wchar_t* name)
+{
+	for (size_t idx = 0; idx < __dependency_count; idx++) {
+		if (wcscmp(name, __dependencies[idx]) == 0)
+			return idx;
+	}
+	return __dependency_count;
+}
+
+static bool same_property(const wchar_t* a, const wchar_t* b)
+{
+	return (a == b) || (wcscmp(a, b) == 0);
+}
+
+Plugin::AMD::PropertyTransaction::PropertyTransaction(Encoder* encoder)
+{
+	if (encoder->m_Transaction != nullptr)
+		throw std::logic_error("Encoder already has an open property transaction.");
+
+	m_Encoder                = encoder;
+	m_Encoder->m_Transaction = this;
+}
+
+Plugin::AMD::PropertyTransaction::~PropertyTransaction()
+{
+	Detach();
+}
+
+size_t Plugin::AMD::PropertyTransaction::Commit()
+{
+	// Detach first, so that everything from here on goes straight to the encoder.
+	Detach();
+
+	std::stable_sort(m_Values.begin(), m_Values.end(),
+					 [](const std::pair<const wchar_t*, amf::AMFVariant>& a,
+						const std::pair<const wchar_t*, amf::AMFVariant>& b) {
+						 return dependency_rank(a.first) < dependency_rank(b.first);
+					 });
+
+	size_t                                             sent = 0;
+	std::vector<std::pair<const wchar_t*, AMF_RESULT>> failed;
+	for (std::pair<const wchar_t*, amf::AMFVariant>& kv : m_Values) {
+		if (m_Encoder->IsEncoderPropertyApplied(kv.first, kv.second))
+			continue;
+
+		// Keep going on failure, the remaining properties do not depend on this one.
+		AMF_RESULT res = m_Encoder->ApplyEncoderProperty(kv.first, kv.second);
+		if (res != AMF_OK) {
+			PLOG_WARNING("<Id: %llu> Unable to set property '%ls', error %ls (code %d)", m_Encoder->m_UniqueId,
+						 kv.first, m_Encoder->m_AMF->GetTrace()->GetResultText(res), res);
+			failed.emplace_back(kv.first, res);
+			continue;
+		}
+		sent++;
+
+		// Dependencies may have changed what the runtime uses for the properties compared after them.
+		if (dependency_rank(kv.first) < __dependency_count)
+			m_Encoder->ReadBackEncoderProperties();
+	}
+	PLOG_DEBUG("<Id: %llu> Sent %llu of %llu properties.", m_Encoder->m_UniqueId, (uint64_t)sent,
+			   (uint64_t)m_Values.size());
+	m_Values.clear();
+
+	// Properties may adjust each other, so everything known is read back once all are sent.
+	if (sent > 0)
+		m_Encoder->ReadBackEncoderProperties();
+
+	if (failed.size() > 0) {
+		QUICK_FORMAT_MESSAGE(errMsg, "<Id: %llu> Unable to set %llu properties, '%ls' failed with error %ls (code %d)",
+							 m_Encoder->m_UniqueId, (uint64_t)failed.size(), failed[0].first,
+							 m_Encoder->m_AMF->GetTrace()->GetResultText(failed[0].second), failed[0].second);
+		throw std::runtime_error(errMsg.c_str());
+	}
+	return sent;
+}
+
+void Plugin::AMD::PropertyTransaction::Detach()
+{
+	if (m_Encoder->m_Transaction == this)
+		m_Encoder->m_Transaction = nullptr;
+}
+
+void Plugin::AMD::PropertyTransaction::Record(const wchar_t* name, const amf::AMFVariant& value)
+{
+	for (std::pair<const wchar_t*, amf::AMFVariant>& kv : m_Values) {
+		if (same_property(kv.first, name)) {
+			kv.second = value;
+			return;
+		}
+	}
+	m_Values.emplace_back(name, value);
+}
+
+bool Plugin::AMD::PropertyTransaction::Find(const wchar_t* name, amf::AMFVariant* value)
+{
+	for (std::pair<const wchar_t*, amf::AMFVariant>& kv : m_Values) {
+		if (same_property(kv.first, name)) {
+			*value = kv.second;
+			return true;
+		}
+	}
+	return false;
+}
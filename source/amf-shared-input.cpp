@@ -0,0 +1,240 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "amf-shared-input.hpp"
+
+// Published frames kept around for subscribers that have not taken them yet.
+#define SHARED_INPUT_HISTORY 8
+// Longest wait for another subscriber to finish converting a frame, in milliseconds.
+#define SHARED_INPUT_TIMEOUT 100
+
+using namespace Plugin;
+using namespace Plugin::AMD;
+
+// Keeps the shared surface alive until the surface handed to a subscriber is released.
+class SharedSurfaceReference final : public amf::AMFSurfaceObserver {
+	public:
+	SharedSurfaceReference(amf::AMFSurfacePtr surface, std::shared_ptr<void> owner) : m_Owner(owner), m_Surface(surface)
+	{}
+
+	protected:
+	virtual void AMF_STD_CALL OnSurfaceDataRelease(amf::AMFSurface*) override
+	{
+		delete this;
+	}
+
+	private:
+	std::shared_ptr<void> m_Owner; // Released last, the surface may still need it to return its memory.
+	amf::AMFSurfacePtr    m_Surface;
+};
+
+static std::map<std::pair<SharedContext*, SharedInputFormat>, std::weak_ptr<SharedInput>> __registry;
+static std::mutex                                                                         __registry_mutex;
+
+bool Plugin::AMD::SharedInputFormat::operator<(const SharedInputFormat& other) const
+{
+	return std::tie(source, format, colorSpace, fullRange, width, height)
+		   < std::tie(other.source, other.format, other.colorSpace, other.fullRange, other.width, other.height);
+}
+
+std::shared_ptr<SharedInput> Plugin::AMD::SharedInput::Acquire(std::shared_ptr<SharedContext> context,
+															   const SharedInputFormat&       format)
+{
+	const std::lock_guard<std::mutex> lock(__registry_mutex);
+
+	// Forget inputs that nobody uses anymore, their context may be gone and its address reused.
+	for (auto entry = __registry.begin(); entry != __registry.end();) {
+		if (entry->second.expired()) {
+			entry = __registry.erase(entry);
+		} else {
+			entry++;
+		}
+	}
+
+	std::weak_ptr<SharedInput>&  entry = __registry[std::make_pair(context.get(), format)];
+	std::shared_ptr<SharedInput> input = entry.lock();
+	if (!input) {
+		input = std::make_shared<SharedInput>(context, format);
+		entry = input;
+	}
+	return input;
+}
+
+Plugin::AMD::SharedInput::SharedInput(std::shared_ptr<SharedContext> context, const SharedInputFormat& format)
+{
+	m_Context     = context;
+	m_Format      = format;
+	m_Subscribers = 0;
+}
+
+Plugin::AMD::SharedInput::~SharedInput()
+{
+	m_Frames.clear();
+	m_Context = nullptr;
+}
+
+void Plugin::AMD::SharedInput::Subscribe()
+{
+	const std::lock_guard<std::mutex> lock(m_Lock);
+	m_Subscribers++;
+}
+
+void Plugin::AMD::SharedInput::Unsubscribe()
+{
+	const std::lock_guard<std::mutex> lock(m_Lock);
+	m_Subscribers--;
+
+	// Nobody left to take published frames.
+	if (m_Subscribers <= 1) {
+		for (auto entry = m_Frames.begin(); entry != m_Frames.end();) {
+			if (entry->second.data) {
+				entry = m_Frames.erase(entry);
+			} else {
+				entry++;
+			}
+		}
+	}
+}
+
+size_t Plugin::AMD::SharedInput::GetSubscriberCount()
+{
+	const std::lock_guard<std::mutex> lock(m_Lock);
+	return m_Subscribers;
+}
+
+bool Plugin::AMD::SharedInput::Claim(uint64_t frame, amf::AMFDataPtr& data)
+{
+	std::unique_lock<std::mutex> lock(m_Lock);
+
+	// Another subscriber is converting the frame right now, which is faster than doing it again.
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(SHARED_INPUT_TIMEOUT);
+	auto entry    = m_Frames.find(frame);
+	while ((entry != m_Frames.end()) && !entry->second.data) {
+		if (m_Published.wait_until(lock, deadline) == std::cv_status::timeout)
+			return false;
+		entry = m_Frames.find(frame);
+	}
+
+	if (entry == m_Frames.end()) {
+		Frame& claimed    = m_Frames[frame];
+		claimed.data      = nullptr;
+		claimed.remaining = 0;
+
+		// Drop the oldest published frames, whoever did not take them by now skipped them.
+		for (auto old = m_Frames.begin(); (m_Frames.size() > SHARED_INPUT_HISTORY) && (old != m_Frames.end());) {
+			if (old->second.data) {
+				old = m_Frames.erase(old);
+			} else {
+				old++;
+			}
+		}
+		return false;
+	}
+
+	AMF_RESULT res = Reference(entry->second.data, entry->second.owner, data);
+	if (--entry->second.remaining == 0)
+		m_Frames.erase(entry);
+	if (res != AMF_OK) {
+		PLOG_WARNING("[SharedInput] Unable to reference shared frame %llu, error %ls (code %d)",
+					 (unsigned long long)frame, AMF::Instance()->GetTrace()->GetResultText(res), res);
+		data = nullptr;
+		return false;
+	}
+	return true;
+}
+
+void Plugin::AMD::SharedInput::Publish(uint64_t frame, amf::AMFDataPtr& data, std::shared_ptr<void> owner)
+{
+	const std::lock_guard<std::mutex> lock(m_Lock);
+
+	auto entry = m_Frames.find(frame);
+	if ((entry == m_Frames.end()) || entry->second.data)
+		return;
+
+	if (m_Subscribers > 1) {
+		entry->second.data      = data;
+		entry->second.owner     = owner;
+		entry->second.remaining = m_Subscribers - 1;
+	} else {
+		m_Frames.erase(entry);
+	}
+	m_Published.notify_all();
+}
+
+void Plugin::AMD::SharedInput::Abandon(uint64_t frame)
+{
+	const std::lock_guard<std::mutex> lock(m_Lock);
+
+	auto entry = m_Frames.find(frame);
+	if ((entry == m_Frames.end()) || entry->second.data)
+		return;
+
+	// Whoever waits for the frame converts it on their own now.
+	m_Frames.erase(entry);
+	m_Published.notify_all();
+}
+
+AMF_RESULT Plugin::AMD::SharedInput::Reference(amf::AMFDataPtr& data, std::shared_ptr<void> owner,
+												amf::AMFDataPtr& reference)
+{
+	amf::AMFSurfacePtr surface(data);
+	if (!surface)
+		return AMF_INVALID_DATA_TYPE;
+
+	amf::AMFContextPtr      context  = m_Context->GetContext();
+	amf::AMFSurfacePtr      view     = nullptr;
+	SharedSurfaceReference* observer = new SharedSurfaceReference(surface, owner);
+	AMF_RESULT              res      = AMF_NOT_SUPPORTED;
+	switch (surface->GetMemoryType()) {
+	case amf::AMF_MEMORY_DX11:
+		res = context->CreateSurfaceFromDX11Native(surface->GetPlaneAt(0)->GetNative(), &view, observer);
+		break;
+	case amf::AMF_MEMORY_DX9:
+		res = context->CreateSurfaceFromDX9Native(surface->GetPlaneAt(0)->GetNative(), &view, observer);
+		break;
+	case amf::AMF_MEMORY_HOST:
+		// Only possible if the chroma plane directly follows the luma plane, like in regular host allocations.
+		if (surface->GetFormat() == amf::AMF_SURFACE_NV12) {
+			amf::AMFPlanePtr luma   = surface->GetPlaneAt(0);
+			amf::AMFPlanePtr chroma = surface->GetPlaneAt(1);
+			uint8_t*         base   = static_cast<uint8_t*>(luma->GetNative());
+			if (static_cast<uint8_t*>(chroma->GetNative()) == base + (size_t)luma->GetHPitch() * luma->GetVPitch()) {
+				res = context->CreateSurfaceFromHostNative(amf::AMF_SURFACE_NV12, luma->GetWidth(), luma->GetHeight(),
+														   luma->GetHPitch(), luma->GetVPitch(), base, &view,
+														   observer);
+			}
+		}
+		break;
+	default:
+		break;
+	}
+	if (res != AMF_OK) {
+		delete observer;
+
+		// Copy what can't be wrapped, which is still cheaper than uploading and converting it again. The copy
+		// must not carry over the properties of the subscriber that converted the frame.
+		res = data->Duplicate(data->GetMemoryType(), &reference);
+		if (res == AMF_OK)
+			reference->Clear();
+		return res;
+	}
+
+	reference = amf::AMFDataPtr(view);
+	return AMF_OK;
+}
@@ -0,0 +1,171 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "amf-statistics.hpp"
+#include <cmath>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Default interval between two summary log lines.
+#define STATISTICS_SUMMARY_INTERVAL 60
+
+using namespace Plugin;
+using namespace Plugin::AMD;
+
+static inline size_t highest_bit(uint64_t v)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanReverse64(&index, v);
+	return index;
+#else
+	return 63 - __builtin_clzll(v);
+#endif
+}
+
+Plugin::AMD::LatencyHistogram::LatencyHistogram()
+{
+	Reset();
+}
+
+void Plugin::AMD::LatencyHistogram::Record(uint64_t value)
+{
+	m_Buckets[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+	m_Count.fetch_add(1, std::memory_order_relaxed);
+
+	uint64_t max = m_Max.load(std::memory_order_relaxed);
+	while ((value > max) && !m_Max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+	}
+}
+
+void Plugin::AMD::LatencyHistogram::Reset()
+{
+	for (std::atomic<uint64_t>& bucket : m_Buckets)
+		bucket.store(0, std::memory_order_relaxed);
+	m_Count.store(0, std::memory_order_relaxed);
+	m_Max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t Plugin::AMD::LatencyHistogram::GetCount()
+{
+	return m_Count.load(std::memory_order_relaxed);
+}
+
+uint64_t Plugin::AMD::LatencyHistogram::GetMax()
+{
+	return m_Max.load(std::memory_order_relaxed);
+}
+
+uint64_t Plugin::AMD::LatencyHistogram::GetPercentile(double_t percentile)
+{
+	uint64_t count = GetCount();
+	if (count == 0)
+		return 0;
+
+	uint64_t rank = (uint64_t)ceil(count * percentile / 100.0);
+	if (rank == 0)
+		rank = 1;
+
+	uint64_t seen = 0;
+	for (size_t idx = 0; idx < BucketCount; idx++) {
+		seen += m_Buckets[idx].load(std::memory_order_relaxed);
+		if (seen >= rank) {
+			// The bucket bound may overshoot the largest recorded value.
+			uint64_t bound = BucketUpperBound(idx), max = GetMax();
+			return (bound < max) ? bound : max;
+		}
+	}
+	return GetMax();
+}
+
+Plugin::AMD::LatencySummary Plugin::AMD::LatencyHistogram::GetSummary()
+{
+	LatencySummary summary;
+	summary.count = GetCount();
+	summary.p50   = GetPercentile(50.0);
+	summary.p90   = GetPercentile(90.0);
+	summary.p99   = GetPercentile(99.0);
+	summary.max   = GetMax();
+	return summary;
+}
+
+size_t Plugin::AMD::LatencyHistogram::BucketIndex(uint64_t value)
+{
+	// Small values map directly, everything else by highest bit and the next SubBucketBits bits below it.
+	if (value < SubBucketCount)
+		return (size_t)value;
+
+	size_t msb   = highest_bit(value);
+	size_t shift = msb - SubBucketBits;
+	size_t sub   = (size_t)(value >> shift) & (SubBucketCount - 1);
+	return (shift + 1) * SubBucketCount + sub;
+}
+
+uint64_t Plugin::AMD::LatencyHistogram::BucketUpperBound(size_t index)
+{
+	if (index < SubBucketCount)
+		return index;
+
+	size_t   shift = (index / SubBucketCount) - 1;
+	uint64_t lower = (uint64_t)(SubBucketCount + (index % SubBucketCount)) << shift;
+	return lower + ((1ull << shift) - 1);
+}
+
+Plugin::AMD::EncoderStatistics::EncoderStatistics()
+{
+	m_SummaryInterval = std::chrono::seconds(STATISTICS_SUMMARY_INTERVAL);
+	Reset();
+}
+
+void Plugin::AMD::EncoderStatistics::Record(EncoderStage stage, std::chrono::nanoseconds time)
+{
+	m_Stages[(size_t)stage].Record(time.count() > 0 ? (uint64_t)time.count() : 0);
+}
+
+void Plugin::AMD::EncoderStatistics::Reset()
+{
+	for (LatencyHistogram& histogram : m_Stages)
+		histogram.Reset();
+	m_NextSummary = (std::chrono::high_resolution_clock::now() + m_SummaryInterval).time_since_epoch().count();
+}
+
+Plugin::AMD::LatencySummary Plugin::AMD::EncoderStatistics::GetSummary(EncoderStage stage)
+{
+	return m_Stages[(size_t)stage].GetSummary();
+}
+
+bool Plugin::AMD::EncoderStatistics::IsSummaryDue()
+{
+	int64_t now  = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+	int64_t next = m_NextSummary.load(std::memory_order_relaxed);
+	if (now < next)
+		return false;
+
+	int64_t interval =
+		std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(m_SummaryInterval).count();
+	return m_NextSummary.compare_exchange_strong(next, now + interval, std::memory_order_relaxed);
+}
+
+void Plugin::AMD::EncoderStatistics::SetSummaryInterval(std::chrono::seconds interval)
+{
+	m_SummaryInterval = interval;
+	m_NextSummary     = (std::chrono::high_resolution_clock::now() + m_SummaryInterval).time_since_epoch().count();
+}
@@ -0,0 +1,210 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "amf-surface-pool.hpp"
+#include <stdexcept>
+
+// Row pitch alignment of pooled surfaces, matches what the runtime uses for its own host allocations.
+#define POOL_PITCH_ALIGNMENT 256
+// Alignment of the start of each slot.
+#define POOL_DATA_ALIGNMENT 4096
+
+using namespace Plugin;
+using namespace Plugin::AMD;
+
+template<typename T>
+static inline T align_up(T v, T alignment)
+{
+	return (v + (alignment - 1)) & ~(alignment - 1);
+}
+
+Plugin::AMD::SurfacePool::SurfacePool(amf::AMFContext* context, amf::AMF_SURFACE_FORMAT format, uint32_t width,
+									  uint32_t height, size_t capacity)
+{
+	if (context == nullptr)
+		throw std::invalid_argument("context");
+	if ((width == 0) || (height == 0))
+		throw std::invalid_argument("width, height");
+	if (capacity == 0)
+		throw std::invalid_argument("capacity");
+
+	m_Context = context;
+	m_Format  = format;
+	m_Width   = width;
+	m_Height  = height;
+
+	CalculateLayout(m_Format, m_Width, m_Height, m_HPitch, m_VPitch, m_SlotSize);
+
+	m_Storage            = std::make_shared<Storage>();
+	m_Storage->hits      = 0;
+	m_Storage->misses    = 0;
+	m_Storage->highwater = 0;
+	m_Storage->slots.resize(capacity);
+	m_Storage->free.reserve(capacity);
+	for (Slot& slot : m_Storage->slots) {
+		slot.storage = m_Storage.get();
+		slot.memory.resize(m_SlotSize + POOL_DATA_ALIGNMENT);
+		slot.data = reinterpret_cast<uint8_t*>(
+			align_up<uintptr_t>(reinterpret_cast<uintptr_t>(slot.memory.data()), POOL_DATA_ALIGNMENT));
+		m_Storage->free.push_back(&slot);
+	}
+}
+
+Plugin::AMD::SurfacePool::~SurfacePool()
+{
+	std::unique_lock<std::mutex> lock(m_Storage->lock);
+
+	// Slots still in use keep the storage alive, it goes away with the last surface.
+	size_t outstanding = m_Storage->slots.size() - m_Storage->free.size();
+	if (outstanding > 0) {
+		PLOG_DEBUG("[SurfacePool] %llu surfaces are still in use on destruction.", (unsigned long long)outstanding);
+	}
+}
+
+AMF_RESULT Plugin::AMD::SurfacePool::Acquire(amf::AMFSurface** surface)
+{
+	if (surface == nullptr)
+		return AMF_INVALID_POINTER;
+
+	Slot* slot = nullptr;
+	{
+		std::unique_lock<std::mutex> lock(m_Storage->lock);
+		if (!m_Storage->free.empty()) {
+			slot = m_Storage->free.back();
+			m_Storage->free.pop_back();
+		} else {
+			m_Storage->misses++;
+		}
+	}
+	if (slot == nullptr)
+		return m_Context->AllocSurface(amf::AMF_MEMORY_HOST, m_Format, m_Width, m_Height, surface);
+
+	// The slot can't be released before the caller lets go of the surface, so no lock is needed while creating it.
+	AMF_RESULT res = m_Context->CreateSurfaceFromHostNative(m_Format, m_Width, m_Height, m_HPitch, m_VPitch,
+															slot->data, surface, slot);
+
+	std::unique_lock<std::mutex> lock(m_Storage->lock);
+	if (res != AMF_OK) {
+		m_Storage->free.push_back(slot);
+		m_Storage->misses++;
+		lock.unlock();
+		return m_Context->AllocSurface(amf::AMF_MEMORY_HOST, m_Format, m_Width, m_Height, surface);
+	}
+	slot->owner = m_Storage;
+
+	m_Storage->hits++;
+	m_Storage->highwater = max(m_Storage->highwater, m_Storage->slots.size() - m_Storage->free.size());
+	return AMF_OK;
+}
+
+Plugin::AMD::SurfacePoolStatistics Plugin::AMD::SurfacePool::GetStatistics()
+{
+	std::unique_lock<std::mutex> lock(m_Storage->lock);
+
+	SurfacePoolStatistics stats;
+	stats.hits        = m_Storage->hits;
+	stats.misses      = m_Storage->misses;
+	stats.capacity    = m_Storage->slots.size();
+	stats.outstanding = m_Storage->slots.size() - m_Storage->free.size();
+	stats.highwater   = m_Storage->highwater;
+	return stats;
+}
+
+amf::AMF_SURFACE_FORMAT Plugin::AMD::SurfacePool::GetFormat()
+{
+	return m_Format;
+}
+
+std::pair<uint32_t, uint32_t> Plugin::AMD::SurfacePool::GetResolution()
+{
+	return std::make_pair(m_Width, m_Height);
+}
+
+size_t Plugin::AMD::SurfacePool::GetCapacity()
+{
+	return m_Storage->slots.size();
+}
+
+void Plugin::AMD::SurfacePool::CalculateLayout(amf::AMF_SURFACE_FORMAT format, uint32_t width, uint32_t height,
+											   int32_t& hPitch, int32_t& vPitch, size_t& size)
+{
+	// Chroma planes of 4:2:0 formats are subsampled, so keep the luma plane at an even height.
+	vPitch = static_cast<int32_t>(align_up<uint32_t>(height, 2));
+
+	switch (format) {
+	case amf::AMF_SURFACE_NV12:
+		// Y plane followed by interleaved UV plane with the same pitch.
+		hPitch = static_cast<int32_t>(align_up<uint32_t>(width, POOL_PITCH_ALIGNMENT));
+		size   = static_cast<size_t>(hPitch) * vPitch + static_cast<size_t>(hPitch) * (vPitch / 2);
+		break;
+	case amf::AMF_SURFACE_YUV420P:
+	case amf::AMF_SURFACE_YV12:
+		// Y plane followed by two chroma planes at half pitch.
+		hPitch = static_cast<int32_t>(align_up<uint32_t>(width, POOL_PITCH_ALIGNMENT * 2));
+		size   = static_cast<size_t>(hPitch) * vPitch + static_cast<size_t>(hPitch / 2) * (vPitch / 2) * 2;
+		break;
+	case amf::AMF_SURFACE_YUY2:
+		hPitch = static_cast<int32_t>(align_up<uint32_t>(width * 2, POOL_PITCH_ALIGNMENT));
+		size   = static_cast<size_t>(hPitch) * vPitch;
+		break;
+	case amf::AMF_SURFACE_BGRA:
+	case amf::AMF_SURFACE_RGBA:
+	case amf::AMF_SURFACE_ARGB:
+		hPitch = static_cast<int32_t>(align_up<uint32_t>(width * 4, POOL_PITCH_ALIGNMENT));
+		size   = static_cast<size_t>(hPitch) * vPitch;
+		break;
+	case amf::AMF_SURFACE_GRAY8:
+		hPitch = static_cast<int32_t>(align_up<uint32_t>(width, POOL_PITCH_ALIGNMENT));
+		size   = static_cast<size_t>(hPitch) * vPitch;
+		break;
+	default:
+		throw std::invalid_argument("format");
+	}
+}
+
+void AMF_STD_CALL Plugin::AMD::SurfacePool::Slot::OnSurfaceDataRelease(amf::AMFSurface*)
+{
+	// May be the last reference to the storage, which also owns this slot.
+	std::shared_ptr<Storage> keep;
+	{
+		std::unique_lock<std::mutex> lock(storage->lock);
+		keep = std::move(owner);
+		storage->free.push_back(this);
+	}
+}
+
+Plugin::AMD::HostFrameObserver::HostFrameObserver()
+{
+	m_Released = true;
+}
+
+void Plugin::AMD::HostFrameObserver::Reset()
+{
+	m_Released = false;
+}
+
+bool Plugin::AMD::HostFrameObserver::IsReleased()
+{
+	return m_Released;
+}
+
+void AMF_STD_CALL Plugin::AMD::HostFrameObserver::OnSurfaceDataRelease(amf::AMFSurface*)
+{
+	m_Released = true;
+}
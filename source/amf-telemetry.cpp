@@ -0,0 +1,83 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "amf-telemetry.hpp"
+#include <stdexcept>
+
+// Marks a row that no frame has claimed yet.
+#define TELEMETRY_EMPTY_ROW INT64_MIN
+
+using namespace Plugin;
+using namespace Plugin::AMD;
+
+Plugin::AMD::FrameTelemetry::FrameTelemetry(size_t capacity)
+{
+	if (capacity == 0)
+		throw std::invalid_argument("capacity");
+
+	size_t size = 1;
+	while (size < capacity)
+		size <<= 1;
+	m_Mask = size - 1;
+
+	m_Pts = std::unique_ptr<std::atomic<int64_t>[]>(new std::atomic<int64_t>[size]);
+	for (size_t idx = 0; idx < size; idx++)
+		m_Pts[idx] = TELEMETRY_EMPTY_ROW;
+	for (std::vector<uint64_t>& column : m_Columns)
+		column.resize(size, 0);
+}
+
+void Plugin::AMD::FrameTelemetry::Begin(int64_t pts)
+{
+	size_t row = Row(pts);
+	for (std::vector<uint64_t>& column : m_Columns)
+		column[row] = 0;
+	m_Pts[row].store(pts, std::memory_order_release);
+}
+
+bool Plugin::AMD::FrameTelemetry::Contains(int64_t pts)
+{
+	return m_Pts[Row(pts)].load(std::memory_order_acquire) == pts;
+}
+
+void Plugin::AMD::FrameTelemetry::Set(int64_t pts, TelemetryField field, uint64_t value)
+{
+	size_t row = Row(pts);
+	if (m_Pts[row].load(std::memory_order_acquire) != pts)
+		return;
+	m_Columns[(size_t)field][row] = value;
+}
+
+uint64_t Plugin::AMD::FrameTelemetry::Get(int64_t pts, TelemetryField field)
+{
+	size_t row = Row(pts);
+	if (m_Pts[row].load(std::memory_order_acquire) != pts)
+		return 0;
+	return m_Columns[(size_t)field][row];
+}
+
+size_t Plugin::AMD::FrameTelemetry::GetCapacity()
+{
+	return m_Mask + 1;
+}
+
+size_t Plugin::AMD::FrameTelemetry::Row(int64_t pts)
+{
+	return static_cast<size_t>(pts) & m_Mask;
+}
@@ -0,0 +1,107 @@
+/*
+ * A Plugin that integrates the AMD AMF encoder into OBS Studio
+ * Copyright (C) 2016 - 2018 Michael Fabian Dirks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "amf-wait.hpp"
+#include <thread>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define CPU_RELAX() _mm_pause()
+#elif defined(__i386__) || defined(__x86_64__)
+#include <immintrin.h>
+#define CPU_RELAX() _mm_pause()
+#else
+#define CPU_RELAX() (void)0
+#endif
+
+// Attempts that only spin. Each one is a short burst of pause instructions, a few microseconds in total.
+#define WAIT_SPIN_ATTEMPTS 16
+#define WAIT_SPIN_ITERATIONS 256
+// Attempts after spinning that give up the time slice before blocking.
+#define WAIT_YIELD_ATTEMPTS 16
+
+using namespace Plugin;
+using namespace Plugin::AMD;
+
+Plugin::AMD::WaitEvent::WaitEvent()
+{
+	m_Pending = 0;
+}
+
+void Plugin::AMD::WaitEvent::Notify()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_Lock);
+		m_Pending++;
+	}
+	m_CondVar.notify_all();
+}
+
+bool Plugin::AMD::WaitEvent::Consume()
+{
+	uint64_t pending = m_Pending.load(std::memory_order_acquire);
+	while (pending > 0) {
+		if (m_Pending.compare_exchange_weak(pending, 0, std::memory_order_acq_rel))
+			return true;
+	}
+	return false;
+}
+
+std::chrono::nanoseconds Plugin::AMD::WaitEvent::Wait(WaitStrategy strategy, uint64_t attempt,
+													  std::chrono::nanoseconds timeout)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	switch (strategy) {
+	case WaitStrategy::Sleep:
+		std::this_thread::sleep_for(timeout);
+		break;
+	case WaitStrategy::Hybrid:
+		if (Consume())
+			break;
+
+		if (attempt < WAIT_SPIN_ATTEMPTS) {
+			for (size_t i = 0; i < WAIT_SPIN_ITERATIONS; i++) {
+				if (m_Pending.load(std::memory_order_relaxed) > 0)
+					break;
+				CPU_RELAX();
+			}
+			Consume();
+		} else if (attempt < WAIT_SPIN_ATTEMPTS + WAIT_YIELD_ATTEMPTS) {
+			std::this_thread::yield();
+			Consume();
+		} else {
+			std::unique_lock<std::mutex> lock(m_Lock);
+			m_CondVar.wait_for(lock, timeout, [this] { return m_Pending.load() > 0; });
+			m_Pending = 0;
+		}
+		break;
+	}
+
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start);
+}
+
+std::chrono::nanoseconds Plugin::AMD::WaitEvent::Poll(WaitStrategy strategy, uint64_t attempt,
+													  std::chrono::nanoseconds timeout)
+{
+	// Blocking would always run into the timeout, and the condition variable only adds overhead to that.
+	if ((strategy == WaitStrategy::Hybrid) && (attempt >= WAIT_SPIN_ATTEMPTS + WAIT_YIELD_ATTEMPTS))
+		strategy = WaitStrategy::Sleep;
+	return Wait(strategy, attempt, timeout);
+}
@@ -21,30 +21,86 @@
 #include <mutex>
 #include <vector>
 
-#include <components\Component.h>
-#include <components\ComponentCaps.h>
-#include <components\VideoEncoderVCE.h>
+#include <components/Component.h>
+#include <components/ComponentCaps.h>
+#include <components/VideoEncoderVCE.h>
 
 #if defined(_WIN32) || defined(_WIN64)
 extern "C" {
 #include <windows.h>
 }
+#else
+#include <cwchar>
+#include <dlfcn.h>
 #endif
 
 using namespace Plugin::AMD;
 
+#pragma region Runtime Library
+#ifdef _WIN32
+static void* runtime_open(const char* path)
+{
+	if (path)
+		return LoadLibraryA(path);
+	return LoadLibraryW(AMF_DLL_NAME);
+}
+
+static void* runtime_symbol(void* module, const char* name)
+{
+	return reinterpret_cast<void*>(GetProcAddress(reinterpret_cast<HMODULE>(module), name));
+}
+
+static void runtime_close(void* module)
+{
+	FreeLibrary(reinterpret_cast<HMODULE>(module));
+}
+
+static long runtime_error_code()
+{
+	return (long)GetLastError();
+}
+#else
+static void* runtime_open(const char* path)
+{
+	return dlopen(path ? path : AMF_DLL_NAMEA, RTLD_NOW | RTLD_LOCAL);
+}
+
+static void* runtime_symbol(void* module, const char* name)
+{
+	return dlsym(module, name);
+}
+
+static void runtime_close(void* module)
+{
+	dlclose(module);
+}
+
+static long runtime_error_code()
+{
+	const char* error = dlerror();
+	if (error)
+		PLOG_WARNING("%s", error);
+	return -1;
+}
+#endif
+#pragma endregion Runtime Library
+
 class CustomWriter : public amf::AMFTraceWriter {
 	public:
-	virtual void __cdecl Write(const wchar_t*, const wchar_t* message) override
+	virtual void AMF_CDECL_CALL Write(const wchar_t*, const wchar_t* message) override
 	{
 #ifndef LITE_OBS
+#ifdef _WIN32
 		blog(LOG_DEBUG, "[AMF] %.*ls", wcsnlen_s(message, 65535), message);
+#else
+		blog(LOG_DEBUG, "[AMF] %.*ls", (int)wcsnlen(message, 65535), message);
+#endif
 #else
 		message;
 #endif
 	}
 
-	virtual void __cdecl Flush() override {}
+	virtual void AMF_CDECL_CALL Flush() override {}
 };
 
 #pragma region    Singleton
@@ -82,7 +138,7 @@ Plugin::AMD::AMF::AMF()
 	m_TimerPeriod        = 0;
 	m_AMFVersion_Plugin  = AMF_FULL_VERSION;
 	m_AMFVersion_Runtime = 0;
-	m_AMFModule          = 0;
+	m_AMFModule          = nullptr;
 
 	m_AMFFactory    = nullptr;
 	m_AMFTrace      = nullptr;
@@ -93,27 +149,29 @@ Plugin::AMD::AMF::AMF()
 	m_TimerPeriod   = 0;
 #pragma endregion Null Class Members
 
-#ifdef _WIN32
 	std::vector<char> verbuf;
 	void*             pProductVersion     = nullptr;
 	uint32_t          lProductVersionSize = 0;
-#endif
 
 	// Initialize AMF Library
 	PLOG_DEBUG("<%s> Initializing...", __FUNCTION_NAME__);
 
 	// Load AMF Runtime Library
-	m_AMFModule = LoadLibraryW(AMF_DLL_NAME);
+	const char* runtimePath = getenv(AMF_RUNTIME_OVERRIDE_ENV);
+	if (runtimePath && (runtimePath[0] == '\0'))
+		runtimePath = nullptr;
+	m_AMFModule = runtime_open(runtimePath);
 	if (!m_AMFModule) {
-		QUICK_FORMAT_MESSAGE(msg, "Unable to load '%ls', error code %ld.", AMF_DLL_NAME, GetLastError());
-		throw std::exception(msg.data());
+		QUICK_FORMAT_MESSAGE(msg, "Unable to load '%s', error code %ld.", runtimePath ? runtimePath : AMF_DLL_NAMEA,
+							 runtime_error_code());
+		throw std::runtime_error(msg.data());
 	} else {
-		PLOG_DEBUG("<%s> Loaded '%ls'.", __FUNCTION_NAME__, AMF_DLL_NAME);
+		PLOG_DEBUG("<%s> Loaded '%s'.", __FUNCTION_NAME__, runtimePath ? runtimePath : AMF_DLL_NAMEA);
 	}
 
 // Windows: Get Product Version for Driver Matching
 #ifdef _WIN32
-	{
+	if (!runtimePath) {
 		verbuf.resize(static_cast<size_t>(GetFileVersionInfoSizeW(AMF_DLL_NAME, nullptr)) * 2);
 		GetFileVersionInfoW(AMF_DLL_NAME, 0, (DWORD)verbuf.size(), verbuf.data());
 
@@ -135,19 +193,19 @@ Plugin::AMD::AMF::AMF()
 		// Retrieve file description for language and code page "i".
 		VerQueryValueA(pBlock, buf.data(), &pProductVersion, &lProductVersionSize);
 	}
-#endif _WIN32
+#endif // _WIN32
 
 	// Query Runtime Version
-	AMFQueryVersion = (AMFQueryVersion_Fn)GetProcAddress(m_AMFModule, AMF_QUERY_VERSION_FUNCTION_NAME);
+	AMFQueryVersion = (AMFQueryVersion_Fn)runtime_symbol(m_AMFModule, AMF_QUERY_VERSION_FUNCTION_NAME);
 	if (!AMFQueryVersion) {
 		QUICK_FORMAT_MESSAGE(msg, "Incompatible AMF Runtime (could not find '%s'), error code %ld.",
-							 AMF_QUERY_VERSION_FUNCTION_NAME, GetLastError());
-		throw std::exception(msg.data());
+							 AMF_QUERY_VERSION_FUNCTION_NAME, runtime_error_code());
+		throw std::runtime_error(msg.data());
 	} else {
 		res = AMFQueryVersion(&m_AMFVersion_Runtime);
 		if (res != AMF_OK) {
 			QUICK_FORMAT_MESSAGE(msg, "Querying Version failed, error code %d.", res);
-			throw std::exception(msg.data());
+			throw std::runtime_error(msg.data());
 		}
 	}
 
@@ -158,16 +216,16 @@ Plugin::AMD::AMF::AMF()
 	}
 
 	/// Initialize AMF
-	AMFInit = (AMFInit_Fn)GetProcAddress(m_AMFModule, AMF_INIT_FUNCTION_NAME);
+	AMFInit = (AMFInit_Fn)runtime_symbol(m_AMFModule, AMF_INIT_FUNCTION_NAME);
 	if (!AMFInit) {
 		QUICK_FORMAT_MESSAGE(msg, "Incompatible AMF Runtime (could not find '%s'), error code %ld.",
-							 AMF_QUERY_VERSION_FUNCTION_NAME, GetLastError());
-		throw std::exception(msg.data());
+							 AMF_INIT_FUNCTION_NAME, runtime_error_code());
+		throw std::runtime_error(msg.data());
 	} else {
 		res = AMFInit(m_AMFVersion_Runtime, &m_AMFFactory);
 		if (res != AMF_OK) {
 			QUICK_FORMAT_MESSAGE(msg, "Initializing AMF Library failed, error code %d.", res);
-			throw std::exception(msg.data());
+			throw std::runtime_error(msg.data());
 		}
 	}
 	PLOG_DEBUG("<%s> AMF Library initialized.", __FUNCTION_NAME__);
@@ -176,14 +234,14 @@ Plugin::AMD::AMF::AMF()
 	res = m_AMFFactory->GetTrace(&m_AMFTrace);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(msg, "Retrieving AMF Trace class failed, error code %d.", res);
-		throw std::exception(msg.data());
+		throw std::runtime_error(msg.data());
 	}
 
 	/// Retrieve Debug Object.
 	res = m_AMFFactory->GetDebug(&m_AMFDebug);
 	if (res != AMF_OK) {
 		QUICK_FORMAT_MESSAGE(msg, "Retrieving AMF Debug class failed, error code %d.", res);
-		throw std::exception(msg.data());
+		throw std::runtime_error(msg.data());
 	}
 
 /// Register Trace Writer and disable Debug Tracing.
@@ -221,7 +279,7 @@ Plugin::AMD::AMF::~AMF()
 			m_TraceWriter = nullptr;
 		}
 
-		FreeLibrary(m_AMFModule);
+		runtime_close(m_AMFModule);
 	}
 	PLOG_DEBUG("<%s> Finalized.", __FUNCTION_NAME__);
 
@@ -229,7 +287,7 @@ Plugin::AMD::AMF::~AMF()
 	m_TimerPeriod        = 0;
 	m_AMFVersion_Plugin  = 0;
 	m_AMFVersion_Runtime = 0;
-	m_AMFModule          = 0;
+	m_AMFModule          = nullptr;
 
 	m_AMFFactory    = nullptr;
 	m_AMFTrace      = nullptr;
@@ -257,9 +315,9 @@ amf::AMFDebug* Plugin::AMD::AMF::GetDebug()
 void Plugin::AMD::AMF::EnableDebugTrace(bool enable)
 {
 	if (!m_AMFTrace)
-		throw std::exception("called without a AMFTrace object!");
+		throw std::runtime_error("called without a AMFTrace object!");
 	if (!m_AMFDebug)
-		throw std::exception("called without a AMFDebug object!");
+		throw std::runtime_error("called without a AMFDebug object!");
 
 #ifndef _WIN64
 	// Older drivers crash due to using the wrong calling standard.
@@ -285,7 +343,11 @@ void Plugin::AMD::AMF::EnableDebugTrace(bool enable)
 	// File
 	m_AMFTrace->EnableWriter(AMF_TRACE_WRITER_FILE, false);
 	m_AMFTrace->SetWriterLevel(AMF_TRACE_WRITER_FILE, AMF_TRACE_NOLOG);
+#ifdef _WIN32
 	m_AMFTrace->SetPath(L"C:\\AMFTrace.log");
+#else
+	m_AMFTrace->SetPath(L"/tmp/AMFTrace.log");
+#endif
 
 // Debug Output
 #ifdef _DEBUG
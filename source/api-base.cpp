@@ -19,12 +19,12 @@
 
 #include "api-base.hpp"
 #include <cinttypes>
-#include "api-d3d11.hpp"
-#include "api-d3d9.hpp"
 #include "api-host.hpp"
-#include "api-opengl.hpp"
 
 #if defined(_WIN32) || defined(_WIN64)
+#include "api-d3d11.hpp"
+#include "api-d3d9.hpp"
+#include "api-opengl.hpp"
 extern "C" {
 #include <VersionHelpers.h>
 #include <windows.h>
@@ -120,6 +120,9 @@ void                                      Plugin::API::InitializeAPIs()
 			PLOG_WARNING("Direct3D 9 not supported.");
 		}
 	}
+#else
+	// Without Direct3D only host memory is available, which is what the amf-stub runtime provides.
+	s_APIInstances.insert(s_APIInstances.end(), std::make_shared<Host>());
 #endif
 
 	// Mikhail says these are for compatibility only, not actually backends.
@@ -147,7 +150,7 @@ size_t Plugin::API::CountAPIs()
 std::string Plugin::API::GetAPIName(size_t index)
 {
 	if (index >= s_APIInstances.size())
-		throw std::exception("Invalid API Index");
+		throw std::runtime_error("Invalid API Index");
 
 	return s_APIInstances[index].get()->GetName();
 }
@@ -155,7 +158,7 @@ std::string Plugin::API::GetAPIName(size_t index)
 std::shared_ptr<IAPI> Plugin::API::GetAPI(size_t index)
 {
 	if (index >= s_APIInstances.size())
-		throw std::exception("Invalid API Index");
+		throw std::runtime_error("Invalid API Index");
 
 	return s_APIInstances[index];
 }
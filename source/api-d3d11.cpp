@@ -41,7 +41,7 @@ class SingletonDXGI {
 	{
 		hModule = LoadLibrary(TEXT("dxgi.dll"));
 		if (hModule == 0)
-			throw std::exception("Unable to load 'dxgi.dll'.");
+			throw std::runtime_error("Unable to load 'dxgi.dll'.");
 	}
 	~SingletonDXGI()
 	{
@@ -103,7 +103,7 @@ class SingletonD3D11 {
 	{
 		hModule = LoadLibrary(TEXT("d3d11.dll"));
 		if (hModule == 0)
-			throw std::exception("Unable to load 'd3d11.dll'.");
+			throw std::runtime_error("Unable to load 'd3d11.dll'.");
 	}
 	~SingletonD3D11()
 	{
@@ -149,7 +149,7 @@ Plugin::API::Direct3D11::Direct3D11()
 	if (FAILED(hr)) {
 		std::vector<char> buf(1024);
 		snprintf(buf.data(), buf.size(), "<%s> Unable to create DXGI, error code %X.", __FUNCTION_NAME__, hr);
-		throw std::exception(buf.data());
+		throw std::runtime_error(buf.data());
 	}
 
 	// Enumerate Adapters
@@ -259,7 +259,7 @@ Plugin::API::Direct3D11Instance::Direct3D11Instance(Direct3D11* api, Adapter ada
 	if (FAILED(hr)) {
 		std::vector<char> buf(1024);
 		snprintf(buf.data(), buf.size(), "<%s> Unable to create D3D11 device, error code %X.", __FUNCTION_NAME__, hr);
-		throw std::exception(buf.data());
+		throw std::runtime_error(buf.data());
 	}
 }
 
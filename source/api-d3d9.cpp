@@ -30,7 +30,7 @@ Plugin::API::Direct3D9::Direct3D9()
 	if (FAILED(hr)) {
 		std::vector<char> buf(1024);
 		snprintf(buf.data(), buf.size(), "<%s> Failed to create D3D9Ex, error code %X.", __FUNCTION_NAME__, hr);
-		throw std::exception(buf.data());
+		throw std::runtime_error(buf.data());
 	}
 
 	std::list<LUID>        enumeratedLUIDs;
@@ -141,7 +141,7 @@ Plugin::API::Direct3D9Instance::Direct3D9Instance(Direct3D9* api, Adapter adapte
 		std::vector<char> buf(1024);
 		snprintf(buf.data(), buf.size(), "<%s> Unable to query capabilities for D3D9 adapter, error code %X.",
 				 __FUNCTION_NAME__, hr);
-		throw std::exception(buf.data());
+		throw std::runtime_error(buf.data());
 	}
 
 	DWORD vp = 0;
@@ -157,7 +157,7 @@ Plugin::API::Direct3D9Instance::Direct3D9Instance(Direct3D9* api, Adapter adapte
 	if (FAILED(hr)) {
 		std::vector<char> buf(1024);
 		snprintf(buf.data(), buf.size(), "<%s> Unable to create D3D9 device, error code %X.", __FUNCTION_NAME__, hr);
-		throw std::exception(buf.data());
+		throw std::runtime_error(buf.data());
 	}
 }
 
@@ -183,7 +183,7 @@ Plugin::API::Adapter Plugin::API::Direct3D9Instance::GetAdapter()
 	if (FAILED(hr)) {
 		std::vector<char> buf(1024);
 		snprintf(buf.data(), "<%s> Unable to get adapter from D3D9 device, error code %X.", __FUNCTION_NAME__, hr);
-		throw std::exception(buf.data());
+		throw std::runtime_error(buf.data());
 	}
 
 	auto adapters = Direct3D9::EnumerateAdapters();
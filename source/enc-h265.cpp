@@ -19,7 +19,9 @@
 
 #include "amf-capabilities.hpp"
 #include "amf-encoder-h265.hpp"
+#include "amf-encoder-pool.hpp"
 #include "amf-encoder.hpp"
+#include "amf-property-transaction.hpp"
 #include "enc-h265.hpp"
 #include "strings.hpp"
 #include "utility.hpp"
@@ -134,8 +136,13 @@ void Plugin::Interface::H265Interface::get_defaults(obs_data_t* data) noexcept
 	obs_data_set_default_int(data, P_VIDEO_ADAPTER, 0);
 	obs_data_set_default_int(data, P_OPENCL_TRANSFER, 0);
 	obs_data_set_default_int(data, P_OPENCL_CONVERSION, 0);
+	obs_data_set_default_int(data, P_COLORCONVERSION, static_cast<int32_t>(ColorConversion::AMF));
 	obs_data_set_default_int(data, P_MULTITHREADING, 0);
 	obs_data_set_default_int(data, P_QUEUESIZE, 8);
+	obs_data_set_default_int(data, P_WAITSTRATEGY, static_cast<int32_t>(WaitStrategy::Hybrid));
+	obs_data_set_default_int(data, P_HELPERTHREADS, 2);
+	obs_data_set_default_int(data, P_WARMSTANDBY, 0);
+	obs_data_set_default_int(data, P_PREROLL, 0);
 	obs_data_set_int(data, ("last" P_VIEW), -1);
 	obs_data_set_default_int(data, ("last" P_VIEW), -1);
 	obs_data_set_default_int(data, P_VIEW, static_cast<int64_t>(ViewMode::Basic));
@@ -412,6 +419,12 @@ try {
 	obs_property_list_add_int(p, P_TRANSLATE(P_UTIL_SWITCH_ENABLED), 1);
 #pragma endregion OpenCL
 
+	p = obs_properties_add_list(props, P_COLORCONVERSION, P_TRANSLATE(P_COLORCONVERSION), OBS_COMBO_TYPE_LIST,
+								OBS_COMBO_FORMAT_INT);
+	obs_property_set_long_description(p, P_TRANSLATE(P_DESC(P_COLORCONVERSION)));
+	obs_property_list_add_int(p, P_TRANSLATE(P_COLORCONVERSION_AMF), static_cast<int32_t>(ColorConversion::AMF));
+	obs_property_list_add_int(p, P_TRANSLATE(P_COLORCONVERSION_HOST), static_cast<int32_t>(ColorConversion::Host));
+
 #pragma region Asynchronous Queue
 	p = obs_properties_add_list(props, P_MULTITHREADING, P_TRANSLATE(P_MULTITHREADING), OBS_COMBO_TYPE_LIST,
 								OBS_COMBO_FORMAT_INT);
@@ -421,6 +434,24 @@ try {
 
 	p = obs_properties_add_int_slider(props, P_QUEUESIZE, P_TRANSLATE(P_QUEUESIZE), 1, 32, 1);
 	obs_property_set_long_description(p, P_TRANSLATE(P_DESC(P_QUEUESIZE)));
+
+	p = obs_properties_add_list(props, P_WAITSTRATEGY, P_TRANSLATE(P_WAITSTRATEGY), OBS_COMBO_TYPE_LIST,
+								OBS_COMBO_FORMAT_INT);
+	obs_property_set_long_description(p, P_TRANSLATE(P_DESC(P_WAITSTRATEGY)));
+	obs_property_list_add_int(p, P_TRANSLATE(P_WAITSTRATEGY_SLEEP), static_cast<int32_t>(WaitStrategy::Sleep));
+	obs_property_list_add_int(p, P_TRANSLATE(P_WAITSTRATEGY_HYBRID), static_cast<int32_t>(WaitStrategy::Hybrid));
+
+	p = obs_properties_add_int_slider(props, P_HELPERTHREADS, P_TRANSLATE(P_HELPERTHREADS), 0, 16, 1);
+	obs_property_set_long_description(p, P_TRANSLATE(P_DESC(P_HELPERTHREADS)));
+
+	p = obs_properties_add_list(props, P_WARMSTANDBY, P_TRANSLATE(P_WARMSTANDBY), OBS_COMBO_TYPE_LIST,
+								OBS_COMBO_FORMAT_INT);
+	obs_property_set_long_description(p, P_TRANSLATE(P_DESC(P_WARMSTANDBY)));
+	obs_property_list_add_int(p, P_TRANSLATE(P_UTIL_SWITCH_DISABLED), 0);
+	obs_property_list_add_int(p, P_TRANSLATE(P_UTIL_SWITCH_ENABLED), 1);
+
+	p = obs_properties_add_int_slider(props, P_PREROLL, P_TRANSLATE(P_PREROLL), 0, 16, 1);
+	obs_property_set_long_description(p, P_TRANSLATE(P_DESC(P_PREROLL)));
 #pragma endregion Asynchronous Queue
 
 #pragma region View Mode
@@ -512,12 +543,12 @@ try {
 		} adapterid  = {videoAdapter_cur};
 		auto adapter = api->GetAdapterById(adapterid.id[0], adapterid.id[1]);
 		try {
-			auto enc = EncoderH265(api, adapter);
+			auto caps = AMD::CapabilityManager::Instance()->GetEncoderCaps(Codec::HEVC, api, adapter);
 
-#define TEMP_LIMIT_DROPDOWN(func, enm, prop)                                             \
+#define TEMP_LIMIT_DROPDOWN(member, enm, prop)                                           \
 	{                                                                                    \
 		auto tmp_p = obs_properties_get(props, prop);                                    \
-		auto tmp_l = enc.func();                                                         \
+		auto tmp_l = caps->member;                                                       \
 		enm  tmp_s = static_cast<enm>(obs_data_get_int(data, obs_property_name(tmp_p))); \
 		for (size_t idx = 0; idx < obs_property_list_item_count(tmp_p); idx++) {         \
 			bool enabled = false;                                                        \
@@ -533,36 +564,36 @@ try {
 				obs_data_unset_user_value(data, obs_property_name(tmp_p));               \
 		}                                                                                \
 	}
-#define TEMP_LIMIT_SLIDER(func, prop)                                               \
+#define TEMP_LIMIT_SLIDER(member, prop)                                             \
 	{                                                                               \
 		auto tmp_p = obs_properties_get(props, prop);                               \
-		auto tmp_l = enc.func();                                                    \
+		auto tmp_l = caps->member;                                                  \
 		obs_property_int_set_limits(tmp_p, (int)tmp_l.first, (int)tmp_l.second, 1); \
 	}
-#define TEMP_LIMIT_SLIDER_BITRATE(func, prop)                                                     \
+#define TEMP_LIMIT_SLIDER_BITRATE(member, prop)                                                   \
 	{                                                                                             \
 		auto tmp_p = obs_properties_get(props, prop);                                             \
-		auto tmp_l = enc.func();                                                                  \
+		auto tmp_l = caps->member;                                                                \
 		obs_property_int_set_limits(tmp_p, (int)tmp_l.first / 1000, (int)tmp_l.second / 1000, 1); \
 	}
 
 			//TEMP_LIMIT_DROPDOWN(CapsUsage, AMD::Usage, P_USAGE);
-			TEMP_LIMIT_DROPDOWN(CapsQualityPreset, AMD::QualityPreset, P_QUALITYPRESET);
-			TEMP_LIMIT_DROPDOWN(CapsProfile, AMD::Profile, P_PROFILE);
-			TEMP_LIMIT_DROPDOWN(CapsProfileLevel, AMD::ProfileLevel, P_PROFILELEVEL);
+			TEMP_LIMIT_DROPDOWN(qualityPresets, AMD::QualityPreset, P_QUALITYPRESET);
+			TEMP_LIMIT_DROPDOWN(profiles, AMD::Profile, P_PROFILE);
+			TEMP_LIMIT_DROPDOWN(profileLevels, AMD::ProfileLevel, P_PROFILELEVEL);
 			{
 				auto tmp_p = obs_properties_get(props, P_PROFILELEVEL);
 				obs_property_list_item_disable(tmp_p, 0, false);
 			}
-			TEMP_LIMIT_DROPDOWN(CapsTier, AMD::H265::Tier, P_TIER);
+			TEMP_LIMIT_DROPDOWN(tiers, AMD::H265::Tier, P_TIER);
 			// Aspect Ratio - No limits, only affects players/transcoders
-			TEMP_LIMIT_DROPDOWN(CapsCodingType, AMD::CodingType, P_CODINGTYPE);
-			TEMP_LIMIT_SLIDER(CapsMaximumReferenceFrames, P_MAXIMUMREFERENCEFRAMES);
-			TEMP_LIMIT_DROPDOWN(CapsRateControlMethod, AMD::RateControlMethod, P_RATECONTROLMETHOD);
-			TEMP_LIMIT_DROPDOWN(CapsPrePassMode, AMD::PrePassMode, P_PREPASSMODE);
-			TEMP_LIMIT_SLIDER_BITRATE(CapsTargetBitrate, "bitrate");
-			TEMP_LIMIT_SLIDER_BITRATE(CapsPeakBitrate, P_BITRATE_PEAK);
-			TEMP_LIMIT_SLIDER_BITRATE(CapsVBVBufferSize, P_VBVBUFFER_SIZE);
+			TEMP_LIMIT_DROPDOWN(codingTypes, AMD::CodingType, P_CODINGTYPE);
+			TEMP_LIMIT_SLIDER(maximumReferenceFrames, P_MAXIMUMREFERENCEFRAMES);
+			TEMP_LIMIT_DROPDOWN(rateControlMethods, AMD::RateControlMethod, P_RATECONTROLMETHOD);
+			TEMP_LIMIT_DROPDOWN(prePassModes, AMD::PrePassMode, P_PREPASSMODE);
+			TEMP_LIMIT_SLIDER_BITRATE(targetBitrate, "bitrate");
+			TEMP_LIMIT_SLIDER_BITRATE(peakBitrate, P_BITRATE_PEAK);
+			TEMP_LIMIT_SLIDER_BITRATE(vbvBufferSize, P_VBVBUFFER_SIZE);
 		} catch (const std::exception& e) {
 			PLOG_ERROR("Exception occurred while updating capabilities: %s", e.what());
 		}
@@ -630,8 +661,13 @@ try {
 		std::make_pair(P_VIDEO_ADAPTER, ViewMode::Advanced),
 		std::make_pair(P_OPENCL_TRANSFER, ViewMode::Advanced),
 		std::make_pair(P_OPENCL_CONVERSION, ViewMode::Advanced),
+		std::make_pair(P_COLORCONVERSION, ViewMode::Advanced),
 		std::make_pair(P_MULTITHREADING, ViewMode::Expert),
 		std::make_pair(P_QUEUESIZE, ViewMode::Expert),
+		std::make_pair(P_WAITSTRATEGY, ViewMode::Expert),
+		std::make_pair(P_HELPERTHREADS, ViewMode::Expert),
+		std::make_pair(P_WARMSTANDBY, ViewMode::Expert),
+		std::make_pair(P_PREROLL, ViewMode::Expert),
 		std::make_pair(P_VIEW, ViewMode::Basic),
 		std::make_pair(P_DEBUG, ViewMode::Basic),
 	};
@@ -791,8 +827,11 @@ try {
 			P_VIDEO_ADAPTER,
 			P_OPENCL_TRANSFER,
 			P_OPENCL_CONVERSION,
+			P_COLORCONVERSION,
 			P_MULTITHREADING,
 			P_QUEUESIZE,
+			P_WARMSTANDBY,
+			P_PREROLL,
 			P_DEBUG,
 		};
 		for (const char* pr : hiddenProperties) {
@@ -823,15 +862,187 @@ Plugin::Interface::H265Interface::H265Interface(obs_data_t* data, obs_encoder_t*
 {
 	PLOG_DEBUG("<%s> Initializing...", __FUNCTION_NAME__);
 
-	m_Encoder = encoder;
+	m_Encoder     = encoder;
+	m_CreateTime  = std::chrono::high_resolution_clock::now();
+	m_WarmStart   = false;
+	m_FirstPacket = false;
 
 	// OBS Settings
 	uint32_t                        obsWidth     = obs_encoder_get_width(encoder);
 	uint32_t                        obsHeight    = obs_encoder_get_height(encoder);
 	video_t*                        obsVideoInfo = obs_encoder_video(encoder);
 	const struct video_output_info* voi          = video_output_get_info(obsVideoInfo);
-	uint32_t                        obsFPSnum    = voi->fps_num;
-	uint32_t                        obsFPSden    = voi->fps_den;
+
+	// Warm Standby, settings are copied before the encoder modifies them.
+	bool                        standby   = !!obs_data_get_int(data, P_WARMSTANDBY);
+	std::string                 signature = "";
+	std::shared_ptr<obs_data_t> settings  = nullptr;
+	if (standby) {
+		signature = GetStandbySignature(data, voi, obsWidth, obsHeight);
+		settings  = std::shared_ptr<obs_data_t>(obs_data_create(), obs_data_release);
+		get_defaults(settings.get());
+		obs_data_apply(settings.get(), data);
+
+		m_VideoEncoder =
+			std::unique_ptr<EncoderH265>(static_cast<EncoderH265*>(EncoderPool::Take(signature).release()));
+		m_WarmStart = !!m_VideoEncoder;
+	}
+	if (m_WarmStart) {
+		// Dynamic Properties (Can be changed during Encoding)
+		this->update(data);
+	} else {
+		m_VideoEncoder = CreateEncoder(data, voi, obsWidth, obsHeight);
+	}
+	if ((obsWidth == voi->width) && (obsHeight == voi->height)) // Scaled frames differ by scaler.
+		m_VideoEncoder->SetInputSource(obsVideoInfo);
+
+	// Prepare the next encoder with these settings, or get rid of a standby that is no longer wanted.
+	if (standby) {
+		struct video_output_info info = *voi;
+		EncoderPool::Prepare(signature, [settings, info, obsWidth, obsHeight]() {
+			return std::unique_ptr<Encoder>(CreateEncoder(settings.get(), &info, obsWidth, obsHeight));
+		});
+	} else {
+		EncoderPool::Clear();
+	}
+
+	PLOG_DEBUG("<%s> Complete.", __FUNCTION_NAME__);
+}
+
+void Plugin::Interface::H265Interface::destroy(void* ptr) noexcept
+try {
+	if (ptr)
+		delete static_cast<H265Interface*>(ptr);
+} catch (const std::exception& ex) {
+	PLOG_ERROR("Unexpected exception in %s: %s", __FUNCTION_NAME__, ex.what());
+} catch (...) {
+	PLOG_ERROR("Unexpected unknown exception in %s.", __FUNCTION_NAME__);
+}
+
+Plugin::Interface::H265Interface::~H265Interface()
+{
+	PLOG_DEBUG("<%s> Finalizing...", __FUNCTION_NAME__);
+	if (m_VideoEncoder) {
+		m_VideoEncoder->Stop();
+		m_VideoEncoder = nullptr;
+	}
+	PLOG_DEBUG("<%s> Complete.", __FUNCTION_NAME__);
+}
+
+bool Plugin::Interface::H265Interface::update(void* ptr, obs_data_t* settings) noexcept
+try {
+	if (ptr)
+		return static_cast<H265Interface*>(ptr)->update(settings);
+	return false;
+} catch (const std::exception& ex) {
+	PLOG_ERROR("Unexpected exception in %s: %s", __FUNCTION_NAME__, ex.what());
+	return false;
+} catch (...) {
+	PLOG_ERROR("Unexpected unknown exception in %s.", __FUNCTION_NAME__);
+	return false;
+}
+
+bool Plugin::Interface::H265Interface::update(obs_data_t* data)
+{
+	// A new output size or frame rate only needs the running encoder re-initialized.
+	if (m_VideoEncoder->IsStarted()) {
+		video_t*                        obsVideoInfo = obs_encoder_video(m_Encoder);
+		const struct video_output_info* voi          = video_output_get_info(obsVideoInfo);
+		std::pair<uint32_t, uint32_t>   resolution(obs_encoder_get_width(m_Encoder), obs_encoder_get_height(m_Encoder));
+		std::pair<uint32_t, uint32_t>   frameRate(voi->fps_num, voi->fps_den);
+		if ((resolution != m_VideoEncoder->GetResolution()) || (frameRate != m_VideoEncoder->GetFrameRate())) {
+			// The level is only applied by re-initializing, and depends on both.
+			m_VideoEncoder->SetProfileLevel(static_cast<ProfileLevel>(obs_data_get_int(data, P_PROFILELEVEL)),
+											resolution, frameRate);
+			m_VideoEncoder->Reconfigure(resolution, frameRate, nullptr);
+
+			bool unscaled = (resolution.first == voi->width) && (resolution.second == voi->height);
+			m_VideoEncoder->SetInputSource(unscaled ? obsVideoInfo : nullptr); // Scaled frames differ by scaler.
+		}
+	}
+
+	ApplyDynamicProperties(m_VideoEncoder.get(), data);
+	return true;
+}
+
+void Plugin::Interface::H265Interface::ApplyDynamicProperties(EncoderH265* encoder, obs_data_t* data)
+{
+	PropertyTransaction transaction(encoder);
+
+	uint32_t obsFPSnum = encoder->GetFrameRate().first;
+	uint32_t obsFPSden = encoder->GetFrameRate().second;
+
+	// Rate Control
+	RateControlMethod rcm = encoder->GetRateControlMethod();
+	if (rcm == RateControlMethod::ConstantQP) {
+		encoder->SetIFrameQPMinimum(encoder->CapsIFrameQPMinimum().first);
+		encoder->SetIFrameQPMaximum(encoder->CapsIFrameQPMaximum().second);
+		encoder->SetPFrameQPMinimum(encoder->CapsPFrameQPMinimum().first);
+		encoder->SetPFrameQPMaximum(encoder->CapsPFrameQPMaximum().second);
+		encoder->SetIFrameQP(static_cast<uint8_t>(obs_data_get_int(data, P_QP_IFRAME)));
+		encoder->SetPFrameQP(static_cast<uint8_t>(obs_data_get_int(data, P_QP_PFRAME)));
+		encoder->SetFillerDataEnabled(false);
+	} else {
+		encoder->SetIFrameQPMinimum(static_cast<uint8_t>(obs_data_get_int(data, P_QP_IFRAME_MINIMUM)));
+		encoder->SetIFrameQPMaximum(static_cast<uint8_t>(obs_data_get_int(data, P_QP_IFRAME_MAXIMUM)));
+		encoder->SetPFrameQPMinimum(static_cast<uint8_t>(obs_data_get_int(data, P_QP_PFRAME_MINIMUM)));
+		encoder->SetPFrameQPMaximum(static_cast<uint8_t>(obs_data_get_int(data, P_QP_PFRAME_MAXIMUM)));
+		encoder->SetTargetBitrate(static_cast<uint32_t>(obs_data_get_int(data, "bitrate") * 1000));
+		encoder->SetPeakBitrate(static_cast<uint32_t>(obs_data_get_int(data, P_BITRATE_PEAK) * 1000));
+	}
+	if (rcm == RateControlMethod::ConstantBitrate) {
+		encoder->SetPeakBitrate(static_cast<uint32_t>(obs_data_get_int(data, "bitrate") * 1000));
+		encoder->SetFillerDataEnabled(!!obs_data_get_int(data, P_FILLERDATA));
+	} else {
+		encoder->SetFillerDataEnabled(false);
+	}
+	encoder->SetFrameSkippingEnabled(!!obs_data_get_int(data, P_FRAMESKIPPING));
+	encoder->SetEnforceHRDEnabled(!!obs_data_get_int(data, P_ENFORCEHRD));
+
+	// Picture Control
+	double_t framerate = (double_t)obsFPSnum / (double_t)obsFPSden;
+	/// I/P/Skip Frame Interval/Period
+	{
+		uint32_t period = static_cast<uint32_t>(obs_data_get_double(data, P_INTERVAL_IFRAME) * framerate);
+		period          = max(period, static_cast<uint32_t>(obs_data_get_int(data, P_PERIOD_IFRAME)));
+		encoder->SetIFramePeriod(period);
+	}
+	{
+		uint32_t period = static_cast<uint32_t>(obs_data_get_double(data, P_INTERVAL_PFRAME) * framerate);
+		period          = max(period, static_cast<uint32_t>(obs_data_get_int(data, P_PERIOD_PFRAME)));
+		encoder->SetPFramePeriod(period);
+	}
+	{
+		uint32_t period = static_cast<uint32_t>(obs_data_get_double(data, P_INTERVAL_BFRAME) * framerate);
+		period          = max(period, static_cast<uint32_t>(obs_data_get_int(data, P_PERIOD_BFRAME)));
+		encoder->SetBFramePeriod(period);
+	}
+	{
+		uint32_t period = static_cast<uint32_t>(obs_data_get_int(data, P_FRAMESKIPPING_PERIOD));
+		encoder->SetFrameSkippingPeriod(period);
+		encoder->SetFrameSkippingBehaviour(!!obs_data_get_int(data, P_FRAMESKIPPING_BEHAVIOUR));
+	}
+
+	encoder->SetWaitStrategy(static_cast<WaitStrategy>(obs_data_get_int(data, P_WAITSTRATEGY)));
+	encoder->SetMaxHelperThreads((size_t)obs_data_get_int(data, P_HELPERTHREADS));
+	encoder->SetDebug(obs_data_get_bool(data, P_DEBUG));
+	transaction.Commit();
+
+	if (encoder->IsStarted()) {
+		encoder->LogProperties();
+		if (static_cast<ViewMode>(obs_data_get_int(data, P_VIEW)) >= ViewMode::Master)
+			PLOG_ERROR(
+				"View Mode 'Master' is active, avoid giving anything but basic support. Error is most likely caused by "
+				"user settings themselves.");
+	}
+}
+
+std::unique_ptr<EncoderH265> Plugin::Interface::H265Interface::CreateEncoder(obs_data_t*                     data,
+																			 const struct video_output_info* voi,
+																			 uint32_t obsWidth, uint32_t obsHeight)
+{
+	uint32_t obsFPSnum = voi->fps_num;
+	uint32_t obsFPSden = voi->fps_den;
 
 	//////////////////////////////////////////////////////////////////////////
 	/// Initialize Encoder
@@ -883,55 +1094,57 @@ Plugin::Interface::H265Interface::H265Interface(obs_data_t* data, obs_encoder_t*
 	} adapterid  = {obs_data_get_int(data, P_VIDEO_ADAPTER)};
 	auto adapter = api->GetAdapterById(adapterid.id[0], adapterid.id[1]);
 
-	m_VideoEncoder = std::make_unique<EncoderH265>(
+	std::unique_ptr<EncoderH265> encoder = std::make_unique<EncoderH265>(
 		api, adapter, !!obs_data_get_int(data, P_OPENCL_TRANSFER), !!obs_data_get_int(data, P_OPENCL_CONVERSION),
 		colorFormat, colorSpace, voi->range == VIDEO_RANGE_FULL, !!obs_data_get_int(data, P_MULTITHREADING),
 		(size_t)obs_data_get_int(data, P_QUEUESIZE));
 
 	/// Static Properties
-	m_VideoEncoder->SetUsage(Plugin::AMD::Usage::Transcoding);
-	m_VideoEncoder->SetQualityPreset(static_cast<QualityPreset>(obs_data_get_int(data, P_QUALITYPRESET)));
+	encoder->SetColorConversion(static_cast<ColorConversion>(obs_data_get_int(data, P_COLORCONVERSION)));
+	encoder->SetPreRollFrames((uint32_t)obs_data_get_int(data, P_PREROLL));
+	encoder->SetUsage(Plugin::AMD::Usage::Transcoding);
+	encoder->SetQualityPreset(static_cast<QualityPreset>(obs_data_get_int(data, P_QUALITYPRESET)));
 
 	/// Frame
-	m_VideoEncoder->SetResolution(std::make_pair(obsWidth, obsHeight));
-	m_VideoEncoder->SetFrameRate(std::make_pair(obsFPSnum, obsFPSden));
+	encoder->SetResolution(std::make_pair(obsWidth, obsHeight));
+	encoder->SetFrameRate(std::make_pair(obsFPSnum, obsFPSden));
 
 	/// Profile & Level
-	m_VideoEncoder->SetProfile(static_cast<Profile>(obs_data_get_int(data, P_PROFILE)));
-	m_VideoEncoder->SetProfileLevel(static_cast<ProfileLevel>(obs_data_get_int(data, P_PROFILELEVEL)),
+	encoder->SetProfile(static_cast<Profile>(obs_data_get_int(data, P_PROFILE)));
+	encoder->SetProfileLevel(static_cast<ProfileLevel>(obs_data_get_int(data, P_PROFILELEVEL)),
 									std::make_pair(obsWidth, obsHeight), std::make_pair(obsFPSnum, obsFPSden));
-	m_VideoEncoder->SetTier(static_cast<H265::Tier>(obs_data_get_int(data, P_TIER)));
+	encoder->SetTier(static_cast<H265::Tier>(obs_data_get_int(data, P_TIER)));
 
 	///- Aspect Ratio
 
 	try {
-		m_VideoEncoder->SetCodingType(static_cast<CodingType>(obs_data_get_int(data, P_CODINGTYPE)));
+		encoder->SetCodingType(static_cast<CodingType>(obs_data_get_int(data, P_CODINGTYPE)));
 	} catch (...) {
 	}
 	try {
-		m_VideoEncoder->SetMaximumReferenceFrames(obs_data_get_int(data, P_MAXIMUMREFERENCEFRAMES));
+		encoder->SetMaximumReferenceFrames(obs_data_get_int(data, P_MAXIMUMREFERENCEFRAMES));
 	} catch (...) {
 	}
 
 	// Rate Control
-	m_VideoEncoder->SetRateControlMethod(static_cast<RateControlMethod>(obs_data_get_int(data, P_RATECONTROLMETHOD)));
+	encoder->SetRateControlMethod(static_cast<RateControlMethod>(obs_data_get_int(data, P_RATECONTROLMETHOD)));
 	if (obs_data_get_int(data, P_VBVBUFFER) == 0) {
-		m_VideoEncoder->SetVBVBufferStrictness(obs_data_get_double(data, P_VBVBUFFER_STRICTNESS) / 100.0);
+		encoder->SetVBVBufferStrictness(obs_data_get_double(data, P_VBVBUFFER_STRICTNESS) / 100.0);
 	} else {
-		m_VideoEncoder->SetVBVBufferSize(static_cast<uint32_t>(obs_data_get_int(data, P_VBVBUFFER_SIZE) * 1000));
+		encoder->SetVBVBufferSize(static_cast<uint32_t>(obs_data_get_int(data, P_VBVBUFFER_SIZE) * 1000));
 	}
-	m_VideoEncoder->SetVBVBufferInitialFullness(obs_data_get_double(data, P_VBVBUFFER_INITIALFULLNESS) / 100.0f);
-	if (m_VideoEncoder->GetRateControlMethod() != RateControlMethod::ConstantQP) {
-		m_VideoEncoder->SetPrePassMode(static_cast<PrePassMode>(obs_data_get_int(data, P_PREPASSMODE)));
-		m_VideoEncoder->SetVarianceBasedAdaptiveQuantizationEnabled((!!obs_data_get_int(data, P_VBAQ)));
+	encoder->SetVBVBufferInitialFullness(obs_data_get_double(data, P_VBVBUFFER_INITIALFULLNESS) / 100.0f);
+	if (encoder->GetRateControlMethod() != RateControlMethod::ConstantQP) {
+		encoder->SetPrePassMode(static_cast<PrePassMode>(obs_data_get_int(data, P_PREPASSMODE)));
+		encoder->SetVarianceBasedAdaptiveQuantizationEnabled((!!obs_data_get_int(data, P_VBAQ)));
 	} else {
-		m_VideoEncoder->SetPrePassMode(PrePassMode::Disabled);
-		m_VideoEncoder->SetVarianceBasedAdaptiveQuantizationEnabled(false);
+		encoder->SetPrePassMode(PrePassMode::Disabled);
+		encoder->SetVarianceBasedAdaptiveQuantizationEnabled(false);
 	}
 	try {
 		int64_t v = obs_data_get_int(data, P_HIGHMOTIONQUALITYBOOST);
 		if (v >= 0) {
-			m_VideoEncoder->SetHighMotionQualityBoost(!!v);
+			encoder->SetHighMotionQualityBoost(!!v);
 		}
 	} catch (...) {
 	}
@@ -939,7 +1152,7 @@ Plugin::Interface::H265Interface::H265Interface(obs_data_t* data, obs_encoder_t*
 	// Picture Control
 	uint32_t      gopSize = static_cast<uint32_t>(amf_clamp(floor(obsFPSnum / (double_t)obsFPSden), 1, 1000));
 	H265::GOPType gopType = static_cast<H265::GOPType>(obs_data_get_int(data, P_GOP_TYPE));
-	m_VideoEncoder->SetGOPType(gopType);
+	encoder->SetGOPType(gopType);
 	if (static_cast<ViewMode>(obs_data_get_int(data, P_VIEW)) >= ViewMode::Expert) {
 		switch (gopType) {
 		case H265::GOPType::Fixed:
@@ -948,12 +1161,12 @@ Plugin::Interface::H265Interface::H265Interface(obs_data_t* data, obs_encoder_t*
 		case H265::GOPType::Variable:
 			gopSize =
 				(uint32_t)(obs_data_get_int(data, P_GOP_SIZE_MINIMUM) + obs_data_get_int(data, P_GOP_SIZE_MAXIMUM)) / 2;
-			m_VideoEncoder->SetGOPSizeMin((uint32_t)obs_data_get_int(data, P_GOP_SIZE_MINIMUM));
-			m_VideoEncoder->SetGOPSizeMax((uint32_t)obs_data_get_int(data, P_GOP_SIZE_MAXIMUM));
+			encoder->SetGOPSizeMin((uint32_t)obs_data_get_int(data, P_GOP_SIZE_MINIMUM));
+			encoder->SetGOPSizeMax((uint32_t)obs_data_get_int(data, P_GOP_SIZE_MAXIMUM));
 			break;
 		}
 	}
-	m_VideoEncoder->SetGOPSize(gopSize);
+	encoder->SetGOPSize(gopSize);
 	/// Keyframe Interval/Period
 	double_t framerate = (double_t)obsFPSnum / (double_t)obsFPSden;
 	{
@@ -962,11 +1175,11 @@ Plugin::Interface::H265Interface::H265Interface(obs_data_t* data, obs_encoder_t*
 			double_t keyinterv = obs_data_get_double(data, P_INTERVAL_KEYFRAME);
 			idrperiod          = static_cast<uint32_t>(ceil((keyinterv * framerate) / gopSize));
 		}
-		m_VideoEncoder->SetIDRPeriod(amf_clamp(idrperiod, 1, 1000));
+		encoder->SetIDRPeriod(amf_clamp(idrperiod, 1, 1000));
 	}
-	m_VideoEncoder->SetDeblockingFilterEnabled(!!obs_data_get_int(data, P_DEBLOCKINGFILTER));
-	m_VideoEncoder->SetMotionEstimationHalfPixelEnabled(!!(obs_data_get_int(data, P_MOTIONESTIMATION) & 1));
-	m_VideoEncoder->SetMotionEstimationQuarterPixelEnabled(!!(obs_data_get_int(data, P_MOTIONESTIMATION) & 2));
+	encoder->SetDeblockingFilterEnabled(!!obs_data_get_int(data, P_DEBLOCKINGFILTER));
+	encoder->SetMotionEstimationHalfPixelEnabled(!!(obs_data_get_int(data, P_MOTIONESTIMATION) & 1));
+	encoder->SetMotionEstimationQuarterPixelEnabled(!!(obs_data_get_int(data, P_MOTIONESTIMATION) & 2));
 
 	// OBS - Enforce Streaming Service Restrictions
 #pragma region OBS - Enforce Streaming Service Restrictions
@@ -975,7 +1188,7 @@ Plugin::Interface::H265Interface::H265Interface(obs_data_t* data, obs_encoder_t*
 		const char* p_str = obs_data_get_string(data, "profile");
 		if (strcmp(p_str, "") != 0) {
 			if (strcmp(p_str, "main")) {
-				m_VideoEncoder->SetProfile(Profile::Main);
+				encoder->SetProfile(Profile::Main);
 			}
 			obs_data_unset_user_value(data, "profile");
 		}
@@ -984,13 +1197,13 @@ Plugin::Interface::H265Interface::H265Interface(obs_data_t* data, obs_encoder_t*
 		const char* preset = obs_data_get_string(data, "preset");
 		if (strcmp(preset, "") != 0) {
 			if (strcmp(preset, "speed") == 0) {
-				m_VideoEncoder->SetQualityPreset(QualityPreset::Speed);
+				encoder->SetQualityPreset(QualityPreset::Speed);
 			} else if (strcmp(preset, "balanced") == 0) {
-				m_VideoEncoder->SetQualityPreset(QualityPreset::Balanced);
+				encoder->SetQualityPreset(QualityPreset::Balanced);
 			} else if (strcmp(preset, "quality") == 0) {
-				m_VideoEncoder->SetQualityPreset(QualityPreset::Quality);
+				encoder->SetQualityPreset(QualityPreset::Quality);
 			}
-			obs_data_set_int(data, P_QUALITYPRESET, (int32_t)m_VideoEncoder->GetQualityPreset());
+			obs_data_set_int(data, P_QUALITYPRESET, (int32_t)encoder->GetQualityPreset());
 			obs_data_unset_user_value(data, "preset");
 		}
 
@@ -998,140 +1211,47 @@ Plugin::Interface::H265Interface::H265Interface(obs_data_t* data, obs_encoder_t*
 		const char* t_str = obs_data_get_string(data, "rate_control");
 		if (strcmp(t_str, "") != 0) {
 			if (strcmp(t_str, "CBR") == 0) {
-				m_VideoEncoder->SetRateControlMethod(RateControlMethod::ConstantBitrate);
-				m_VideoEncoder->SetFillerDataEnabled(true);
+				encoder->SetRateControlMethod(RateControlMethod::ConstantBitrate);
+				encoder->SetFillerDataEnabled(true);
 			} else if (strcmp(t_str, "VBR") == 0) {
-				m_VideoEncoder->SetRateControlMethod(RateControlMethod::PeakConstrainedVariableBitrate);
+				encoder->SetRateControlMethod(RateControlMethod::PeakConstrainedVariableBitrate);
 			} else if (strcmp(t_str, "VBR_LAT") == 0) {
-				m_VideoEncoder->SetRateControlMethod(RateControlMethod::LatencyConstrainedVariableBitrate);
+				encoder->SetRateControlMethod(RateControlMethod::LatencyConstrainedVariableBitrate);
 			} else if (strcmp(t_str, "CQP") == 0) {
-				m_VideoEncoder->SetRateControlMethod(RateControlMethod::ConstantQP);
+				encoder->SetRateControlMethod(RateControlMethod::ConstantQP);
 			}
 
-			obs_data_set_int(data, P_RATECONTROLMETHOD, (int32_t)m_VideoEncoder->GetRateControlMethod());
+			obs_data_set_int(data, P_RATECONTROLMETHOD, (int32_t)encoder->GetRateControlMethod());
 			obs_data_unset_user_value(data, "rate_control");
 		}
 	}
 #pragma endregion OBS - Enforce Streaming Service Restrictions
 
 	// Dynamic Properties (Can be changed during Encoding)
-	this->update(data);
+	ApplyDynamicProperties(encoder.get(), data);
 
 	// Initialize (locks static properties)
 	try {
-		m_VideoEncoder->Start();
+		encoder->Start();
 	} catch (...) {
 		throw;
 	}
 
 	// Dynamic Properties (Can be changed during Encoding)
-	this->update(data);
-
-	PLOG_DEBUG("<%s> Complete.", __FUNCTION_NAME__);
-}
-
-void Plugin::Interface::H265Interface::destroy(void* ptr) noexcept
-try {
-	if (ptr)
-		delete static_cast<H265Interface*>(ptr);
-} catch (const std::exception& ex) {
-	PLOG_ERROR("Unexpected exception in %s: %s", __FUNCTION_NAME__, ex.what());
-} catch (...) {
-	PLOG_ERROR("Unexpected unknown exception in %s.", __FUNCTION_NAME__);
-}
-
-Plugin::Interface::H265Interface::~H265Interface()
-{
-	PLOG_DEBUG("<%s> Finalizing...", __FUNCTION_NAME__);
-	if (m_VideoEncoder) {
-		m_VideoEncoder->Stop();
-		m_VideoEncoder = nullptr;
-	}
-	PLOG_DEBUG("<%s> Complete.", __FUNCTION_NAME__);
-}
+	ApplyDynamicProperties(encoder.get(), data);
 
-bool Plugin::Interface::H265Interface::update(void* ptr, obs_data_t* settings) noexcept
-try {
-	if (ptr)
-		return static_cast<H265Interface*>(ptr)->update(settings);
-	return false;
-} catch (const std::exception& ex) {
-	PLOG_ERROR("Unexpected exception in %s: %s", __FUNCTION_NAME__, ex.what());
-	return false;
-} catch (...) {
-	PLOG_ERROR("Unexpected unknown exception in %s.", __FUNCTION_NAME__);
-	return false;
+	return encoder;
 }
 
-bool Plugin::Interface::H265Interface::update(obs_data_t* data)
+std::string Plugin::Interface::H265Interface::GetStandbySignature(obs_data_t*                     data,
+																	const struct video_output_info* voi, uint32_t width,
+																	uint32_t height)
 {
-	const video_t*                  obsVideoInfo = obs_encoder_video(m_Encoder);
-	const struct video_output_info* voi          = video_output_get_info(obsVideoInfo);
-	uint32_t                        obsFPSnum    = voi->fps_num;
-	uint32_t                        obsFPSden    = voi->fps_den;
-
-	// Rate Control
-	RateControlMethod rcm = m_VideoEncoder->GetRateControlMethod();
-	if (rcm == RateControlMethod::ConstantQP) {
-		m_VideoEncoder->SetIFrameQPMinimum(m_VideoEncoder->CapsIFrameQPMinimum().first);
-		m_VideoEncoder->SetIFrameQPMaximum(m_VideoEncoder->CapsIFrameQPMaximum().second);
-		m_VideoEncoder->SetPFrameQPMinimum(m_VideoEncoder->CapsPFrameQPMinimum().first);
-		m_VideoEncoder->SetPFrameQPMaximum(m_VideoEncoder->CapsPFrameQPMaximum().second);
-		m_VideoEncoder->SetIFrameQP(static_cast<uint8_t>(obs_data_get_int(data, P_QP_IFRAME)));
-		m_VideoEncoder->SetPFrameQP(static_cast<uint8_t>(obs_data_get_int(data, P_QP_PFRAME)));
-		m_VideoEncoder->SetFillerDataEnabled(false);
-	} else {
-		m_VideoEncoder->SetIFrameQPMinimum(static_cast<uint8_t>(obs_data_get_int(data, P_QP_IFRAME_MINIMUM)));
-		m_VideoEncoder->SetIFrameQPMaximum(static_cast<uint8_t>(obs_data_get_int(data, P_QP_IFRAME_MAXIMUM)));
-		m_VideoEncoder->SetPFrameQPMinimum(static_cast<uint8_t>(obs_data_get_int(data, P_QP_PFRAME_MINIMUM)));
-		m_VideoEncoder->SetPFrameQPMaximum(static_cast<uint8_t>(obs_data_get_int(data, P_QP_PFRAME_MAXIMUM)));
-		m_VideoEncoder->SetTargetBitrate(static_cast<uint32_t>(obs_data_get_int(data, "bitrate") * 1000));
-		m_VideoEncoder->SetPeakBitrate(static_cast<uint32_t>(obs_data_get_int(data, P_BITRATE_PEAK) * 1000));
-	}
-	if (rcm == RateControlMethod::ConstantBitrate) {
-		m_VideoEncoder->SetPeakBitrate(static_cast<uint32_t>(obs_data_get_int(data, "bitrate") * 1000));
-		m_VideoEncoder->SetFillerDataEnabled(!!obs_data_get_int(data, P_FILLERDATA));
-	} else {
-		m_VideoEncoder->SetFillerDataEnabled(false);
-	}
-	m_VideoEncoder->SetFrameSkippingEnabled(!!obs_data_get_int(data, P_FRAMESKIPPING));
-	m_VideoEncoder->SetEnforceHRDEnabled(!!obs_data_get_int(data, P_ENFORCEHRD));
-
-	// Picture Control
-	double_t framerate = (double_t)obsFPSnum / (double_t)obsFPSden;
-	/// I/P/Skip Frame Interval/Period
-	{
-		uint32_t period = static_cast<uint32_t>(obs_data_get_double(data, P_INTERVAL_IFRAME) * framerate);
-		period          = max(period, static_cast<uint32_t>(obs_data_get_int(data, P_PERIOD_IFRAME)));
-		m_VideoEncoder->SetIFramePeriod(period);
-	}
-	{
-		uint32_t period = static_cast<uint32_t>(obs_data_get_double(data, P_INTERVAL_PFRAME) * framerate);
-		period          = max(period, static_cast<uint32_t>(obs_data_get_int(data, P_PERIOD_PFRAME)));
-		m_VideoEncoder->SetPFramePeriod(period);
-	}
-	{
-		uint32_t period = static_cast<uint32_t>(obs_data_get_double(data, P_INTERVAL_BFRAME) * framerate);
-		period          = max(period, static_cast<uint32_t>(obs_data_get_int(data, P_PERIOD_BFRAME)));
-		m_VideoEncoder->SetBFramePeriod(period);
-	}
-	{
-		uint32_t period = static_cast<uint32_t>(obs_data_get_int(data, P_FRAMESKIPPING_PERIOD));
-		m_VideoEncoder->SetFrameSkippingPeriod(period);
-		m_VideoEncoder->SetFrameSkippingBehaviour(!!obs_data_get_int(data, P_FRAMESKIPPING_BEHAVIOUR));
-	}
-
-	m_VideoEncoder->SetDebug(obs_data_get_bool(data, P_DEBUG));
-
-	if (m_VideoEncoder->IsStarted()) {
-		m_VideoEncoder->LogProperties();
-		if (static_cast<ViewMode>(obs_data_get_int(data, P_VIEW)) >= ViewMode::Master)
-			PLOG_ERROR(
-				"View Mode 'Master' is active, avoid giving anything but basic support. Error is most likely caused by "
-				"user settings themselves.");
-	}
-
-	return true;
+	// Settings are compared as a whole, static properties can't be changed on the standby.
+	QUICK_FORMAT_MESSAGE(video, PREFIX " %" PRIu32 "x%" PRIu32 " %" PRIu32 "/%" PRIu32 " %d/%d/%d ", width, height,
+						 voi->fps_num, voi->fps_den, (int32_t)voi->format, (int32_t)voi->colorspace,
+						 (int32_t)voi->range);
+	return video + obs_data_get_json(data);
 }
 
 bool Plugin::Interface::H265Interface::encode(void* ptr, struct encoder_frame* frame, struct encoder_packet* packet,
@@ -1154,14 +1274,21 @@ bool Plugin::Interface::H265Interface::encode(struct encoder_frame* frame, struc
 	if (!frame || !packet || !received_packet)
 		return false;
 
+	bool retVal = false;
 	try {
-		return m_VideoEncoder->Encode(frame, packet, received_packet);
+		retVal = m_VideoEncoder->Encode(frame, packet, received_packet);
 	} catch (std::exception e) {
 		PLOG_ERROR("Exception during encoding: %s", e.what());
 	} catch (...) {
 		PLOG_ERROR("Unknown exception during encoding.");
 	}
-	return false;
+
+	if (*received_packet && !m_FirstPacket) {
+		m_FirstPacket = true;
+		std::chrono::duration<double_t, std::milli> elapsed = std::chrono::high_resolution_clock::now() - m_CreateTime;
+		PLOG_INFO("First packet after %.1f ms (%s start).", elapsed.count(), m_WarmStart ? "warm" : "cold");
+	}
+	return retVal;
 }
 
 void Plugin::Interface::H265Interface::get_video_info(void* ptr, struct video_scale_info* info) noexcept
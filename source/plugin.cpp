@@ -21,6 +21,7 @@
 #include "plugin.hpp"
 #include <sstream>
 #include "amf-capabilities.hpp"
+#include "amf-encoder-pool.hpp"
 #include "amf.hpp"
 #include "api-base.hpp"
 #include "enc-h264.hpp"
@@ -210,6 +211,7 @@ MODULE_EXPORT bool obs_module_load(void)
 MODULE_EXPORT void obs_module_unload(void)
 {
 	try {
+		Plugin::AMD::EncoderPool::Clear();
 		Plugin::AMD::CapabilityManager::Finalize();
 		Plugin::API::FinalizeAPIs();
 		Plugin::AMD::AMF::Finalize();
@@ -19,9 +19,10 @@
 
 #pragma once
 
-#include "utility.hpp"
+// Standard headers first, the min/max helpers in plugin.hpp clash with <sstream> otherwise.
 #include <map>
 #include <sstream>
+#include "utility.hpp"
 #include "amf-capabilities.hpp"
 #include "amf-encoder-h264.hpp"
 #include "amf-encoder-h265.hpp"
@@ -117,13 +118,15 @@ void Utility::fill_device_list(obs_property_t* property, std::string api_name, P
 	auto api = Plugin::API::GetAPI(api_name);
 	auto cm  = Plugin::AMD::CapabilityManager::Instance();
 
-	for (auto adapter : api->EnumerateAdapters()) {
+	auto adapters  = api->EnumerateAdapters();
+	auto supported = cm->IsCodecSupportedByAPIAdapters(codec, api->GetType(), adapters);
+	for (size_t idx = 0; idx < adapters.size(); idx++) {
 		union {
 			int32_t id[2];
 			int64_t v;
-		} adapterid = {adapter.idLow, adapter.idHigh};
-		if (cm->IsCodecSupportedByAPIAdapter(codec, api->GetType(), adapter))
-			obs_property_list_add_int(property, adapter.Name.c_str(), adapterid.v);
+		} adapterid = {adapters[idx].idLow, adapters[idx].idHigh};
+		if (supported[idx])
+			obs_property_list_add_int(property, adapters[idx].Name.c_str(), adapterid.v);
 	}
 }
 #endif
@@ -739,6 +742,30 @@ const char* Utility::SliceControlModeToString(Plugin::AMD::SliceControlMode v)
 	throw std::runtime_error("Invalid Parameter");
 }
 
+// Wait Strategy
+const char* Utility::WaitStrategyToString(Plugin::AMD::WaitStrategy v)
+{
+	switch (v) {
+	case WaitStrategy::Sleep:
+		return "Sleep";
+	case WaitStrategy::Hybrid:
+		return "Hybrid";
+	}
+	throw std::runtime_error("Invalid Parameter");
+}
+
+// Color Conversion
+const char* Utility::ColorConversionToString(Plugin::AMD::ColorConversion v)
+{
+	switch (v) {
+	case ColorConversion::AMF:
+		return "AMF";
+	case ColorConversion::Host:
+		return "Host";
+	}
+	throw std::runtime_error("Invalid Parameter");
+}
+
 Plugin::AMD::ProfileLevel Utility::H264ProfileLevel(std::pair<uint32_t, uint32_t> resolution,
 													std::pair<uint32_t, uint32_t> frameRate)
 {